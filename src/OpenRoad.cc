@@ -84,6 +84,7 @@
 #include "triton_route/MakeTritonRoute.h"
 #include "utl/Logger.h"
 #include "utl/MakeLogger.h"
+#include "utl/MappedFile.h"
 
 namespace sta {
 extern const char* openroad_swig_tcl_inits[];
@@ -313,6 +314,7 @@ void OpenRoad::readDef(const char* filename,
   if (continue_on_errors) {
     def_reader.continueOnErrors();
   }
+  def_reader.setThreadCount(threads_);
   dbBlock* block = nullptr;
   if (child) {
     auto parent = db_->getChip()->getBlock();
@@ -361,6 +363,7 @@ void OpenRoad::writeDef(const char* filename, const string& version)
     if (block) {
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setThreadCount(threads_);
       def_writer.writeBlock(block, filename);
     }
   }
@@ -451,12 +454,13 @@ void OpenRoad::readDb(const char* filename)
         ORD, 47, "You can't load a new db file as the db is already populated");
   }
 
-  std::ifstream stream;
-  stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
-                    | std::ios::eofbit);
-  stream.open(filename, std::ios::binary);
-
   try {
+    // Deserialize straight from a mapping of the file rather than through a
+    // filebuf; the db is read in many small pieces.
+    utl::MappedFile file(filename, logger_);
+    utl::MappedFileStream stream(file);
+    stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                      | std::ios::eofbit);
     db_->read(stream);
   } catch (const std::ios_base::failure& f) {
     logger_->error(ORD, 54, "odb file {} is invalid: {}", filename, f.what());
@@ -32,7 +32,9 @@
 #pragma once
 
 #include <map>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbWireGraph.h"
@@ -99,8 +101,15 @@ class AntennaChecker
                                          float ratio_margin);
   void initAntennaRules();
   void setReportFileName(const char* file_name);
+  void setNumThreads(int num_threads);
 
  private:
+  struct MTermAreas
+  {
+    double gate_area;
+    double diff_area;
+  };
+
   bool haveRoutedNets();
   double dbuToMicrons(int value);
 
@@ -160,25 +169,25 @@ class AntennaChecker
   std::pair<bool, bool> checkWirePar(const ARinfo& AntennaRatio,
                                      bool report,
                                      bool verbose,
-                                     std::ofstream& report_file);
+                                     std::vector<std::string>& report_lines);
   std::pair<bool, bool> checkWireCar(const ARinfo& AntennaRatio,
                                      bool par_checked,
                                      bool report,
                                      bool verbose,
-                                     std::ofstream& report_file);
+                                     std::vector<std::string>& report_lines);
   bool checkViaPar(const ARinfo& AntennaRatio,
                    bool report,
                    bool verbose,
-                   std::ofstream& report_file);
+                   std::vector<std::string>& report_lines);
   bool checkViaCar(const ARinfo& AntennaRatio,
                    bool report,
                    bool verbose,
-                   std::ofstream& report_file);
+                   std::vector<std::string>& report_lines);
 
   void checkNet(dbNet* net,
                 bool report_if_no_violation,
                 bool verbose,
-                std::ofstream& report_file,
+                std::vector<std::string>& report_lines,
                 // Return values.
                 int& net_violation_count,
                 int& pin_violation_count);
@@ -187,11 +196,13 @@ class AntennaChecker
                  vector<ARinfo>& VIA_CARtable,
                  bool report,
                  bool verbose,
-                 std::ofstream& report_file,
+                 std::vector<std::string>& report_lines,
                  // Return values.
                  bool& violation,
                  std::unordered_set<dbWireGraph::Node*>& violated_gates);
-  bool checkViolation(const PARinfo& par_info, dbTechLayer* layer);
+  bool checkViolation(const PARinfo& par_info,
+                      dbTechLayer* layer,
+                      float ratio_margin);
   bool antennaRatioDiffDependent(dbTechLayer* layer);
 
   void findWireRootIterms(dbWireGraph::Node* node,
@@ -199,6 +210,8 @@ class AntennaChecker
                           vector<dbITerm*>& gates);
   double diffArea(dbMTerm* mterm);
   double gateArea(dbMTerm* mterm);
+  double calculateDiffArea(dbMTerm* mterm);
+  double calculateGateArea(dbMTerm* mterm);
 
   vector<std::pair<double, vector<dbITerm*>>> parMaxWireLength(dbNet* net,
                                                                int layer);
@@ -213,8 +226,11 @@ class AntennaChecker
   utl::Logger* logger_{nullptr};
   std::map<odb::dbTechLayer*, AntennaModel> layer_info_;
   int net_violation_count_{0};
-  float ratio_margin_{0};
   std::string report_file_name_;
+  int num_threads_{1};
+  // gate and diffusion areas of every master terminal, filled by
+  // initAntennaRules so the parallel checks only read it
+  std::map<odb::dbMTerm*, MTermAreas> mterm_areas_;
 
   static constexpr int max_diode_count_per_gate = 10;
 };
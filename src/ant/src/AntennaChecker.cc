@@ -45,6 +45,7 @@
 #include "odb/wOrder.h"
 #include "sta/StaMain.hh"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace ant {
 
@@ -222,6 +223,18 @@ void AntennaChecker::initAntennaRules()
                                   diff_metal_reduce_factor};
     layer_info_[tech_layer] = layer_antenna;
   }
+
+  // Libraries may have been read or changed since the last call, so the
+  // areas are rebuilt from scratch.
+  mterm_areas_.clear();
+  for (odb::dbLib* lib : db_->getLibs()) {
+    for (odb::dbMaster* master : lib->getMasters()) {
+      for (dbMTerm* mterm : master->getMTerms()) {
+        mterm_areas_[mterm]
+            = {calculateGateArea(mterm), calculateDiffArea(mterm)};
+      }
+    }
+  }
 }
 
 dbWireGraph::Node* AntennaChecker::findSegmentRoot(dbWireGraph::Node* node,
@@ -699,6 +712,15 @@ vector<PARinfo> AntennaChecker::buildWireParTable(
 }
 
 double AntennaChecker::gateArea(dbMTerm* mterm)
+{
+  auto find_areas = mterm_areas_.find(mterm);
+  if (find_areas != mterm_areas_.end()) {
+    return find_areas->second.gate_area;
+  }
+  return calculateGateArea(mterm);
+}
+
+double AntennaChecker::calculateGateArea(dbMTerm* mterm)
 {
   double max_gate_area = 0;
   if (mterm->hasDefaultAntennaModel()) {
@@ -745,7 +767,7 @@ void AntennaChecker::calculateParInfo(PARinfo& par_info)
 {
   dbWireGraph::Node* wire_root = par_info.wire_root;
   odb::dbTechLayer* tech_layer = wire_root->layer();
-  AntennaModel& am = layer_info_[tech_layer];
+  const AntennaModel& am = layer_info_.at(tech_layer);
 
   double metal_factor = am.metal_factor;
   double diff_metal_factor = am.diff_metal_factor;
@@ -993,7 +1015,7 @@ vector<PARinfo> AntennaChecker::buildViaParTable(
       dbTechLayer* layer = getViaLayer(
           findVia(wire_root, wire_root->layer()->getRoutingLevel()));
 
-      AntennaModel& am = layer_info_[layer];
+      const AntennaModel& am = layer_info_.at(layer);
       diff_metal_reduce_factor = am.diff_metal_reduce_factor;
       if (layer->hasDefaultAntennaRule()) {
         const dbTechLayerAntennaRule* antenna_rule
@@ -1097,10 +1119,11 @@ vector<ARinfo> AntennaChecker::buildViaCarTable(
   return VIA_CARtable;
 }
 
-std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
-                                                   bool report,
-                                                   bool verbose,
-                                                   std::ofstream& report_file)
+std::pair<bool, bool> AntennaChecker::checkWirePar(
+    const ARinfo& AntennaRatio,
+    bool report,
+    bool verbose,
+    std::vector<std::string>& report_lines)
 {
   dbTechLayer* layer = AntennaRatio.par_info.wire_root->layer();
   const double par = AntennaRatio.par_info.PAR;
@@ -1169,10 +1192,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               PAR_ratio,
               par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          report_lines.push_back(par_report);
         }
       } else {
         if (diff_par_violation || verbose) {
@@ -1184,10 +1204,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               diffPAR_PWL_ratio,
               diff_par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          report_lines.push_back(par_report);
         }
       }
 
@@ -1201,10 +1218,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               PSR_ratio,
               psr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          report_lines.push_back(par_report);
         }
       } else {
         if (diff_psr_violation || verbose) {
@@ -1216,10 +1230,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               diffPSR_PWL_ratio,
               diff_psr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          report_lines.push_back(par_report);
         }
       }
     }
@@ -1227,11 +1238,12 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
   return {violated, checked};
 }
 
-std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
-                                                   bool par_checked,
-                                                   bool report,
-                                                   bool verbose,
-                                                   std::ofstream& report_file)
+std::pair<bool, bool> AntennaChecker::checkWireCar(
+    const ARinfo& AntennaRatio,
+    bool par_checked,
+    bool report,
+    bool verbose,
+    std::vector<std::string>& report_lines)
 {
   dbTechLayer* layer = AntennaRatio.par_info.wire_root->layer();
   const double car = AntennaRatio.CAR;
@@ -1299,10 +1311,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               CAR_ratio,
               car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          report_lines.push_back(car_report);
         }
       } else {
         if (diff_car_violation || verbose) {
@@ -1314,10 +1323,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               diffCAR_PWL_ratio,
               diff_car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          report_lines.push_back(car_report);
         }
       }
 
@@ -1331,10 +1337,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               CSR_ratio,
               csr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          report_lines.push_back(car_report);
         }
       } else {
         if (diff_car_violation || verbose) {
@@ -1346,10 +1349,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               diffCSR_PWL_ratio,
               diff_csr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          report_lines.push_back(car_report);
         }
       }
     }
@@ -1360,7 +1360,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
 bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
                                  bool report,
                                  bool verbose,
-                                 std::ofstream& report_file)
+                                 std::vector<std::string>& report_lines)
 {
   const dbTechLayer* layer = getViaLayer(
       findVia(AntennaRatio.par_info.wire_root,
@@ -1404,10 +1404,7 @@ bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
               PAR_ratio,
               par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          report_lines.push_back(par_report);
         }
       } else {
         if (diff_par_violation || verbose) {
@@ -1419,10 +1416,7 @@ bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
               diffPAR_PWL_ratio,
               diff_par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          report_lines.push_back(par_report);
         }
       }
     }
@@ -1434,7 +1428,7 @@ bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
 bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
                                  bool report,
                                  bool verbose,
-                                 std::ofstream& report_file)
+                                 std::vector<std::string>& report_lines)
 {
   dbTechLayer* layer = getViaLayer(
       findVia(AntennaRatio.par_info.wire_root,
@@ -1479,10 +1473,7 @@ bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
               CAR_ratio,
               car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          report_lines.push_back(car_report);
         }
       } else {
         if (diff_car_violation || verbose) {
@@ -1494,10 +1485,7 @@ bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
               diffCAR_PWL_ratio,
               diff_car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          report_lines.push_back(car_report);
         }
       }
     }
@@ -1556,7 +1544,7 @@ void AntennaChecker::findWireRoots(dbWire* wire,
 void AntennaChecker::checkNet(dbNet* net,
                               bool report_if_no_violation,
                               bool verbose,
-                              std::ofstream& report_file,
+                              std::vector<std::string>& report_lines,
                               // Return values.
                               int& net_violation_count,
                               int& pin_violation_count)
@@ -1582,7 +1570,7 @@ void AntennaChecker::checkNet(dbNet* net,
                 VIA_CARtable,
                 false,
                 verbose,
-                report_file,
+                report_lines,
                 violation,
                 violated_gates);
     }
@@ -1594,12 +1582,7 @@ void AntennaChecker::checkNet(dbNet* net,
 
     // Repeat with reporting.
     if (violation || report_if_no_violation) {
-      std::string net_name = fmt::format("Net: {}", net->getConstName());
-
-      if (report_file.is_open()) {
-        report_file << net_name << "\n";
-      }
-      logger_->report("{}", net_name);
+      report_lines.push_back(fmt::format("Net: {}", net->getConstName()));
 
       for (dbWireGraph::Node* gate : gate_nodes) {
         checkGate(gate,
@@ -1607,11 +1590,10 @@ void AntennaChecker::checkNet(dbNet* net,
                   VIA_CARtable,
                   true,
                   verbose,
-                  report_file,
+                  report_lines,
                   violation,
                   violated_gates);
       }
-      logger_->report("");
     }
   }
 }
@@ -1622,7 +1604,7 @@ void AntennaChecker::checkGate(
     vector<ARinfo>& VIA_CARtable,
     bool report,
     bool verbose,
-    std::ofstream& report_file,
+    std::vector<std::string>& report_lines,
     // Return values.
     bool& violation,
     unordered_set<dbWireGraph::Node*>& violated_gates)
@@ -1630,10 +1612,10 @@ void AntennaChecker::checkGate(
   bool first_pin_violation = true;
   for (const auto& ar : CARtable) {
     if (ar.GateNode == gate) {
-      auto wire_PAR_violation = checkWirePar(ar, false, verbose, report_file);
+      auto wire_PAR_violation = checkWirePar(ar, false, verbose, report_lines);
 
       auto wire_CAR_violation = checkWireCar(
-          ar, wire_PAR_violation.second, false, verbose, report_file);
+          ar, wire_PAR_violation.second, false, verbose, report_lines);
       bool wire_violation
           = wire_PAR_violation.first || wire_CAR_violation.first;
       violation |= wire_violation;
@@ -1653,37 +1635,30 @@ void AntennaChecker::checkGate(
                               mterm->getConstName(),
                               mterm->getMaster()->getConstName());
 
-            if (report_file.is_open()) {
-              report_file << mterm_info << "\n";
-            }
-            logger_->report("{}", mterm_info);
+            report_lines.push_back(mterm_info);
           }
 
           std::string layer_name = fmt::format(
               "    Layer: {}", ar.par_info.wire_root->layer()->getConstName());
 
-          if (report_file.is_open()) {
-            report_file << layer_name << "\n";
-          }
-          logger_->report("{}", layer_name);
+          report_lines.push_back(layer_name);
           first_pin_violation = false;
         }
-        checkWirePar(ar, true, verbose, report_file);
-        checkWireCar(ar, wire_PAR_violation.second, true, verbose, report_file);
+        checkWirePar(ar, true, verbose, report_lines);
+        checkWireCar(
+            ar, wire_PAR_violation.second, true, verbose, report_lines);
         if (wire_violation || verbose) {
-          if (report_file.is_open()) {
-            report_file << "\n";
-          }
-
-          logger_->report("");
+          report_lines.emplace_back();
         }
       }
     }
   }
   for (const auto& via_ar : VIA_CARtable) {
     if (via_ar.GateNode == gate) {
-      bool VIA_PAR_violation = checkViaPar(via_ar, false, verbose, report_file);
-      bool VIA_CAR_violation = checkViaCar(via_ar, false, verbose, report_file);
+      bool VIA_PAR_violation
+          = checkViaPar(via_ar, false, verbose, report_lines);
+      bool VIA_CAR_violation
+          = checkViaCar(via_ar, false, verbose, report_lines);
       bool via_violation = VIA_PAR_violation || VIA_CAR_violation;
       violation |= via_violation;
       if (via_violation) {
@@ -1698,19 +1673,12 @@ void AntennaChecker::checkGate(
 
           std::string via_name
               = fmt::format("    Via: {}", getViaName(via).c_str());
-          if (report_file.is_open()) {
-            report_file << via_name << "\n";
-          }
-          logger_->report("{}", via_name);
+          report_lines.push_back(via_name);
         }
-        checkViaPar(via_ar, true, verbose, report_file);
-        checkViaCar(via_ar, true, verbose, report_file);
+        checkViaPar(via_ar, true, verbose, report_lines);
+        checkViaCar(via_ar, true, verbose, report_lines);
         if (via_violation || verbose) {
-          if (report_file.is_open()) {
-            report_file << "\n";
-          }
-
-          logger_->report("");
+          report_lines.emplace_back();
         }
       }
     }
@@ -1746,14 +1714,10 @@ int AntennaChecker::checkAntennas(dbNet* net, bool verbose)
   int net_violation_count = 0;
   int pin_violation_count = 0;
 
+  vector<dbNet*> nets;
   if (net) {
     if (!net->isSpecial()) {
-      checkNet(net,
-               true,
-               verbose,
-               report_file,
-               net_violation_count,
-               pin_violation_count);
+      nets.push_back(net);
     } else {
       logger_->error(
           ANT, 14, "Skipped net {} because it is special.", net->getName());
@@ -1761,16 +1725,46 @@ int AntennaChecker::checkAntennas(dbNet* net, bool verbose)
   } else {
     for (dbNet* net : block_->getNets()) {
       if (!net->isSpecial()) {
-        checkNet(net,
-                 false,
-                 verbose,
-                 report_file,
-                 net_violation_count,
-                 pin_violation_count);
+        nets.push_back(net);
       }
     }
   }
 
+  // Nets are checked in parallel into per net reports that are written out
+  // in the block net order afterwards.
+  vector<vector<std::string>> net_reports(nets.size());
+  vector<int> net_violations(nets.size(), 0);
+  vector<int> pin_violations(nets.size(), 0);
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int i = 0; i < nets.size(); i++) {
+    try {
+      checkNet(nets[i],
+               net != nullptr,
+               verbose,
+               net_reports[i],
+               net_violations[i],
+               pin_violations[i]);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (int i = 0; i < nets.size(); i++) {
+    net_violation_count += net_violations[i];
+    pin_violation_count += pin_violations[i];
+    for (const std::string& line : net_reports[i]) {
+      if (report_file.is_open()) {
+        report_file << line << "\n";
+      }
+      logger_->report("{}", line);
+    }
+    if (!net_reports[i].empty()) {
+      logger_->report("");
+    }
+  }
+
   logger_->info(ANT, 2, "Found {} net violations.", net_violation_count);
   logger_->metric("antenna__violating__nets", net_violation_count);
   logger_->info(ANT, 1, "Found {} pin violations.", pin_violation_count);
@@ -1788,6 +1782,11 @@ int AntennaChecker::checkAntennas(dbNet* net, bool verbose)
   return net_violation_count;
 }
 
+void AntennaChecker::setNumThreads(int num_threads)
+{
+  num_threads_ = num_threads;
+}
+
 int AntennaChecker::antennaViolationCount() const
 {
   return net_violation_count_;
@@ -1912,7 +1911,9 @@ vector<std::pair<double, vector<dbITerm*>>> AntennaChecker::parMaxWireLength(
   return par_wires;
 }
 
-bool AntennaChecker::checkViolation(const PARinfo& par_info, dbTechLayer* layer)
+bool AntennaChecker::checkViolation(const PARinfo& par_info,
+                                    dbTechLayer* layer,
+                                    float ratio_margin)
 {
   const double par = par_info.PAR;
   const double psr = par_info.PSR;
@@ -1923,7 +1924,7 @@ bool AntennaChecker::checkViolation(const PARinfo& par_info, dbTechLayer* layer)
   if (layer->hasDefaultAntennaRule()) {
     const dbTechLayerAntennaRule* antenna_rule = layer->getDefaultAntennaRule();
     double PAR_ratio = antenna_rule->getPAR();
-    PAR_ratio *= (1.0 - ratio_margin_ / 100.0);
+    PAR_ratio *= (1.0 - ratio_margin / 100.0);
     if (PAR_ratio != 0) {
       if (par > PAR_ratio) {
         return true;
@@ -1931,7 +1932,7 @@ bool AntennaChecker::checkViolation(const PARinfo& par_info, dbTechLayer* layer)
     } else {
       dbTechLayerAntennaRule::pwl_pair diffPAR = antenna_rule->getDiffPAR();
       double diffPAR_ratio = getPwlFactor(diffPAR, diff_area, 0.0);
-      diffPAR_ratio *= (1.0 - ratio_margin_ / 100.0);
+      diffPAR_ratio *= (1.0 - ratio_margin / 100.0);
 
       if (diffPAR_ratio != 0 && diff_par > diffPAR_ratio) {
         return true;
@@ -1939,7 +1940,7 @@ bool AntennaChecker::checkViolation(const PARinfo& par_info, dbTechLayer* layer)
     }
 
     double PSR_ratio = antenna_rule->getPSR();
-    PSR_ratio *= (1.0 - ratio_margin_ / 100.0);
+    PSR_ratio *= (1.0 - ratio_margin / 100.0);
     if (PSR_ratio != 0) {
       if (psr > PSR_ratio) {
         return true;
@@ -1947,7 +1948,7 @@ bool AntennaChecker::checkViolation(const PARinfo& par_info, dbTechLayer* layer)
     } else {
       dbTechLayerAntennaRule::pwl_pair diffPSR = antenna_rule->getDiffPSR();
       double diffPSR_ratio = getPwlFactor(diffPSR, diff_area, 0.0);
-      diffPSR_ratio *= (1.0 - ratio_margin_ / 100.0);
+      diffPSR_ratio *= (1.0 - ratio_margin / 100.0);
 
       if (diffPSR_ratio != 0 && diff_psr > diffPSR_ratio) {
         return true;
@@ -1962,7 +1963,6 @@ vector<Violation> AntennaChecker::getAntennaViolations(dbNet* net,
                                                        dbMTerm* diode_mterm,
                                                        float ratio_margin)
 {
-  ratio_margin_ = ratio_margin;
   double diode_diff_area = 0.0;
   if (diode_mterm) {
     diode_diff_area = diffArea(diode_mterm);
@@ -1980,7 +1980,7 @@ vector<Violation> AntennaChecker::getAntennaViolations(dbNet* net,
     vector<PARinfo> PARtable = buildWireParTable(wire_roots);
     for (PARinfo& par_info : PARtable) {
       dbTechLayer* layer = par_info.wire_root->layer();
-      bool wire_PAR_violation = checkViolation(par_info, layer);
+      bool wire_PAR_violation = checkViolation(par_info, layer, ratio_margin);
 
       if (wire_PAR_violation) {
         vector<dbITerm*> gates;
@@ -1991,7 +1991,7 @@ vector<Violation> AntennaChecker::getAntennaViolations(dbNet* net,
             par_info.iterm_diff_area += diode_diff_area * gates.size();
             diode_count_per_gate++;
             calculateParInfo(par_info);
-            wire_PAR_violation = checkViolation(par_info, layer);
+            wire_PAR_violation = checkViolation(par_info, layer, ratio_margin);
             if (diode_count_per_gate > max_diode_count_per_gate) {
               logger_->warn(ANT,
                             9,
@@ -2024,6 +2024,15 @@ bool AntennaChecker::antennaRatioDiffDependent(dbTechLayer* layer)
 }
 
 double AntennaChecker::diffArea(dbMTerm* mterm)
+{
+  auto find_areas = mterm_areas_.find(mterm);
+  if (find_areas != mterm_areas_.end()) {
+    return find_areas->second.diff_area;
+  }
+  return calculateDiffArea(mterm);
+}
+
+double AntennaChecker::calculateDiffArea(dbMTerm* mterm)
 {
   double max_diff_area = 0.0;
   vector<std::pair<double, dbTechLayer*>> diff_areas;
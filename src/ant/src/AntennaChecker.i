@@ -66,6 +66,7 @@ check_antennas(const char *net_name, bool verbose)
       logger->error(utl::ANT, 12, "Net {} not found.", net_name);
     }
   }
+  getAntennaChecker()->setNumThreads(app->getThreadCount());
   return getAntennaChecker()->checkAntennas(net, verbose);
 }
 
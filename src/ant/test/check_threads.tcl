@@ -0,0 +1,14 @@
+source "helpers.tcl"
+# check that the antenna report does not depend on the thread count
+read_lef merged_spacing.lef
+read_def sw130_random.def
+
+set report_file1 [make_result_file check_threads1.rpt]
+set report_file2 [make_result_file check_threads2.rpt]
+
+set_thread_count 1
+check_antennas -verbose -report_file $report_file1
+set_thread_count 4
+check_antennas -verbose -report_file $report_file2
+
+diff_files $report_file1 $report_file2
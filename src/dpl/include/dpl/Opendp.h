@@ -100,8 +100,9 @@ using RtreeBox
 // The "Grid" is now an array of 2D grids. The new dimension is to support
 // multi-height cells. Each unique row height creates a new grid that is used in
 // legalization. The first index is the grid index (corresponding to row
-// height), second index is the row index, and third index is the site index.
-using Grid = std::vector<std::vector<std::vector<Pixel>>>;
+// height).  Each 2D grid is stored row major in a single vector; use
+// gridPixel to index it by site and row.
+using Grid = std::vector<std::vector<Pixel>>;
 using dbMasterSeq = vector<dbMaster*>;
 // gap -> sequence of masters to fill the gap
 using GapFillers = vector<dbMasterSeq>;
@@ -186,6 +187,8 @@ struct Group
   double util = 0.0;
 };
 
+// The site of a pixel is the same for the whole row and is kept in
+// GridInfo::getSite rather than in every pixel.
 struct Pixel
 {
   Cell* cell;
@@ -194,7 +197,6 @@ struct Pixel
   dbOrientType orient_;
   bool is_valid;     // false for dummy cells
   bool is_hopeless;  // too far from sites for diamond search
-  dbSite* site;      // site that this pixel is
 };
 
 class GridInfo
@@ -223,6 +225,15 @@ class GridInfo
 
   const dbSite::RowPattern& getSites() const { return sites_; }
 
+  // Site of the pixels in row grid_y.
+  dbSite* getSite(int grid_y) const
+  {
+    if (sites_.empty()) {
+      return nullptr;
+    }
+    return sites_[grid_y % sites_.size()].site;
+  }
+
   bool isHybrid() const
   {
     return sites_.size() > 1 || sites_[0].site->hasRowPattern();
@@ -287,6 +298,12 @@ class Opendp
   void setPadding(dbMaster* master, int left, int right);
   void setPadding(dbInst* inst, int left, int right);
   void setDebug(std::unique_ptr<dpl::DplObserver>& observer);
+  void setNumThreads(int num_threads) { num_threads_ = num_threads; }
+  // Legalize single-row cells in parallel strips instead of serially.
+  void setParallelStrips(bool parallel_strips)
+  {
+    parallel_strips_ = parallel_strips;
+  }
 
   // Global padding.
   int padGlobalLeft() const { return pad_left_; }
@@ -404,6 +421,7 @@ class Opendp
   void prePlace();
   void prePlaceGroups();
   void place();
+  void placeStrips(const vector<Cell*>& cells);
   void placeGroups2();
   void brickPlace1(const Group* group);
   void brickPlace2(const Group* group);
@@ -551,6 +569,8 @@ class Opendp
   int max_displacement_y_ = 0;  // sites
   bool disallow_one_site_gaps_ = false;
   vector<Cell*> placement_failures_;
+  int num_threads_ = 1;
+  bool parallel_strips_ = false;
 
   // 3D pixel grid
   Grid grid_;
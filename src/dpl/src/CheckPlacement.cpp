@@ -353,7 +353,7 @@ bool Opendp::checkInRows(const Cell& cell) const
           || !pixel->is_valid) {
         return false;
       }
-      if (pixel->site != cell.getSite()) {
+      if (grid_info.second.getSite(y) != cell.getSite()) {
         return false;
       }
     }
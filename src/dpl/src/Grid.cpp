@@ -276,34 +276,20 @@ void Opendp::initGrid()
   // Make pixel grid
   if (grid_.empty()) {
     grid_.resize(grid_info_map_.size());
-    for (auto& [gmk, grid_info] : grid_info_map_) {
-      grid_[grid_info.getGridIndex()].resize(grid_info.getRowCount());
-    }
   }
 
   for (auto& [gmk, grid_info] : grid_info_map_) {
-    const int layer_row_count = grid_info.getRowCount();
-    const int layer_row_site_count = grid_info.getSiteCount();
-    const int index = grid_info.getGridIndex();
-    grid_[index].resize(layer_row_count);
-    for (int j = 0; j < layer_row_count; j++) {
-      grid_[index][j].resize(layer_row_site_count);
-      const auto& grid_sites = grid_info.getSites();
-      dbSite* row_site = nullptr;
-      if (!grid_sites.empty()) {
-        row_site = grid_sites[j % grid_sites.size()].site;
-      }
-
-      for (int k = 0; k < layer_row_site_count; k++) {
-        Pixel& pixel = grid_[index][j][k];
-        pixel.cell = nullptr;
-        pixel.group_ = nullptr;
-        pixel.util = 0.0;
-        pixel.is_valid = false;
-        pixel.is_hopeless = false;
-        pixel.site = nullptr;
-        pixel.site = row_site;
-      }
+    const int64_t layer_pixel_count
+        = static_cast<int64_t>(grid_info.getRowCount())
+          * grid_info.getSiteCount();
+    auto& layer = grid_[grid_info.getGridIndex()];
+    layer.resize(layer_pixel_count);
+    for (Pixel& pixel : layer) {
+      pixel.cell = nullptr;
+      pixel.group_ = nullptr;
+      pixel.util = 0.0;
+      pixel.is_valid = false;
+      pixel.is_hopeless = false;
     }
   }
 
@@ -365,8 +351,7 @@ void Opendp::initGrid()
     for (const auto& rect : rects) {
       for (int y = gtl::yl(rect); y < gtl::yh(rect); y++) {
         for (int x = gtl::xl(rect); x < gtl::xh(rect); x++) {
-          Pixel& pixel = grid_[h_index][y][x];
-          pixel.is_hopeless = true;
+          gridPixel(h_index, x, y)->is_hopeless = true;
         }
       }
     }
@@ -386,7 +371,9 @@ Pixel* Opendp::gridPixel(int grid_idx, int grid_x, int grid_y) const
   GridInfo* grid_info = grid_info_vector_[grid_idx];
   if (grid_x >= 0 && grid_x < grid_info->getSiteCount() && grid_y >= 0
       && grid_y < grid_info->getRowCount()) {
-    return const_cast<Pixel*>(&grid_[grid_idx][grid_y][grid_x]);
+    const int64_t idx
+        = static_cast<int64_t>(grid_y) * grid_info->getSiteCount() + grid_x;
+    return const_cast<Pixel*>(&grid_[grid_idx][idx]);
   }
   return nullptr;
 }
@@ -98,8 +98,11 @@ void
 detailed_placement_cmd(int max_displacment_x,
                        int max_displacment_y,
                        bool disallow_one_site_gaps,
+                       bool parallel_strips,
                        const char* report_file_name){
   dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
+  opendp->setNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
+  opendp->setParallelStrips(parallel_strips);
   opendp->detailedPlacement(max_displacment_x, max_displacment_y, std::string(report_file_name), disallow_one_site_gaps);
 }
 
@@ -37,6 +37,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
@@ -46,6 +48,7 @@
 #include "DplObserver.h"
 #include "dpl/Opendp.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 // #define ODP_DEBUG
 
@@ -336,8 +339,17 @@ void Opendp::place()
       }
     }
   }
+  vector<Cell*> single_row_cells;
+  single_row_cells.reserve(sorted_cells.size());
   for (Cell* cell : sorted_cells) {
     if (!isMultiRow(cell) && cellFitsInCore(cell)) {
+      single_row_cells.push_back(cell);
+    }
+  }
+  if (parallel_strips_) {
+    placeStrips(single_row_cells);
+  } else {
+    for (Cell* cell : single_row_cells) {
       if (!mapMove(cell)) {
         shiftMove(cell);
       }
@@ -347,6 +359,70 @@ void Opendp::place()
   // anneal();
 }
 
+// Places the sorted cells in vertical strips of the core on several
+// threads.  The diamond search of a cell reads and paints pixels at most
+// reach sites away from its initial site.  Strips are 2 * reach wide, so
+// strips that are not adjacent never touch the same pixels.  The even
+// strips are placed first and then the odd ones.  Cells that fail the
+// diamond search are shifted serially afterwards in the sorted order.
+// Nothing depends on the thread count, so every run gives the same
+// placement.  The debug observer is not thread safe and gets one thread.
+void Opendp::placeStrips(const vector<Cell*>& cells)
+{
+  const int num_threads = debug_observer_ ? 1 : num_threads_;
+  int max_width = 0;
+  for (const Cell* cell : cells) {
+    max_width = max(max_width, gridPaddedWidth(cell));
+  }
+  const int reach = max_displacement_x_ + bin_search_width_ + max_width + 1;
+  const int strip_width = 2 * reach;
+  const int strip_count = divCeil(row_site_count_, strip_width);
+  if (strip_count < 4) {
+    // Not enough strips to keep the threads busy.
+    for (Cell* cell : cells) {
+      if (!mapMove(cell)) {
+        shiftMove(cell);
+      }
+    }
+    return;
+  }
+
+  vector<vector<std::pair<Cell*, Point>>> strips(strip_count);
+  for (Cell* cell : cells) {
+    const Point grid_pt = legalGridPt(cell, true);
+    const int strip
+        = std::clamp(grid_pt.getX() / strip_width, 0, strip_count - 1);
+    strips[strip].emplace_back(cell, grid_pt);
+  }
+
+  vector<vector<Cell*>> strip_failures(strip_count);
+  utl::ThreadException exception;
+  for (int parity = 0; parity < 2; parity++) {
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for (int strip = parity; strip < strip_count; strip += 2) {
+      try {
+        for (auto& [cell, grid_pt] : strips[strip]) {
+          if (!mapMove(cell, grid_pt)) {
+            strip_failures[strip].push_back(cell);
+          }
+        }
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+  }
+
+  vector<Cell*> failures;
+  for (const auto& strip_cells : strip_failures) {
+    failures.insert(failures.end(), strip_cells.begin(), strip_cells.end());
+  }
+  sort(failures.begin(), failures.end(), CellPlaceOrderLess(getCore()));
+  for (Cell* cell : failures) {
+    shiftMove(cell);
+  }
+}
+
 bool Opendp::cellFitsInCore(Cell* cell)
 {
   return gridPaddedWidth(cell) <= row_site_count_
@@ -602,7 +678,7 @@ bool Opendp::mapMove(Cell* cell, const Point& grid_pt)
              cell->y_,
              pixel_pt.pt.getX(),
              pixel_pt.pt.getY(),
-             pixel_pt.pixel->site->getName());
+             getRowInfo(cell).second.getSite(pixel_pt.pt.getY())->getName());
   if (pixel_pt.pixel) {
     paintPixel(cell, pixel_pt.pt.getX(), pixel_pt.pt.getY());
     if (debug_observer_) {
@@ -1017,15 +1093,16 @@ bool Opendp::checkPixels(const Cell* cell,
   auto cell_site = cell->getSite();
   int layer = row_info.second.getGridIndex();
   for (int y1 = y; y1 < y_end; y1++) {
+    dbSite* row_site = row_info.second.getSite(y1);
     for (int x1 = x; x1 < x_end; x1++) {
       Pixel* pixel = gridPixel(layer, x1, y1);
       if (pixel == nullptr || pixel->cell || !pixel->is_valid
           || (cell->inGroup() && pixel->group_ != cell->group_)
           || (!cell->inGroup() && pixel->group_)
-          || (pixel->site != nullptr && pixel->site != cell_site)) {
+          || (row_site != nullptr && row_site != cell_site)) {
         return false;
       }
-      if (pixel->site == nullptr) {
+      if (row_site == nullptr) {
         logger_->error(DPL, 1599, "Pixel site is null");
       }
     }
@@ -1213,7 +1290,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
   // They will be checked in the checkPixels in the diamondSearch method after
   // this initialization
   for (int x = grid_x - 1; x >= 0; --x) {  // left
-    if (grid_[grid_index][grid_y][x].is_valid) {
+    if (gridPixel(grid_index, x, grid_y)->is_valid) {
       best_dist = (grid_x - x - 1) * site_width_;
       best_x = x;
       best_y = grid_y;
@@ -1221,7 +1298,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int x = grid_x + 1; x < layer_site_count; ++x) {  // right
-    if (grid_[grid_index][grid_y][x].is_valid) {
+    if (gridPixel(grid_index, x, grid_y)->is_valid) {
       const int dist = (x - grid_x) * site_width_ - cell->width_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1232,7 +1309,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y - 1; y >= 0; --y) {  // below
-    if (grid_[grid_index][y][grid_x].is_valid) {
+    if (gridPixel(grid_index, grid_x, y)->is_valid) {
       const int dist
           = (grid_y - y - 1)
             * row_height;  // FIXME(mina1460): this is wrong for hybrid sites
@@ -1245,7 +1322,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y + 1; y < layer_row_count; ++y) {  // above
-    if (grid_[grid_index][y][grid_x].is_valid) {
+    if (gridPixel(grid_index, grid_x, y)->is_valid) {
       const int dist = (y - grid_y) * row_height - cell->height_;
       if (dist < best_dist) {
         best_dist = dist;
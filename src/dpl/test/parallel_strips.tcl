@@ -0,0 +1,46 @@
+# detailed placement in parallel strips gives the same placement for any
+# thread count
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def aes_cipher_top_replace.def
+
+proc inst_locations { } {
+  set locations {}
+  foreach inst [[ord::get_db_block] getInsts] {
+    lappend locations [list $inst [$inst getLocation] [$inst getOrient]]
+  }
+  return $locations
+}
+
+proc restore_locations { locations } {
+  foreach location $locations {
+    lassign $location inst pt orient
+    $inst setOrient $orient
+    $inst setLocation [lindex $pt 0] [lindex $pt 1]
+  }
+}
+
+# Call the command behind detailed_placement directly to leave out the
+# displacement report, which does not matter here.  A small displacement
+# limit makes enough strips for the threads.
+set site [dpl::get_row_site]
+set max_disp_x [expr [ord::microns_to_dbu 10] / [$site getWidth]]
+set max_disp_y [expr [ord::microns_to_dbu 10] / [$site getHeight]]
+set initial [inst_locations]
+
+set_thread_count 1
+dpl::detailed_placement_cmd $max_disp_x $max_disp_y 0 1 ""
+check_placement
+set serial [inst_locations]
+
+restore_locations $initial
+set_thread_count 4
+dpl::detailed_placement_cmd $max_disp_x $max_disp_y 0 1 ""
+check_placement
+set threaded [inst_locations]
+
+if { $serial == $threaded } {
+  puts "Strips placed the same with 1 and 4 threads."
+} else {
+  puts "Strips placed differently with 1 and 4 threads."
+}
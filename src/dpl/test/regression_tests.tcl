@@ -48,6 +48,7 @@ record_tests {
   pad06
   pad07
   pad08
+  parallel_strips
   regions1
   regions2
   regions3
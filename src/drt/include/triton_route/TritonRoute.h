@@ -75,6 +75,7 @@ struct frDebugSettings;
 class FlexDR;
 struct FlexDRViaData;
 class frMarker;
+class PinAccessCache;
 
 struct ParamStruct
 {
@@ -166,6 +167,12 @@ class TritonRoute
   // for debugging and not general usage.
   std::string runDRWorker(const std::string& workerStr, FlexDRViaData* viaData);
   void debugSingleWorker(const std::string& dumpDir, const std::string& drcRpt);
+  // Reloads the design of a worker dumped in dumpDir/workerDir in place of
+  // the current one, runs the worker and reports the time and memory of
+  // each stage.  Returns the number of markers left by the worker.
+  int benchWorker(const std::string& dumpDir, const std::string& workerDir);
+  // Reports the totals of the workers run by benchWorker and resets them.
+  void reportWorkerBench();
   void updateGlobals(const char* file_name);
   void resetDb(const char* file_name);
   void clearDesign();
@@ -192,6 +199,8 @@ class TritonRoute
   std::unique_ptr<frDesign> design_;
   std::unique_ptr<frDebugSettings> debug_;
   std::unique_ptr<DesignCallBack> db_callback_;
+  // access points of unique instance classes from earlier runs
+  std::unique_ptr<PinAccessCache> pa_cache_;
   odb::dbDatabase* db_{nullptr};
   utl::Logger* logger_{nullptr};
   std::unique_ptr<FlexDR> dr_;  // kept for single stepping
@@ -208,6 +217,15 @@ class TritonRoute
   int results_sz_{0};
   unsigned int cloud_sz_{0};
   boost::asio::thread_pool dist_pool_{1};
+  struct WorkerBenchTotals
+  {
+    int workers = 0;
+    double init = 0;
+    double route = 0;
+    double gc = 0;
+    double end = 0;
+  };
+  WorkerBenchTotals bench_totals_;
 
   void initDesign();
   void gr();
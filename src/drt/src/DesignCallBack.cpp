@@ -50,6 +50,7 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
     if (design->getRegionQuery() != nullptr) {
       design->getRegionQuery()->removeBlockObj(inst);
     }
+    design->addDirtyBox(inst->getBBox());
     int x, y;
     db_inst->getLocation(x, y);
     auto block = db_inst->getBlock();
@@ -57,6 +58,7 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
     y = defdist(block, y);
     inst->setOrigin({x, y});
     inst->setOrient(db_inst->getOrient());
+    design->addDirtyBox(inst->getBBox());
     if (design->getRegionQuery() != nullptr) {
       design->getRegionQuery()->addBlockObj(inst);
     }
@@ -74,8 +76,54 @@ void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
     if (design->getRegionQuery() != nullptr) {
       design->getRegionQuery()->removeBlockObj(inst);
     }
+    design->addDirtyBox(inst->getBBox());
     design->getTopBlock()->removeInst(inst);
   }
 }
 
+// Connectivity edits make the workers around the instance pins and the
+// routes of the net recheck their area.
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* db_iterm)
+{
+  addDirtyInst(db_iterm->getInst());
+}
+
+void DesignCallBack::inDbITermPreDisconnect(odb::dbITerm* db_iterm)
+{
+  addDirtyInst(db_iterm->getInst());
+}
+
+void DesignCallBack::inDbNetDestroy(odb::dbNet* db_net)
+{
+  auto design = router_->getDesign();
+  if (design == nullptr || design->getTopBlock() == nullptr) {
+    return;
+  }
+  auto net = design->getTopBlock()->findNet(db_net->getName());
+  if (net == nullptr) {
+    return;
+  }
+  for (const auto& shape : net->getShapes()) {
+    design->addDirtyBox(shape->getBBox());
+  }
+  for (const auto& via : net->getVias()) {
+    design->addDirtyBox(via->getBBox());
+  }
+  for (const auto& patch : net->getPatchWires()) {
+    design->addDirtyBox(patch->getBBox());
+  }
+}
+
+void DesignCallBack::addDirtyInst(odb::dbInst* db_inst)
+{
+  auto design = router_->getDesign();
+  if (design == nullptr || design->getTopBlock() == nullptr) {
+    return;
+  }
+  auto inst = design->getTopBlock()->getInst(db_inst->getName());
+  if (inst != nullptr) {
+    design->addDirtyBox(inst->getBBox());
+  }
+}
+
 }  // namespace drt
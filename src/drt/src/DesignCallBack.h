@@ -38,8 +38,13 @@ class DesignCallBack : public odb::dbBlockCallBackObj
   DesignCallBack(TritonRoute* router) : router_(router) {}
   void inDbPostMoveInst(odb::dbInst* inst) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
 
  private:
+  void addDirtyInst(odb::dbInst* db_inst);
+
   TritonRoute* router_;
 };
 }  // namespace drt
@@ -28,12 +28,15 @@
 
 #include "triton_route/TritonRoute.h"
 
+#include <zlib.h>
+
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
 #include <fstream>
 #include <iostream>
 
 #include "DesignCallBack.h"
+#include "db/infra/frTime.h"
 #include "db/tech/frTechObject.h"
 #include "distributed/PinAccessJobDescription.h"
 #include "distributed/RoutingCallBack.h"
@@ -52,6 +55,7 @@
 #include "odb/dbShape.h"
 #include "ord/OpenRoad.hh"
 #include "pa/FlexPA.h"
+#include "pa/FlexPA_cache.h"
 #include "rp/FlexRP.h"
 #include "serialization.h"
 #include "sta/StaMain.hh"
@@ -72,6 +76,7 @@ namespace drt {
 TritonRoute::TritonRoute()
     : debug_(std::make_unique<frDebugSettings>()),
       db_callback_(std::make_unique<DesignCallBack>(this)),
+      pa_cache_(std::make_unique<PinAccessCache>()),
       gui_(gui::Gui::get())
 {
 }
@@ -292,6 +297,81 @@ void TritonRoute::debugSingleWorker(const std::string& dumpDir,
   }
 }
 
+int TritonRoute::benchWorker(const std::string& dumpDir,
+                             const std::string& workerDir)
+{
+  const std::string workerPath = fmt::format("{}/{}", dumpDir, workerDir);
+  updateGlobals(fmt::format("{}/init_globals.bin", dumpDir).c_str());
+  // Every worker starts from the dumped design.
+  if (db_->getChip() != nullptr) {
+    odb::dbChip::destroy(db_->getChip());
+  }
+  resetDb(fmt::format("{}/design.odb", dumpDir).c_str());
+  updateGlobals(fmt::format("{}/globals.bin", workerPath).c_str());
+  updateDesign(fmt::format("{}/updates.bin", workerPath));
+  updateGlobals(fmt::format("{}/worker_globals.bin", workerPath).c_str());
+  {
+    io::Writer writer(design_.get(), logger_);
+    writer.updateTrackAssignment(db_->getChip()->getBlock());
+  }
+
+  FlexDRViaData viaData;
+  std::ifstream viaDataFile(fmt::format("{}/viadata.bin", workerPath),
+                            std::ios::binary);
+  frIArchive ar(viaDataFile);
+  ar >> viaData;
+
+  std::ifstream workerFile(fmt::format("{}/worker.bin", workerPath),
+                           std::ios::binary);
+  std::string workerStr((std::istreambuf_iterator<char>(workerFile)),
+                        std::istreambuf_iterator<char>());
+  workerFile.close();
+  auto worker = FlexDRWorker::load(workerStr, logger_, design_.get(), nullptr);
+  worker->setSharedVolume(shared_volume_);
+  worker->setDebugSettings(debug_.get());
+  worker->setViaData(&viaData);
+
+  const size_t rssBefore = getCurrentRSS();
+  FlexDRWorker::StageTimes times;
+  worker->benchMain(design_.get(), times);
+  const size_t rssAfter = getCurrentRSS();
+
+  logger_->info(DRT,
+                623,
+                "Worker {}: init {:.3f}s, maze {:.3f}s, gc {:.3f}s, end "
+                "{:.3f}s, markers {}, memory {:+.2f} (MB).",
+                workerDir,
+                times.init,
+                times.route,
+                times.gc,
+                times.end,
+                worker->getBestNumMarkers(),
+                ((double) rssAfter - (double) rssBefore) / (1024.0 * 1024.0));
+  bench_totals_.workers++;
+  bench_totals_.init += times.init;
+  bench_totals_.route += times.route;
+  bench_totals_.gc += times.gc;
+  bench_totals_.end += times.end;
+  return worker->getBestNumMarkers();
+}
+
+void TritonRoute::reportWorkerBench()
+{
+  const WorkerBenchTotals& totals = bench_totals_;
+  logger_->info(DRT,
+                624,
+                "{} workers: init {:.3f}s, maze {:.3f}s, gc {:.3f}s, end "
+                "{:.3f}s, total {:.3f}s, peak memory {:.2f} (MB).",
+                totals.workers,
+                totals.init,
+                totals.route,
+                totals.gc,
+                totals.end,
+                totals.init + totals.route + totals.gc + totals.end,
+                getPeakRSS() / (1024.0 * 1024.0));
+  bench_totals_ = WorkerBenchTotals();
+}
+
 void TritonRoute::updateGlobals(const char* file_name)
 {
   std::ifstream file(file_name);
@@ -321,16 +401,34 @@ void TritonRoute::clearDesign()
   design_ = std::make_unique<frDesign>(logger_);
 }
 
+// Reads a file written by gzwrite.  zlib passes uncompressed files through
+// unchanged, so plain update files are read as well.
+static std::string readGzFile(const std::string& file_name)
+{
+  std::string data;
+  gzFile file = gzopen(file_name.c_str(), "rb");
+  if (file == nullptr) {
+    return data;
+  }
+  char buffer[1 << 16];
+  int size;
+  while ((size = gzread(file, buffer, sizeof(buffer))) > 0) {
+    data.append(buffer, size);
+  }
+  gzclose(file);
+  return data;
+}
+
 static void deserializeUpdate(frDesign* design,
                               const std::string& updateStr,
                               std::vector<drUpdate>& updates)
 {
-  std::ifstream file(updateStr.c_str());
-  frIArchive ar(file);
+  const std::string data = readGzFile(updateStr);
+  frInStringStream stream(data.data(), data.size());
+  frIArchive ar(stream);
   ar.setDesign(design);
   registerTypes(ar);
   ar >> updates;
-  file.close();
 }
 
 static void deserializeUpdates(frDesign* design,
@@ -524,6 +622,7 @@ void TritonRoute::init(Tcl_Interp* tcl_interp,
   dist_ = dist;
   stt_builder_ = stt_builder;
   design_ = std::make_unique<frDesign>(logger_);
+  ord::OpenRoad::openRoad()->addObserver(pa_cache_.get());
   dist->addCallBack(new RoutingCallBack(this, dist, logger));
   // Define swig TCL commands.
   Drt_Init(tcl_interp);
@@ -777,14 +876,25 @@ void TritonRoute::sendDesignDist()
   }
   design_->clearUpdates();
 }
+// Update batches are broadcast to every worker through the shared volume,
+// so they are compressed.  Level 1 keeps the leader's serialize time low.
 static void serializeUpdatesBatch(const std::vector<drUpdate>& batch,
                                   const std::string& file_name)
 {
-  std::ofstream file(file_name.c_str());
-  frOArchive ar(file);
-  registerTypes(ar);
-  ar << batch;
-  file.close();
+  std::string data;
+  frOutStringStream stream(data);
+  {
+    frOArchive ar(stream);
+    registerTypes(ar);
+    ar << batch;
+  }
+  stream.flush();
+  gzFile file = gzopen(file_name.c_str(), "wb1");
+  if (file == nullptr) {
+    return;
+  }
+  gzwrite(file, data.data(), data.size());
+  gzclose(file);
 }
 
 void TritonRoute::sendGlobalsUpdates(const std::string& globals_path,
@@ -895,6 +1005,7 @@ int TritonRoute::main()
     FlexPA pa(getDesign(), logger_, dist_);
     pa.setDistributed(dist_ip_, dist_port_, shared_volume_, cloud_sz_);
     pa.setDebug(debug_.get(), db_);
+    pa.setCache(pa_cache_.get(), db_->getTech());
     pa_pool.join();
     pa.main();
     if (distributed_ || debug_->debugDR || debug_->debugDumpDR) {
@@ -955,6 +1066,7 @@ void TritonRoute::pinAccess(const std::vector<odb::dbInst*>& target_insts)
   FlexPA pa(getDesign(), logger_, dist_);
   pa.setTargetInstances(target_insts);
   pa.setDebug(debug_.get(), db_);
+  pa.setCache(pa_cache_.get(), db_->getTech());
   if (distributed_) {
     pa.setDistributed(dist_ip_, dist_port_, shared_volume_, cloud_sz_);
     dist_pool_.join();
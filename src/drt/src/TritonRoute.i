@@ -212,6 +212,18 @@ run_worker_cmd(const char* dump_dir, const char* worker_dir, const char* drc_rpt
   router->debugSingleWorker(fmt::format("{}/{}", dump_dir, worker_dir), drc_rpt);
 }
 
+int bench_worker_cmd(const char* dump_dir, const char* worker_dir)
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  return router->benchWorker(dump_dir, worker_dir);
+}
+
+void report_worker_bench_cmd()
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->reportWorkerBench();
+}
+
 void detailed_route_step_drt(int size,
                              int offset,
                              int mazeEndIter,
@@ -390,6 +390,42 @@ proc detailed_route_run_worker { args } {
   drt::run_worker_cmd $dump_dir $worker_dir $drc_rpt
 }
 
+sta::define_cmd_args "detailed_route_bench_workers" {
+    [-dump_dir dir]
+    [-worker_dirs dirs]
+};# checker off
+
+proc detailed_route_bench_workers { args } {
+  sta::parse_key_args "detailed_route_bench_workers" args \
+    keys {-dump_dir -worker_dirs} \
+    flags {};# checker off
+  sta::check_argc_eq0 "detailed_route_bench_workers" $args
+  if { [info exists keys(-dump_dir)] } {
+    set dump_dir $keys(-dump_dir)
+  } else {
+    utl::error DRT 625 "-dump_dir is required for detailed_route_bench_workers command"
+  }
+
+  if { [info exists keys(-worker_dirs)] } {
+    set worker_dirs $keys(-worker_dirs)
+  } else {
+    set worker_dirs {}
+    foreach path [lsort [glob -nocomplain -type d [file join $dump_dir worker*]]] {
+      lappend worker_dirs [file tail $path]
+    }
+  }
+  if { [llength $worker_dirs] == 0 } {
+    utl::error DRT 626 "No worker dumps found in $dump_dir."
+  }
+
+  set markers {}
+  foreach worker_dir $worker_dirs {
+    lappend markers [drt::bench_worker_cmd $dump_dir $worker_dir]
+  }
+  drt::report_worker_bench_cmd
+  return $markers
+}
+
 sta::define_cmd_args "detailed_route_worker_debug" {
     [-maze_end_iter iter]
     [-drc_cost d_cost]
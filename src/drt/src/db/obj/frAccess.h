@@ -55,7 +55,8 @@ class frAccessPoint : public frBlockObject
         viaDefs_(rhs.viaDefs_),
         typeL_(rhs.typeL_),
         typeH_(rhs.typeH_),
-        pathSegs_(rhs.pathSegs_)
+        pathSegs_(rhs.pathSegs_),
+        allow_via_(rhs.allow_via_)
   {
   }
   frAccessPoint& operator=(const frAccessPoint&) = delete;
@@ -170,6 +171,10 @@ class frAccessPoint : public frBlockObject
     }
   }
   void addViaDef(frViaDef* in);
+  void setViaDefs(std::vector<std::vector<frViaDef*>> in)
+  {
+    viaDefs_ = std::move(in);
+  }
   void addToPinAccess(frPinAccess* in) { aps_ = in; }
   void setType(frAccessPointEnum in, bool isL = true)
   {
@@ -81,7 +81,7 @@ class RoutingCallBack : public dst::JobCallBack
       init_ = false;
       omp_set_num_threads(ord::OpenRoad::openRoad()->getThreadCount());
     }
-    auto workers = desc->getWorkers();
+    const auto& workers = desc->getWorkers();
     int size = workers.size();
     std::vector<std::pair<int, std::string>> results;
     asio::thread_pool reply_pool(1);
@@ -94,25 +94,23 @@ class RoutingCallBack : public dst::JobCallBack
              router_->runDRWorker(workers.at(i).second, &via_data_)};
 #pragma omp critical
       {
-        results.push_back(result);
+        results.push_back(std::move(result));
         ++cnt;
         if (cnt * 1.0 / size >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
           prev_perc += 10;
           if (prev_perc % desc->getSendEvery() == 0) {
-            asio::post(reply_pool,
-                       boost::bind(&RoutingCallBack::sendResult,
-                                   this,
-                                   results,
-                                   boost::ref(sock),
-                                   false,
-                                   cnt));
+            asio::post(
+                reply_pool,
+                [this, batch = std::move(results), &sock, cnt]() mutable {
+                  sendResult(std::move(batch), sock, false, cnt);
+                });
             results.clear();
           }
         }
       }
     }
     reply_pool.join();
-    sendResult(results, sock, true, cnt);
+    sendResult(std::move(results), sock, true, cnt);
   }
 
   void onFrDesignUpdated(dst::JobMessage& msg, dst::socket& sock) override
@@ -142,9 +140,8 @@ class RoutingCallBack : public dst::JobCallBack
       t.print(logger_);
     }
     if (!desc->getViaData().empty()) {
-      std::stringstream stream(
-          desc->getViaData(),
-          std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+      const std::string& viaData = desc->getViaData();
+      frInStringStream stream(viaData.data(), viaData.size());
       frIArchive ar(stream);
       ar >> via_data_;
     }
@@ -223,7 +220,7 @@ class RoutingCallBack : public dst::JobCallBack
   }
 
  private:
-  void sendResult(const std::vector<std::pair<int, std::string>>& results,
+  void sendResult(std::vector<std::pair<int, std::string>> results,
                   dst::socket& sock,
                   bool finish,
                   int cnt)
@@ -236,7 +233,7 @@ class RoutingCallBack : public dst::JobCallBack
     }
     auto uResultDesc = std::make_unique<RoutingJobDescription>();
     auto resultDesc = static_cast<RoutingJobDescription*>(uResultDesc.get());
-    resultDesc->setWorkers(results);
+    resultDesc->setWorkers(std::move(results));
     result.setJobDescription(std::move(uResultDesc));
     dist_->sendResult(result, sock);
     if (finish) {
@@ -47,6 +47,10 @@ class RoutingJobDescription : public dst::JobDescription
   {
     workers_ = workers;
   }
+  void setWorkers(std::vector<std::pair<int, std::string>>&& workers)
+  {
+    workers_ = std::move(workers);
+  }
   void setUpdates(const std::vector<std::string>& updates)
   {
     updates_ = updates;
@@ -29,6 +29,10 @@
 #pragma once
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <string>
 
 #include "frDesign.h"
 #include "serialization.h"
@@ -45,6 +49,13 @@ using InputArchive
     = boost::archive::binary_iarchive_impl<frIArchive,
                                            std::istream::char_type,
                                            std::istream::traits_type>;
+// Streams over an existing string so that archiving into or out of it
+// does not copy the payload.
+using frOutStringStream = boost::iostreams::stream<
+    boost::iostreams::back_insert_device<std::string>>;
+using frInStringStream
+    = boost::iostreams::stream<boost::iostreams::array_source>;
+
 struct frOArchive : OutputArchive
 {
   frOArchive(std::ostream& os, unsigned flags = 0) : OutputArchive(os, flags) {}
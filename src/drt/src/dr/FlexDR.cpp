@@ -31,13 +31,14 @@
 #include <dst/JobMessage.h>
 #include <omp.h>
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 
@@ -67,23 +68,25 @@ enum class SerializationType
   WRITE
 };
 
+// The archives write into and read from the strings directly, as workers
+// are large and a stringstream would copy each of them.
 void serializeWorker(FlexDRWorker* worker, std::string& workerStr)
 {
-  std::stringstream stream(std::ios_base::binary | std::ios_base::in
-                           | std::ios_base::out);
-  frOArchive ar(stream);
-  registerTypes(ar);
-  ar << *worker;
-  workerStr = stream.str();
+  workerStr.clear();
+  frOutStringStream stream(workerStr);
+  {
+    frOArchive ar(stream);
+    registerTypes(ar);
+    ar << *worker;
+  }
+  stream.flush();
 }
 
 void deserializeWorker(FlexDRWorker* worker,
                        frDesign* design,
                        const std::string& workerStr)
 {
-  std::stringstream stream(
-      workerStr,
-      std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+  frInStringStream stream(workerStr.data(), workerStr.size());
   frIArchive ar(stream);
   ar.setDesign(design);
   registerTypes(ar);
@@ -92,12 +95,14 @@ void deserializeWorker(FlexDRWorker* worker,
 
 void serializeViaData(const FlexDRViaData& viaData, std::string& serializedStr)
 {
-  std::stringstream stream(std::ios_base::binary | std::ios_base::in
-                           | std::ios_base::out);
-  frOArchive ar(stream);
-  registerTypes(ar);
-  ar << viaData;
-  serializedStr = stream.str();
+  serializedStr.clear();
+  frOutStringStream stream(serializedStr);
+  {
+    frOArchive ar(stream);
+    registerTypes(ar);
+    ar << viaData;
+  }
+  stream.flush();
 }
 
 FlexDR::FlexDR(TritonRoute* router,
@@ -129,6 +134,28 @@ void FlexDR::setDebug(frDebugSettings* settings)
             : nullptr;
 }
 
+bool FlexDRWorker::benchMain(frDesign* design, StageTimes& times)
+{
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  const auto t0 = steady_clock::now();
+  init(design);
+  const auto t1 = steady_clock::now();
+  if (!skipRouting_) {
+    route_queue();
+  }
+  const auto t2 = steady_clock::now();
+  times.gc = gcWorker_ ? gcWorker_->getMainTime() : 0;
+  setGCWorker(nullptr);
+  cleanup();
+  const bool updated = end(design);
+  const auto t3 = steady_clock::now();
+  times.init = duration<double>(t1 - t0).count();
+  times.route = duration<double>(t2 - t1).count() - times.gc;
+  times.end = duration<double>(t3 - t2).count();
+  return updated;
+}
+
 std::string FlexDRWorker::reloadedMain()
 {
   init(design_);
@@ -264,6 +291,9 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
+  if (initDone_) {
+    initDone_();
+  }
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
   if (!skipRouting_) {
     route_queue();
@@ -514,6 +544,159 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+// Runs the workers of one search and repair iteration.  The workers are
+// committed by end() one at a time in batch order, as the batched flow does,
+// so the routing does not depend on the number of threads.  A worker may
+// commit as soon as the workers before it have committed and every worker of
+// its batch has finished reading the design in init.  The workers of a batch
+// are made and started once all earlier batches have committed, so each
+// worker reads the same design as in the batched flow while the commits of a
+// batch overlap the routing of its slower workers.  makeWorker returns
+// nullptr for a tile with nothing to route, which is only counted as
+// committed.
+void FlexDR::processWorkers(
+    const std::vector<std::vector<std::vector<Point>>>& tiles,
+    const std::function<std::unique_ptr<FlexDRWorker>(const Point&)>&
+        makeWorker,
+    const std::function<void()>& committed)
+{
+  ProfileTask profile("DR:processWorkers");
+  std::vector<Point> orderedTiles;
+  // batchEnds[b] is one past the index of the last tile of batch b.
+  std::vector<int> batchEnds;
+  for (const auto& tileBatch : tiles) {
+    for (const auto& tilesInBatch : tileBatch) {
+      if (tilesInBatch.empty()) {
+        continue;
+      }
+      orderedTiles.insert(
+          orderedTiles.end(), tilesInBatch.begin(), tilesInBatch.end());
+      batchEnds.push_back(orderedTiles.size());
+    }
+  }
+  if (orderedTiles.empty()) {
+    return;
+  }
+
+  const int workerCnt = orderedTiles.size();
+  const int batchCnt = batchEnds.size();
+  std::vector<int> batchOf(workerCnt);
+  for (int b = 0, i = 0; b < batchCnt; b++) {
+    for (; i < batchEnds[b]; i++) {
+      batchOf[i] = b;
+    }
+  }
+  std::vector<std::unique_ptr<FlexDRWorker>> workers(workerCnt);
+
+  std::mutex mutex;
+  // Guarded by mutex.
+  std::vector<int> initsLeft(batchCnt);
+  std::vector<char> finished(workerCnt, false);
+  int nextCommit = 0;
+  bool committing = false;
+  for (int b = 0; b < batchCnt; b++) {
+    initsLeft[b] = batchEnds[b] - (b == 0 ? 0 : batchEnds[b - 1]);
+  }
+
+  ThreadException exception;
+  std::function<void(int)> startBatch;
+  std::function<void(std::unique_lock<std::mutex>&)> commitReady;
+  auto runWorker = [&](const int i) {
+    FlexDRWorker* worker = workers[i].get();
+    bool initDone = false;
+    worker->setInitDone([&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      initsLeft[batchOf[i]]--;
+      initDone = true;
+    });
+    if (!exception.hasException()) {
+      try {
+        worker->main(getDesign());
+      } catch (...) {
+        exception.capture();
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!initDone) {
+      initsLeft[batchOf[i]]--;
+    }
+    finished[i] = true;
+    commitReady(lock);
+  };
+  // The thread finding the next worker ready commits the ready workers in
+  // order.  Workers finishing meanwhile are picked up by its loop.
+  commitReady = [&](std::unique_lock<std::mutex>& lock) {
+    if (committing) {
+      return;
+    }
+    committing = true;
+    while (nextCommit < workerCnt && finished[nextCommit]
+           && initsLeft[batchOf[nextCommit]] == 0) {
+      const int j = nextCommit;
+      lock.unlock();
+      if (!exception.hasException()) {
+        if (workers[j] != nullptr) {
+          if (workers[j]->end(getDesign())) {
+            numWorkUnits_ += 1;
+          }
+          if (workers[j]->isCongested()) {
+            increaseClipsize_ = true;
+          }
+        }
+        committed();
+      }
+      workers[j].reset();
+      const bool batchDone = j + 1 == batchEnds[batchOf[j]];
+      if (batchDone && j + 1 < workerCnt && !exception.hasException()) {
+        startBatch(batchOf[j] + 1);
+      }
+      lock.lock();
+      nextCommit++;
+    }
+    committing = false;
+  };
+  // Runs with no worker of this iteration routing, so makeWorker sees the
+  // markers left by the earlier batches.
+  startBatch = [&](const int b) {
+    const int begin = b == 0 ? 0 : batchEnds[b - 1];
+    try {
+      for (int i = begin; i < batchEnds[b]; i++) {
+        workers[i] = makeWorker(orderedTiles[i]);
+      }
+    } catch (...) {
+      exception.capture();
+    }
+    std::vector<int> started;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int i = begin; i < batchEnds[b]; i++) {
+        if (workers[i] == nullptr) {
+          initsLeft[b]--;
+          finished[i] = true;
+        } else {
+          started.push_back(i);
+        }
+      }
+    }
+    // The runtime hands the tasks to idle threads.  A task may also run at
+    // once in this thread, so they are created without holding the mutex.
+    for (int i : started) {
+#pragma omp task default(shared) firstprivate(i)
+      runWorker(i);
+    }
+  };
+
+#pragma omp parallel
+#pragma omp single
+  {
+    startBatch(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    commitReady(lock);
+  }
+  exception.rethrow();
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = (iter_++) % 64;
@@ -531,7 +714,8 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   profile_name += std::to_string(iter);
   ProfileTask profile(profile_name.c_str());
   if (ripupMode != RipUpMode::ALL
-      && getDesign()->getTopBlock()->getMarkers().empty()) {
+      && getDesign()->getTopBlock()->getMarkers().empty()
+      && !getDesign()->hasDirtyGCells()) {
     return;
   }
   if (dist_on_) {
@@ -566,67 +750,28 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int prev_perc = 0;
   bool isExceed = false;
 
-  std::vector<std::unique_ptr<FlexDRWorker>> uworkers;
   int batchStepX, batchStepY;
 
   getBatchInfo(batchStepX, batchStepY);
 
-  std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
-      batchStepX * batchStepY);
+  // Rip up all reroutes every edited area anyway.
+  std::vector<bool> dirtyGCells;
+  if (ripupMode != RipUpMode::ALL) {
+    dirtyGCells = getDesign()->getDirtyGCells();
+  }
+  getDesign()->clearDirtyGCells();
 
+  // The gcell origins of the workers, by checkerboard color and batch.
+  std::vector<std::vector<std::vector<Point>>> tiles(batchStepX * batchStepY);
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      auto worker
-          = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
-      Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
-      const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
-      const int max_j = std::min((int) ygp.getCount(), j + size - 1);
-      Rect routeBox2
-          = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
-      Rect routeBox(routeBox1.xMin(),
-                    routeBox1.yMin(),
-                    routeBox2.xMax(),
-                    routeBox2.yMax());
-      Rect extBox;
-      Rect drcBox;
-      routeBox.bloat(MTSAFEDIST, extBox);
-      routeBox.bloat(DRCSAFEDIST, drcBox);
-      worker->setRouteBox(routeBox);
-      worker->setExtBox(extBox);
-      worker->setDrcBox(drcBox);
-      worker->setGCellBox(Rect(i, j, max_i, max_j));
-      worker->setMazeEndIter(mazeEndIter);
-      worker->setDRIter(iter);
-      worker->setDebugSettings(router_->getDebugSettings());
-      if (dist_on_) {
-        worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
-      }
-      if (!iter) {
-        // if (routeBox.xMin() == 441000 && routeBox.yMin() == 816100) {
-        //   std::cout << "@@@ debug: " << i << " " << j << std::endl;
-        // }
-        // set boundary pin
-        auto bp = initDR_mergeBoundaryPin(i, j, size, routeBox);
-        worker->setDRIter(0, bp);
-      }
-      worker->setRipupMode(ripupMode);
-      worker->setFollowGuide(followGuide);
-      // TODO: only pass to relevant workers
-      worker->setGraphics(graphics_.get());
-      worker->setCost(workerDRCCost,
-                      workerMarkerCost,
-                      workerFixedShapeCost,
-                      workerMarkerDecay);
-
       int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
-      if (workers[batchIdx].empty()
-          || (!dist_on_
-              && (int) workers[batchIdx].back().size() >= BATCHSIZE)) {
-        workers[batchIdx].push_back(
-            std::vector<std::unique_ptr<FlexDRWorker>>());
+      if (tiles[batchIdx].empty()
+          || (!dist_on_ && (int) tiles[batchIdx].back().size() >= BATCHSIZE)) {
+        tiles[batchIdx].push_back(std::vector<Point>());
       }
-      workers[batchIdx].back().push_back(std::move(worker));
+      tiles[batchIdx].back().emplace_back(i, j);
 
       yIdx++;
     }
@@ -634,10 +779,119 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     xIdx++;
   }
 
+  // With skipClean, returns nullptr instead of a worker that would skip
+  // routing: past the second iteration, a tile without markers in its drc
+  // box or edited gcells.  Its grid graph is then never built.
+  int numWorkers = 0;
+  auto makeWorker = [&](const Point& tile,
+                        const bool skipClean) -> std::unique_ptr<FlexDRWorker> {
+    const int i = tile.x();
+    const int j = tile.y();
+    Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
+    const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
+    const int max_j = std::min((int) ygp.getCount(), j + size - 1);
+    Rect routeBox2
+        = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
+    Rect routeBox(routeBox1.xMin(),
+                  routeBox1.yMin(),
+                  routeBox2.xMax(),
+                  routeBox2.yMax());
+    Rect extBox;
+    Rect drcBox;
+    routeBox.bloat(MTSAFEDIST, extBox);
+    routeBox.bloat(DRCSAFEDIST, drcBox);
+
+    bool dirty = false;
+    if (!dirtyGCells.empty()) {
+      for (int x = i; x <= max_i && !dirty; x++) {
+        for (int y = j; y <= std::min(max_j, (int) ygp.getCount() - 1); y++) {
+          if (dirtyGCells[x * ygp.getCount() + y]) {
+            dirty = true;
+            break;
+          }
+        }
+      }
+    }
+    if (skipClean && iter > 1 && !dirty) {
+      std::vector<frMarker*> markers;
+      getDesign()->getRegionQuery()->queryMarker(drcBox, markers);
+      if (markers.empty()) {
+        return nullptr;
+      }
+    }
+    numWorkers++;
+
+    auto worker = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
+    worker->setNeedRecheck(dirty);
+    worker->setRouteBox(routeBox);
+    worker->setExtBox(extBox);
+    worker->setDrcBox(drcBox);
+    worker->setGCellBox(Rect(i, j, max_i, max_j));
+    worker->setMazeEndIter(mazeEndIter);
+    worker->setDRIter(iter);
+    worker->setDebugSettings(router_->getDebugSettings());
+    if (dist_on_) {
+      worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
+    }
+    if (!iter) {
+      // if (routeBox.xMin() == 441000 && routeBox.yMin() == 816100) {
+      //   std::cout << "@@@ debug: " << i << " " << j << std::endl;
+      // }
+      // set boundary pin
+      auto bp = initDR_mergeBoundaryPin(i, j, size, routeBox);
+      worker->setDRIter(0, bp);
+    }
+    worker->setRipupMode(ripupMode);
+    worker->setFollowGuide(followGuide);
+    // TODO: only pass to relevant workers
+    worker->setGraphics(graphics_.get());
+    worker->setCost(workerDRCCost,
+                    workerMarkerCost,
+                    workerFixedShapeCost,
+                    workerMarkerDecay);
+    return worker;
+  };
+
   omp_set_num_threads(MAX_THREADS);
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
+  auto reportProgress = [&]() {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          getDesign()->getTopBlock()->getNumMarkers());
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+  std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
+      tiles.size());
+  if (!dist_on_) {
+    processWorkers(
+        tiles,
+        [&](const Point& tile) { return makeWorker(tile, true); },
+        reportProgress);
+  } else {
+    // The distributed workers are all made up front and skip clean tiles
+    // when they run.
+    for (size_t batchIdx = 0; batchIdx < tiles.size(); batchIdx++) {
+      for (const auto& tilesInBatch : tiles[batchIdx]) {
+        workers[batchIdx].emplace_back();
+        for (const Point& tile : tilesInBatch) {
+          workers[batchIdx].back().push_back(makeWorker(tile, false));
+        }
+      }
+    }
+  }
   // parallel execution
   for (auto& workerBatch : workers) {
     ProfileTask profile("DR:checkerboard");
@@ -670,25 +924,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                 workersInBatch[i]->main(getDesign());
               }
 #pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
+              reportProgress();
             } catch (...) {
               exception.capture();
             }
@@ -764,6 +1000,12 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
       getDesign(), logger_, db_, graphics_.get(), dist_on_);
   checker.check(iter);
   numViols_.push_back(getDesign()->getTopBlock()->getNumMarkers());
+  debugPrint(logger_,
+             utl::DRT,
+             "workers",
+             1,
+             "Number of workers = {}.",
+             numWorkers);
   debugPrint(logger_,
              utl::DRT,
              "workers",
@@ -818,6 +1060,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     t.print(logger_);
     std::cout << std::flush;
   }
+  FlexGridGraph::clearBufferPool();
   end();
   if ((DRC_RPT_ITER_STEP && iter > 0 && iter % DRC_RPT_ITER_STEP.value() == 0)
       || logger_->debugCheck(DRT, "autotuner", 1)
@@ -1443,7 +1686,7 @@ void FlexDR::sendWorkers(
     for (auto& [idx, worker] : remote_batch) {
       std::string workerStr;
       serializeWorker(worker, workerStr);
-      workers.emplace_back(idx, workerStr);
+      workers.emplace_back(idx, std::move(workerStr));
     }
   }
   std::string remote_ip = dist_ip_;
@@ -1469,7 +1712,7 @@ void FlexDR::sendWorkers(
         = std::make_unique<RoutingJobDescription>();
     RoutingJobDescription* rjd
         = static_cast<RoutingJobDescription*>(desc.get());
-    rjd->setWorkers(workers);
+    rjd->setWorkers(std::move(workers));
     rjd->setSharedDir(dist_dir_);
     rjd->setSendEvery(20);
     msg.setJobDescription(std::move(desc));
@@ -33,6 +33,7 @@
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
 #include <deque>
+#include <functional>
 #include <memory>
 
 #include "db/drObj/drMarker.h"
@@ -162,6 +163,11 @@ class FlexDR
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  void processWorkers(
+      const std::vector<std::vector<std::vector<Point>>>& tiles,
+      const std::function<std::unique_ptr<FlexDRWorker>(const Point&)>&
+          makeWorker,
+      const std::function<void()>& committed);
 
   void init_halfViaEncArea();
 
@@ -345,6 +351,8 @@ class FlexDRWorker
     gridGraph_.setGraphics(in);
   }
   void setViaData(FlexDRViaData* viaData) { via_data_ = viaData; }
+  void setInitDone(const std::function<void()>& in) { initDone_ = in; }
+  void setNeedRecheck(bool in) { needRecheck_ = in; }
   // getters
   frTechObject* getTech() const { return design_->getTech(); }
   void getRouteBox(Rect& boxIn) const { boxIn = routeBox_; }
@@ -392,6 +400,18 @@ class FlexDRWorker
   void updateDesign(frDesign* design);
   std::string reloadedMain();
   bool end(frDesign* design);
+  // Wall times of the stages of a worker, in seconds.  Route excludes the
+  // time spent in the GC worker.
+  struct StageTimes
+  {
+    double init = 0;
+    double route = 0;
+    double gc = 0;
+    double end = 0;
+  };
+  // Runs a reloaded worker and commits it like reloadedMain() followed by
+  // end(), recording the time of each stage.  Used to benchmark dumps.
+  bool benchMain(frDesign* design, StageTimes& times);
 
   Logger* getLogger() { return logger_; }
   void setLogger(Logger* logger)
@@ -451,6 +471,8 @@ class FlexDRWorker
   FlexDRGraphics* graphics_ = nullptr;  // owned by FlexDR
   frDebugSettings* debugSettings_ = nullptr;
   FlexDRViaData* via_data_ = nullptr;
+  // Called by main() once the worker no longer reads the design.
+  std::function<void()> initDone_;
   Rect routeBox_;
   Rect extBox_;
   Rect drcBox_;
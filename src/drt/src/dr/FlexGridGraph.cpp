@@ -31,6 +31,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
 
 #include "dr/FlexDR.h"
 
@@ -70,24 +71,72 @@ void FlexGridGraph::initGrids(
   getDim(xDim, yDim, zDim);
   const int capacity = xDim * yDim * zDim;
 
-  nodes_.clear();
-  nodes_.resize(capacity, Node());
-  // new
-  prevDirs_.clear();
-  srcs_.clear();
-  dsts_.clear();
+  acquireBuffers();
+  nodes_.assign(capacity, Node());
+  nodeStates_.assign(capacity, followGuide ? 0 : guide_bit);
+}
 
-  prevDirs_.resize(capacity * 3, false);
-  srcs_.resize(capacity, false);
-  dsts_.resize(capacity, false);
-  guides_.clear();
-  if (followGuide) {
-    guides_.resize(capacity, false);
-  } else {
-    guides_.resize(capacity, true);
+struct FlexGridGraph::BufferPool
+{
+  std::mutex mutex;
+  std::vector<frVector<Node>> nodes;
+  std::vector<std::vector<uint8_t>> nodeStates;
+};
+
+FlexGridGraph::BufferPool& FlexGridGraph::bufferPool()
+{
+  static BufferPool pool;
+  return pool;
+}
+
+// Workers are short lived and their grids are of similar size, so a new
+// grid takes the buffers of a finished one instead of allocating and page
+// faulting its own.
+void FlexGridGraph::acquireBuffers()
+{
+  if (nodes_.capacity() != 0) {
+    return;
+  }
+  BufferPool& pool = bufferPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  if (!pool.nodes.empty()) {
+    nodes_.swap(pool.nodes.back());
+    pool.nodes.pop_back();
+  }
+  if (!pool.nodeStates.empty()) {
+    nodeStates_.swap(pool.nodeStates.back());
+    pool.nodeStates.pop_back();
   }
 }
 
+void FlexGridGraph::releaseBuffers()
+{
+  nodes_.clear();
+  nodeStates_.clear();
+  BufferPool& pool = bufferPool();
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (nodes_.capacity() != 0) {
+      pool.nodes.emplace_back(std::move(nodes_));
+    }
+    if (nodeStates_.capacity() != 0) {
+      pool.nodeStates.emplace_back(std::move(nodeStates_));
+    }
+  }
+  nodes_ = frVector<Node>();
+  nodeStates_ = std::vector<uint8_t>();
+}
+
+void FlexGridGraph::clearBufferPool()
+{
+  BufferPool& pool = bufferPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.nodes.clear();
+  pool.nodes.shrink_to_fit();
+  pool.nodeStates.clear();
+  pool.nodeStates.shrink_to_fit();
+}
+
 bool FlexGridGraph::outOfDieVia(frMIdx x,
                                 frMIdx y,
                                 frMIdx z,
@@ -443,24 +492,30 @@ void FlexGridGraph::initTracks(
 
 void FlexGridGraph::resetStatus()
 {
-  resetSrc();
-  resetDst();
-  resetPrevNodeDir();
+  clearStateBits(src_bit | dst_bit | prev_dir_mask);
+}
+
+void FlexGridGraph::clearStateBits(uint8_t mask)
+{
+  const uint8_t keep = ~mask;
+  for (uint8_t& state : nodeStates_) {
+    state &= keep;
+  }
 }
 
 void FlexGridGraph::resetSrc()
 {
-  srcs_.assign(srcs_.size(), false);
+  clearStateBits(src_bit);
 }
 
 void FlexGridGraph::resetDst()
 {
-  dsts_.assign(dsts_.size(), false);
+  clearStateBits(dst_bit);
 }
 
 void FlexGridGraph::resetPrevNodeDir()
 {
-  prevDirs_.assign(prevDirs_.size(), false);
+  clearStateBits(prev_dir_mask);
 }
 
 // print the grid graph with edge and vertex for debug purpose
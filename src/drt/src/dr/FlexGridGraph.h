@@ -646,17 +646,17 @@ class FlexGridGraph
   }
 
   // unsafe access, no idx check
-  void setSrc(frMIdx x, frMIdx y, frMIdx z) { srcs_[getIdx(x, y, z)] = true; }
-  void setSrc(const FlexMazeIdx& mi)
+  void setSrc(frMIdx x, frMIdx y, frMIdx z)
   {
-    srcs_[getIdx(mi.x(), mi.y(), mi.z())] = true;
+    nodeStates_[getIdx(x, y, z)] |= src_bit;
   }
+  void setSrc(const FlexMazeIdx& mi) { setSrc(mi.x(), mi.y(), mi.z()); }
   // unsafe access, no idx check
-  void setDst(frMIdx x, frMIdx y, frMIdx z) { dsts_[getIdx(x, y, z)] = true; }
-  void setDst(const FlexMazeIdx& mi)
+  void setDst(frMIdx x, frMIdx y, frMIdx z)
   {
-    dsts_[getIdx(mi.x(), mi.y(), mi.z())] = true;
+    nodeStates_[getIdx(x, y, z)] |= dst_bit;
   }
+  void setDst(const FlexMazeIdx& mi) { setDst(mi.x(), mi.y(), mi.z()); }
   // unsafe access
   void setSVia(frMIdx x, frMIdx y, frMIdx z)
   {
@@ -704,21 +704,15 @@ class FlexGridGraph
   // unsafe access, no idx check
   void resetSrc(frMIdx x, frMIdx y, frMIdx z)
   {
-    srcs_[getIdx(x, y, z)] = false;
-  }
-  void resetSrc(const FlexMazeIdx& mi)
-  {
-    srcs_[getIdx(mi.x(), mi.y(), mi.z())] = false;
+    nodeStates_[getIdx(x, y, z)] &= ~src_bit;
   }
+  void resetSrc(const FlexMazeIdx& mi) { resetSrc(mi.x(), mi.y(), mi.z()); }
   // unsafe access, no idx check
   void resetDst(frMIdx x, frMIdx y, frMIdx z)
   {
-    dsts_[getIdx(x, y, z)] = false;
-  }
-  void resetDst(const FlexMazeIdx& mi)
-  {
-    dsts_[getIdx(mi.x(), mi.y(), mi.z())] = false;
+    nodeStates_[getIdx(x, y, z)] &= ~dst_bit;
   }
+  void resetDst(const FlexMazeIdx& mi) { resetDst(mi.x(), mi.y(), mi.z()); }
   void resetGridCost(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir)
   {
     correct(x, y, z, dir);
@@ -743,7 +737,7 @@ class FlexGridGraph
   {
     reverse(x, y, z, dir);
     auto idx = getIdx(x, y, z);
-    return guides_[idx];
+    return nodeStates_[idx] & guide_bit;
   }
   // must be safe access because idx1 and idx2 may be invalid
   void setGuide(frMIdx x1, frMIdx y1, frMIdx x2, frMIdx y2, frMIdx z)
@@ -756,14 +750,14 @@ class FlexGridGraph
         for (int i = y1; i <= y2; i++) {
           auto idx1 = getIdx(x1, i, z);
           auto idx2 = getIdx(x2, i, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 1);
+          setGuideRange(idx1, idx2, true);
         }
         break;
       case dbTechLayerDir::VERTICAL:
         for (int i = x1; i <= x2; i++) {
           auto idx1 = getIdx(i, y1, z);
           auto idx2 = getIdx(i, y2, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 1);
+          setGuideRange(idx1, idx2, true);
         }
         break;
       case dbTechLayerDir::NONE:
@@ -781,14 +775,14 @@ class FlexGridGraph
         for (int i = y1; i <= y2; i++) {
           auto idx1 = getIdx(x1, i, z);
           auto idx2 = getIdx(x2, i, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 0);
+          setGuideRange(idx1, idx2, false);
         }
         break;
       case dbTechLayerDir::VERTICAL:
         for (int i = x1; i <= x2; i++) {
           auto idx1 = getIdx(i, y1, z);
           auto idx2 = getIdx(i, y2, z);
-          std::fill(guides_.begin() + idx1, guides_.begin() + idx2 + 1, 0);
+          setGuideRange(idx1, idx2, false);
         }
         break;
       case dbTechLayerDir::NONE:
@@ -856,18 +850,13 @@ class FlexGridGraph
     return (isLayer1 ? (*halfViaEncArea_)[z].first
                      : (*halfViaEncArea_)[z].second);
   }
+  // Frees the node buffers kept for reuse by cleanup().
+  static void clearBufferPool();
   int nTracksX() { return xCoords_.size(); }
   int nTracksY() { return yCoords_.size(); }
   void cleanup()
   {
-    nodes_.clear();
-    nodes_.shrink_to_fit();
-    srcs_.clear();
-    srcs_.shrink_to_fit();
-    dsts_.clear();
-    dsts_.shrink_to_fit();
-    guides_.clear();
-    guides_.shrink_to_fit();
+    releaseBuffers();
     xCoords_.clear();
     xCoords_.shrink_to_fit();
     yCoords_.clear();
@@ -887,26 +876,28 @@ class FlexGridGraph
     Node& n = nodes_[getIdx(x, y, z)];
     std::cout << "\nNode ( " << x << " " << y << " " << z << " ) (idx) / "
               << " ( " << xCoords_[x] << " " << yCoords_[y] << " ) (coords)\n";
-    std::cout << "hasEastEdge " << n.hasEastEdge << "\n";
-    std::cout << "hasNorthEdge " << n.hasNorthEdge << "\n";
-    std::cout << "hasUpEdge " << n.hasUpEdge << "\n";
-    std::cout << "isBlockedEast " << n.isBlockedEast << "\n";
-    std::cout << "isBlockedNorth " << n.isBlockedNorth << "\n";
-    std::cout << "isBlockedUp " << n.isBlockedUp << "\n";
-    std::cout << "hasSpecialVia " << n.hasSpecialVia << "\n";
-    std::cout << "overrideShapeCostVia " << n.overrideShapeCostVia << "\n";
-    std::cout << "hasGridCostEast " << n.hasGridCostEast << "\n";
-    std::cout << "hasGridCostNorth " << n.hasGridCostNorth << "\n";
-    std::cout << "hasGridCostUp " << n.hasGridCostUp << "\n";
-    std::cout << "routeShapeCostPlanar " << n.routeShapeCostPlanar << "\n";
-    std::cout << "routeShapeCostVia " << n.routeShapeCostVia << "\n";
-    std::cout << "markerCostPlanar " << n.markerCostPlanar << "\n";
-    std::cout << "markerCostVia " << n.markerCostVia << "\n";
-    std::cout << "fixedShapeCostVia " << n.fixedShapeCostVia << "\n";
-    std::cout << "fixedShapeCostPlanarHorz " << n.fixedShapeCostPlanarHorz
+    std::cout << "hasEastEdge " << (int) n.hasEastEdge << "\n";
+    std::cout << "hasNorthEdge " << (int) n.hasNorthEdge << "\n";
+    std::cout << "hasUpEdge " << (int) n.hasUpEdge << "\n";
+    std::cout << "isBlockedEast " << (int) n.isBlockedEast << "\n";
+    std::cout << "isBlockedNorth " << (int) n.isBlockedNorth << "\n";
+    std::cout << "isBlockedUp " << (int) n.isBlockedUp << "\n";
+    std::cout << "hasSpecialVia " << (int) n.hasSpecialVia << "\n";
+    std::cout << "overrideShapeCostVia " << (int) n.overrideShapeCostVia
               << "\n";
-    std::cout << "fixedShapeCostPlanarVert " << n.fixedShapeCostPlanarVert
+    std::cout << "hasGridCostEast " << (int) n.hasGridCostEast << "\n";
+    std::cout << "hasGridCostNorth " << (int) n.hasGridCostNorth << "\n";
+    std::cout << "hasGridCostUp " << (int) n.hasGridCostUp << "\n";
+    std::cout << "routeShapeCostPlanar " << (int) n.routeShapeCostPlanar
               << "\n";
+    std::cout << "routeShapeCostVia " << (int) n.routeShapeCostVia << "\n";
+    std::cout << "markerCostPlanar " << (int) n.markerCostPlanar << "\n";
+    std::cout << "markerCostVia " << (int) n.markerCostVia << "\n";
+    std::cout << "fixedShapeCostVia " << (int) n.fixedShapeCostVia << "\n";
+    std::cout << "fixedShapeCostPlanarHorz "
+              << (int) n.fixedShapeCostPlanarHorz << "\n";
+    std::cout << "fixedShapeCostPlanarVert "
+              << (int) n.fixedShapeCostPlanarVert << "\n";
   }
 
  private:
@@ -917,54 +908,61 @@ class FlexGridGraph
                               //
 #ifdef DEBUG_DRT_UNDERFLOW
   static constexpr int cost_bits = 16;
+  using CostBits = uint16_t;
 #else
   static constexpr int cost_bits = 8;
+  using CostBits = uint8_t;
 #endif
 
+  // Byte sized fields leave no padding in the node.  The per-search state
+  // lives in nodeStates_ so resetting it does not touch the costs.
   struct Node
   {
     Node() { std::memset(this, 0, sizeof(Node)); }
     // Byte 0
-    frUInt4 hasEastEdge : 1;
-    frUInt4 hasNorthEdge : 1;
-    frUInt4 hasUpEdge : 1;
-    frUInt4 isBlockedEast : 1;
-    frUInt4 isBlockedNorth : 1;
-    frUInt4 isBlockedUp : 1;
-    frUInt4 unused1 : 1;
-    frUInt4 unused2 : 1;
+    uint8_t hasEastEdge : 1;
+    uint8_t hasNorthEdge : 1;
+    uint8_t hasUpEdge : 1;
+    uint8_t isBlockedEast : 1;
+    uint8_t isBlockedNorth : 1;
+    uint8_t isBlockedUp : 1;
+    uint8_t unused1 : 1;
+    uint8_t unused2 : 1;
     // Byte 1
-    frUInt4 hasSpecialVia : 1;
-    frUInt4 overrideShapeCostVia : 1;
-    frUInt4 hasGridCostEast : 1;
-    frUInt4 hasGridCostNorth : 1;
-    frUInt4 hasGridCostUp : 1;
-    frUInt4 unused3 : 1;
-    frUInt4 unused4 : 1;
-    frUInt4 unused5 : 1;
+    uint8_t hasSpecialVia : 1;
+    uint8_t overrideShapeCostVia : 1;
+    uint8_t hasGridCostEast : 1;
+    uint8_t hasGridCostNorth : 1;
+    uint8_t hasGridCostUp : 1;
+    uint8_t unused3 : 1;
+    uint8_t unused4 : 1;
+    uint8_t unused5 : 1;
     // Byte 2
-    frUInt4 routeShapeCostPlanar : cost_bits;
+    CostBits routeShapeCostPlanar : cost_bits;
     // Byte 3
-    frUInt4 routeShapeCostVia : cost_bits;
+    CostBits routeShapeCostVia : cost_bits;
     // Byte4
-    frUInt4 markerCostPlanar : cost_bits;
+    CostBits markerCostPlanar : cost_bits;
     // Byte5
-    frUInt4 markerCostVia : cost_bits;
+    CostBits markerCostVia : cost_bits;
     // Byte6
-    frUInt4 fixedShapeCostVia : cost_bits;
+    CostBits fixedShapeCostVia : cost_bits;
     // Byte7
-    frUInt4 fixedShapeCostPlanarHorz : cost_bits;
+    CostBits fixedShapeCostPlanarHorz : cost_bits;
     // Byte8
-    frUInt4 fixedShapeCostPlanarVert : cost_bits;
+    CostBits fixedShapeCostPlanarVert : cost_bits;
   };
 #ifndef DEBUG_DRT_UNDERFLOW
-  static_assert(sizeof(Node) == 12);
+  static_assert(sizeof(Node) == 9);
 #endif
   frVector<Node> nodes_;
-  std::vector<bool> prevDirs_;
-  std::vector<bool> srcs_;
-  std::vector<bool> dsts_;
-  std::vector<bool> guides_;
+  // One byte of search state per node: the A* back pointer direction, the
+  // src/dst marks and whether the node is inside the route guide.
+  static constexpr uint8_t prev_dir_mask = 0x7;
+  static constexpr uint8_t src_bit = 0x8;
+  static constexpr uint8_t dst_bit = 0x10;
+  static constexpr uint8_t guide_bit = 0x20;
+  std::vector<uint8_t> nodeStates_;
   frVector<frCoord> xCoords_;
   frVector<frCoord> yCoords_;
   frVector<frLayerNum> zCoords_;
@@ -988,35 +986,31 @@ class FlexGridGraph
   // unsafe access, no idx check
   void setPrevAstarNodeDir(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir)
   {
-    auto baseIdx = 3 * getIdx(x, y, z);
-    prevDirs_[baseIdx] = ((uint16_t) dir >> 2) & 1;
-    prevDirs_[baseIdx + 1] = ((uint16_t) dir >> 1) & 1;
-    prevDirs_[baseIdx + 2] = ((uint16_t) dir) & 1;
+    uint8_t& state = nodeStates_[getIdx(x, y, z)];
+    state = (state & ~prev_dir_mask) | ((uint8_t) dir & prev_dir_mask);
   }
 
   // unsafe access, no check
   frDirEnum getPrevAstarNodeDir(const FlexMazeIdx& idx) const
   {
-    auto baseIdx = 3 * getIdx(idx.x(), idx.y(), idx.z());
-    return (frDirEnum) (((uint16_t) (prevDirs_[baseIdx]) << 2)
-                        + ((uint16_t) (prevDirs_[baseIdx + 1]) << 1)
-                        + ((uint16_t) (prevDirs_[baseIdx + 2]) << 0));
+    return (frDirEnum) (nodeStates_[getIdx(idx.x(), idx.y(), idx.z())]
+                        & prev_dir_mask);
   }
 
   // unsafe access, no check
   bool isSrc(frMIdx x, frMIdx y, frMIdx z) const
   {
-    return srcs_[getIdx(x, y, z)];
+    return nodeStates_[getIdx(x, y, z)] & src_bit;
   }
   // unsafe access, no check
   bool isDst(frMIdx x, frMIdx y, frMIdx z) const
   {
-    return dsts_[getIdx(x, y, z)];
+    return nodeStates_[getIdx(x, y, z)] & dst_bit;
   }
   bool isDst(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir) const
   {
     getNextGrid(x, y, z, dir);
-    bool b = dsts_[getIdx(x, y, z)];
+    bool b = nodeStates_[getIdx(x, y, z)] & dst_bit;
     getPrevGrid(x, y, z, dir);
     return b;
   }
@@ -1035,6 +1029,23 @@ class FlexGridGraph
     return zDirModifier + partialCoordinates;
   }
 
+  void setGuideRange(frMIdx idx1, frMIdx idx2, bool value)
+  {
+    for (frMIdx idx = idx1; idx <= idx2; idx++) {
+      if (value) {
+        nodeStates_[idx] |= guide_bit;
+      } else {
+        nodeStates_[idx] &= ~guide_bit;
+      }
+    }
+  }
+  void clearStateBits(uint8_t mask);
+  // Node buffers are recycled between workers through a shared pool.
+  struct BufferPool;
+  static BufferPool& bufferPool();
+  void acquireBuffers();
+  void releaseBuffers();
+
   frUInt4 addToByte(frUInt4 augend, frUInt4 summand)
   {
     frUInt4 result = augend + summand;
@@ -1209,10 +1220,7 @@ class FlexGridGraph
     }
     (ar) & drWorker_;
     (ar) & nodes_;
-    (ar) & prevDirs_;
-    (ar) & srcs_;
-    (ar) & dsts_;
-    (ar) & guides_;
+    (ar) & nodeStates_;
     (ar) & xCoords_;
     (ar) & yCoords_;
     (ar) & zCoords_;
@@ -1225,6 +1233,7 @@ class FlexGridGraph
   }
   friend class boost::serialization::access;
   friend class FlexDRWorker;
+  friend struct GridGraphFixture;
 };
 
 }  // namespace drt
@@ -121,6 +121,31 @@ class frDesign
   }
   void incrementVersion() { ++version_; }
   int getVersion() const { return version_; }
+  // Gcells edited since the last search and repair iteration, indexed by
+  // x * (number of gcell rows) + y.  Detailed routing rechecks the workers
+  // covering them even without markers.  Empty when nothing was edited.
+  void addDirtyBox(const Rect& box)
+  {
+    const auto& gCellPatterns = topBlock_->getGCellPatterns();
+    if (gCellPatterns.empty()) {
+      // Nothing was routed yet.
+      return;
+    }
+    const int yCnt = gCellPatterns.at(1).getCount();
+    if (dirty_gcells_.empty()) {
+      dirty_gcells_.assign(gCellPatterns.at(0).getCount() * yCnt, false);
+    }
+    const Point ll = topBlock_->getGCellIdx(box.ll());
+    const Point ur = topBlock_->getGCellIdx(box.ur());
+    for (int x = ll.x(); x <= ur.x(); x++) {
+      for (int y = ll.y(); y <= ur.y(); y++) {
+        dirty_gcells_[x * yCnt + y] = true;
+      }
+    }
+  }
+  const std::vector<bool>& getDirtyGCells() const { return dirty_gcells_; }
+  bool hasDirtyGCells() const { return !dirty_gcells_.empty(); }
+  void clearDirtyGCells() { dirty_gcells_.clear(); }
 
  private:
   std::unique_ptr<frBlock> topBlock_;
@@ -130,6 +155,7 @@ class frDesign
   std::unique_ptr<frRegionQuery> rq_;
   std::vector<std::vector<drUpdate>> updates_;
   int updates_sz_;
+  std::vector<bool> dirty_gcells_;
   std::vector<std::string> user_selected_vias_;
   int version_;
 };
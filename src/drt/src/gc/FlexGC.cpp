@@ -90,7 +90,10 @@ void FlexGCWorker::init(const frDesign* design)
 
 int FlexGCWorker::main()
 {
-  return impl_->main();
+  const auto start = std::chrono::steady_clock::now();
+  const int result = impl_->main();
+  main_time_ += std::chrono::steady_clock::now() - start;
+  return result;
 }
 
 void FlexGCWorker::checkMinStep(gcPin* pin)
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include "frDesign.h"
@@ -79,10 +80,13 @@ class FlexGCWorker
   // used in rp_prep
   void checkMinStep(gcPin* pin);
   void updateGCWorker();
+  // total wall time spent in main(), in seconds
+  double getMainTime() const { return main_time_.count(); }
 
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
+  std::chrono::duration<double> main_time_{0};
 };
 struct MarkerId
 {
@@ -28,8 +28,8 @@
 
 #include "FlexPA.h"
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <boost/serialization/export.hpp>
 #include <chrono>
@@ -110,6 +110,7 @@ void FlexPA::prep()
   ProfileTask profile("PA:prep");
   prepPoint();
   revertAccessPoints();
+  saveCachedPoints();
   if (isDistributed()) {
     std::vector<paUpdate> updates;
     paUpdate update;
@@ -37,6 +37,7 @@ namespace gtl = boost::polygon;
 
 namespace odb {
 class dbDatabase;
+class dbTech;
 }
 
 namespace dst {
@@ -56,6 +57,7 @@ using ViaRawPriorityTuple
 class FlexPinAccessPattern;
 class FlexDPNode;
 class FlexPAGraphics;
+class PinAccessCache;
 
 class FlexPA
 {
@@ -75,6 +77,14 @@ class FlexPA
                       uint16_t rport,
                       const std::string& shared_vol,
                       int cloud_sz);
+  // Reuse the access points of unique instance classes analyzed by
+  // earlier runs and record the new ones.  db_tech is the tech the design
+  // was read from.
+  void setCache(PinAccessCache* cache, odb::dbTech* db_tech)
+  {
+    cache_ = cache;
+    db_tech_ = db_tech;
+  }
 
   int main();
 
@@ -99,6 +109,10 @@ class FlexPA
       uniqueInstPatterns_;
 
   UniqueInsts unique_insts_;
+  PinAccessCache* cache_{nullptr};
+  odb::dbTech* db_tech_{nullptr};
+  // unique instances whose access points came from cache_
+  std::vector<bool> cached_unique_;
 
   // helper structures
   std::vector<std::map<frCoord, frAccessPointEnum>> trackCoords_;
@@ -131,6 +145,9 @@ class FlexPA
   // prep
   void prep();
   void prepPoint();
+  std::string getCacheSignature() const;
+  void restoreCachedPoints();
+  void saveCachedPoints();
   void getViasFromMetalWidthMap(
       const Point& pt,
       frLayerNum layerNum,
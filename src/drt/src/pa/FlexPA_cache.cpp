@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "FlexPA_cache.h"
+
+#include "db/tech/frViaDef.h"
+
+namespace drt {
+
+void PinAccessCache::validate(const std::string& signature)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (signature != signature_) {
+    classes_.clear();
+    signature_ = signature;
+  }
+}
+
+void PinAccessCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  classes_.clear();
+  signature_.clear();
+}
+
+void PinAccessCache::postReadLef(odb::dbTech* tech, odb::dbLib* library)
+{
+  clear();
+}
+
+void PinAccessCache::postReadDef(odb::dbBlock* block)
+{
+  clear();
+}
+
+void PinAccessCache::postReadDb(odb::dbDatabase* db)
+{
+  clear();
+}
+
+bool PinAccessCache::restore(const UniqueInsts::ClassKey& key,
+                             frInst* inst,
+                             int paIdx,
+                             frTechObject* tech) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = classes_.find(key);
+  if (it == classes_.end()) {
+    return false;
+  }
+  // Build all the pin accesses first so a class that no longer matches the
+  // instance leaves its pins untouched.
+  const auto& entries = it->second;
+  std::vector<std::pair<frMPin*, std::unique_ptr<frPinAccess>>> restored;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      if (restored.size() >= entries.size()) {
+        return false;
+      }
+      const PinEntry& entry = entries[restored.size()];
+      auto pa = std::make_unique<frPinAccess>();
+      const auto& aps = entry.pin_access->getAccessPoints();
+      for (int i = 0; i < (int) aps.size(); i++) {
+        auto ap = std::make_unique<frAccessPoint>(*aps[i]);
+        std::vector<std::vector<frViaDef*>> viaDefs;
+        for (const auto& names : entry.via_names[i]) {
+          auto& cut_defs = viaDefs.emplace_back();
+          for (const auto& name : names) {
+            frViaDef* viaDef = tech->getVia(name);
+            if (viaDef == nullptr) {
+              return false;
+            }
+            cut_defs.push_back(viaDef);
+          }
+        }
+        ap->setViaDefs(std::move(viaDefs));
+        pa->addAccessPoint(std::move(ap));
+      }
+      restored.emplace_back(pin.get(), std::move(pa));
+    }
+  }
+  if (restored.size() != entries.size()) {
+    return false;
+  }
+  for (auto& [pin, pa] : restored) {
+    pin->setPinAccess(paIdx, std::move(pa));
+  }
+  return true;
+}
+
+void PinAccessCache::store(const UniqueInsts::ClassKey& key,
+                           frInst* inst,
+                           int paIdx)
+{
+  std::vector<PinEntry> entries;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      PinEntry& entry = entries.emplace_back();
+      entry.pin_access
+          = std::make_unique<frPinAccess>(*pin->getPinAccess(paIdx));
+      entry.pin_access->setPin(nullptr);
+      for (auto& ap : entry.pin_access->getAccessPoints()) {
+        auto& names = entry.via_names.emplace_back();
+        for (const auto& cut_defs : ap->getAllViaDefs()) {
+          auto& cut_names = names.emplace_back();
+          for (frViaDef* viaDef : cut_defs) {
+            cut_names.push_back(viaDef->getName());
+          }
+        }
+        ap->setViaDefs({});
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  classes_[key] = std::move(entries);
+}
+
+}  // namespace drt
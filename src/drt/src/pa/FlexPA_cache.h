@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FlexPA_unique.h"
+#include "frDesign.h"
+#include "ord/OpenRoadObserver.hh"
+
+namespace drt {
+
+// Keeps the access points computed for each unique instance class so that
+// later pin access runs in the same session (e.g. after an ECO) only
+// analyze the classes they have not seen before.  Classes are keyed as in
+// UniqueInsts; all entries are dropped when the tech, the tracks or the
+// pin access settings change, and whenever a LEF, DEF or db is read.
+class PinAccessCache : public ord::OpenRoadObserver
+{
+ public:
+  // Drops all entries if they were computed for a different signature.
+  void validate(const std::string& signature);
+  void clear();
+
+  // From ord::OpenRoadObserver
+  void postReadLef(odb::dbTech* tech, odb::dbLib* library) override;
+  void postReadDef(odb::dbBlock* block) override;
+  void postReadDb(odb::dbDatabase* db) override;
+
+  // Copies the cached access points of the class onto the pins of inst
+  // at pin access index paIdx.  Returns false if the class is not cached.
+  bool restore(const UniqueInsts::ClassKey& key,
+               frInst* inst,
+               int paIdx,
+               frTechObject* tech) const;
+  // Records the access points of inst at paIdx for the class.  They must
+  // already be relative to the instance origin.
+  void store(const UniqueInsts::ClassKey& key, frInst* inst, int paIdx);
+
+  int size() const { return classes_.size(); }
+
+ private:
+  // Access points of one pin.  Via defs are kept by name as the cache
+  // outlives the frTechObject they belong to.
+  struct PinEntry
+  {
+    std::unique_ptr<frPinAccess> pin_access;
+    // access point -> cut number - 1 -> via name
+    std::vector<std::vector<std::vector<std::string>>> via_names;
+  };
+
+  std::string signature_;
+  // pins in the order of the instance terms
+  std::map<UniqueInsts::ClassKey, std::vector<PinEntry>> classes_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace drt
@@ -34,6 +34,7 @@
 #include <sstream>
 
 #include "FlexPA.h"
+#include "FlexPA_cache.h"
 #include "FlexPA_graphics.h"
 #include "db/infra/frTime.h"
 #include "distributed/PinAccessJobDescription.h"
@@ -42,6 +43,7 @@
 #include "dst/JobMessage.h"
 #include "frProfileTask.h"
 #include "gc/FlexGC.h"
+#include "odb/lefout.h"
 #include "serialization.h"
 #include "utl/exception.h"
 
@@ -1527,17 +1529,117 @@ static inline void serializeInstRows(
   paUpdate::serialize(update, file_name);
 }
 
+// Everything besides the instance class that changes the access points
+// computed for it.
+std::string FlexPA::getCacheSignature() const
+{
+  std::stringstream ss;
+  frTechObject* tech = getTech();
+  ss << tech->getDBUPerUU() << ' ' << tech->getManufacturingGrid();
+  for (const auto& layer : tech->getLayers()) {
+    ss << ' ' << layer->getName() << ':' << layer->getType().getValue() << ':'
+       << layer->isHorizontal() << ':' << layer->getWidth() << ':'
+       << layer->getMinWidth() << ':' << layer->getPitch() << ':'
+       << layer->getNumMasks();
+    if (layer->getType() == dbTechLayerType::ROUTING) {
+      ss << ':' << layer->getWrongDirWidth();
+      if (layer->hasMinSpacing()) {
+        ss << ':'
+           << layer->getMinSpacingValue(
+                  layer->getMinWidth(), layer->getMinWidth(), 0, false);
+      }
+    }
+    if (layer->getDefaultViaDef() != nullptr) {
+      ss << ':' << layer->getDefaultViaDef()->getName();
+    }
+  }
+  for (int i = 0; frConstraint* con = tech->getConstraint(i); i++) {
+    ss << ' ' << int(con->typeId());
+  }
+  // The values of the rules.  lefin keeps every layer property, LEF58 ones
+  // included, so the tech written back as LEF holds all of them.
+  if (db_tech_ != nullptr) {
+    ss << '\n';
+    odb::lefout writer(logger_, ss);
+    writer.writeTech(db_tech_);
+  }
+  ss << ' ' << tech->getVias().size();
+  for (const auto& via : getDesign()->getUserSelectedVias()) {
+    ss << ' ' << via;
+  }
+  for (frTrackPattern* tp : getDesign()->getTopBlock()->getTrackPatterns()) {
+    ss << ' ' << tp->getLayerNum() << ':' << tp->isHorizontal() << ':'
+       << tp->getStartCoord() << ':' << tp->getTrackSpacing() << ':'
+       << tp->getNumTracks();
+  }
+  ss << ' ' << USENONPREFTRACKS << ' ' << VIAINPIN_BOTTOMLAYERNUM << ' '
+     << VIAINPIN_TOPLAYERNUM << ' ' << BOTTOM_ROUTING_LAYER << ' '
+     << TOP_ROUTING_LAYER << ' ' << MINNUMACCESSPOINT_STDCELLPIN << ' '
+     << MINNUMACCESSPOINT_MACROCELLPIN;
+  return ss.str();
+}
+
+// Copies the access points of the unique instances whose class is in the
+// cache.  They are already relative to the instance origin.
+void FlexPA::restoreCachedPoints()
+{
+  const auto& unique = unique_insts_.getUnique();
+  cached_unique_.assign(unique.size(), false);
+  if (cache_ == nullptr) {
+    return;
+  }
+  cache_->validate(getCacheSignature());
+  int cnt = 0;
+  for (int i = 0; i < (int) unique.size(); i++) {
+    const UniqueInsts::ClassKey* key = unique_insts_.getClassKey(i);
+    if (key == nullptr) {
+      continue;
+    }
+    frInst* inst = unique[i];
+    if (cache_->restore(
+            *key, inst, unique_insts_.getPAIndex(inst), getTech())) {
+      cached_unique_[i] = true;
+      cnt++;
+    }
+  }
+  if (VERBOSE > 0 && cnt > 0) {
+    logger_->info(
+        DRT, 627, "  Reused access points of {} unique instances.", cnt);
+  }
+}
+
+void FlexPA::saveCachedPoints()
+{
+  if (cache_ == nullptr) {
+    return;
+  }
+  const auto& unique = unique_insts_.getUnique();
+  for (int i = 0; i < (int) unique.size(); i++) {
+    const UniqueInsts::ClassKey* key = unique_insts_.getClassKey(i);
+    if (key == nullptr || cached_unique_[i]) {
+      continue;
+    }
+    frInst* inst = unique[i];
+    cache_->store(*key, inst, unique_insts_.getPAIndex(inst));
+  }
+}
+
 void FlexPA::prepPoint()
 {
   ProfileTask profile("PA:point");
   int cnt = 0;
 
+  restoreCachedPoints();
+
   omp_set_num_threads(MAX_THREADS);
   ThreadException exception;
   const auto& unique = unique_insts_.getUnique();
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < (int) unique.size(); i++) {  // NOLINT
     try {
+      if (cached_unique_[i]) {
+        continue;
+      }
       auto& inst = unique[i];
       // only do for core and block cells
       dbMasterType masterType = inst->getMaster()->getMasterType();
@@ -1867,7 +1969,11 @@ void FlexPA::prepPattern()
 void FlexPA::revertAccessPoints()
 {
   const auto& unique = unique_insts_.getUnique();
-  for (auto& inst : unique) {
+  for (int i = 0; i < (int) unique.size(); i++) {
+    if (cached_unique_[i]) {
+      continue;
+    }
+    frInst* inst = unique[i];
     const dbTransform xform = inst->getTransform();
     const Point offset(xform.getOffset());
     dbTransform revertXform;
@@ -38,6 +38,45 @@ UniqueInsts::UniqueInsts(frDesign* design,
 {
 }
 
+// Digest of the master shapes the access points of its instances depend on,
+// so a master redefined under the same name makes a different class key.
+static std::string getMasterDigest(const frMaster* master)
+{
+  std::stringstream ss;
+  auto addFig = [&ss](const frPinFig* fig) {
+    const Rect box = fig->getBBox();
+    ss << ' ' << int(fig->typeId()) << ':' << box.xMin() << ':' << box.yMin()
+       << ':' << box.xMax() << ':' << box.yMax();
+    if (auto shape = dynamic_cast<const frShape*>(fig)) {
+      ss << ':' << shape->getLayerNum();
+    }
+    if (auto polygon = dynamic_cast<const frPolygon*>(fig)) {
+      for (const Point& pt : polygon->getPoints()) {
+        ss << ':' << pt.x() << ',' << pt.y();
+      }
+    }
+  };
+  const Rect dieBox = master->getDieBox();
+  ss << dieBox.xMin() << ':' << dieBox.yMin() << ':' << dieBox.xMax() << ':'
+     << dieBox.yMax();
+  for (const auto& term : master->getTerms()) {
+    ss << " T" << term->getName();
+    for (const auto& pin : term->getPins()) {
+      ss << " P";
+      for (const auto& fig : pin->getFigs()) {
+        addFig(fig.get());
+      }
+    }
+  }
+  for (const auto& blockage : master->getBlockages()) {
+    ss << " B" << blockage->getDesignRuleWidth();
+    for (const auto& fig : blockage->getPin()->getFigs()) {
+      addFig(fig.get());
+    }
+  }
+  return ss.str();
+}
+
 void UniqueInsts::getPrefTrackPatterns(
     std::vector<frTrackPattern*>& prefTrackPatterns)
 {
@@ -176,9 +215,12 @@ void UniqueInsts::computeUnique(
   }
 
   for (auto& [master, orientMap] : masterOT2Insts_) {
+    const std::string masterDigest = getMasterDigest(master);
     for (auto& [orient, offsetMap] : orientMap) {
       for (auto& [vec, insts] : offsetMap) {
         auto uniqueInst = *(insts.begin());
+        idx2ClassKey_[unique_.size()]
+            = {master->getName(), masterDigest, orient.getValue(), vec};
         unique_.push_back(uniqueInst);
         for (auto i : insts) {
           inst2unique_[i] = uniqueInst;
@@ -317,4 +359,13 @@ frInst* UniqueInsts::getUnique(int idx) const
   return unique_[idx];
 }
 
+const UniqueInsts::ClassKey* UniqueInsts::getClassKey(int idx) const
+{
+  auto it = idx2ClassKey_.find(idx);
+  if (it == idx2ClassKey_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
 }  // namespace drt
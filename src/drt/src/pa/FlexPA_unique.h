@@ -44,6 +44,11 @@ namespace drt {
 class UniqueInsts
 {
  public:
+  // Master name, master geometry digest, orientation and track offsets
+  // shared by all the instances of a class.
+  using ClassKey
+      = std::tuple<std::string, std::string, int, std::vector<frCoord>>;
+
   // if target_insts is non-empty then analysis is limited to
   // those instances.
   UniqueInsts(frDesign* design,
@@ -62,6 +67,9 @@ class UniqueInsts
 
   const std::vector<frInst*>& getUnique() const;
   frInst* getUnique(int idx) const;
+  // Returns nullptr for instances that form a class of their own, such as
+  // NDR instances.
+  const ClassKey* getClassKey(int idx) const;
   bool hasUnique(frInst* inst) const;
 
   void report() const;
@@ -102,6 +110,8 @@ class UniqueInsts
   std::map<frInst*, int, frBlockObjectComp> unique2paidx_;
   // Maps a unique instance to its index in unique_
   std::map<frInst*, int, frBlockObjectComp> unique2Idx_;
+  // Maps an index in unique_ to its class key, if it has one
+  std::map<int, ClassKey> idx2ClassKey_;
   // master orient track-offset to instances
   std::map<frMaster*,
            std::map<dbOrientType,
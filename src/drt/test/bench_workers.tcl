@@ -0,0 +1,27 @@
+# Dumps the workers of the first detailed routing iteration and replays them
+# twice through detailed_route_bench_workers.  The stage timings change from
+# run to run, so only the number of workers and their markers are checked.
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+
+set dump_dir [make_result_file bench_workers]
+file delete -force $dump_dir
+file mkdir $dump_dir
+detailed_route_debug -dump_dr -dump_dir $dump_dir -iter 0
+detailed_route -output_drc results/bench_workers.output.drc.rpt \
+               -output_maze results/bench_workers.output.maze.log \
+               -verbose 0
+
+suppress_message DRT 623
+suppress_message DRT 624
+set markers1 [detailed_route_bench_workers -dump_dir $dump_dir]
+set markers2 [detailed_route_bench_workers -dump_dir $dump_dir]
+puts "Replayed workers: [llength $markers1]"
+if { $markers1 == $markers2 } {
+  puts "Both replays left the same markers."
+} else {
+  puts "The replays left different markers: $markers1 and $markers2"
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+#include "dr/FlexGridGraph.h"
+#include "fixture.h"
+
+namespace drt {
+
+// Fixture for FlexGridGraph tests on the m1 layer of the fixture tech
+struct GridGraphFixture : public Fixture
+{
+  GridGraphFixture() : graph(design->getTech(), logger.get(), nullptr)
+  {
+    FlexGridGraph::clearBufferPool();
+  }
+
+  ~GridGraphFixture() override { FlexGridGraph::clearBufferPool(); }
+
+  static void initGrids(FlexGridGraph& grid_graph,
+                        int x_cnt,
+                        int y_cnt,
+                        bool follow_guide)
+  {
+    std::map<frCoord, std::map<frLayerNum, frTrackPattern*>> x_map;
+    std::map<frCoord, std::map<frLayerNum, frTrackPattern*>> y_map;
+    for (int i = 0; i < x_cnt; i++) {
+      x_map[i * 200];
+    }
+    for (int i = 0; i < y_cnt; i++) {
+      y_map[i * 200];
+    }
+    const frLayerNum m1 = 2;
+    const std::map<frLayerNum, dbTechLayerDir> z_map{
+        {m1, dbTechLayerDir::HORIZONTAL}};
+    grid_graph.initGrids(x_map, y_map, z_map, follow_guide);
+  }
+
+  static void setPrevDir(FlexGridGraph& grid_graph,
+                         frMIdx x,
+                         frMIdx y,
+                         frDirEnum dir)
+  {
+    grid_graph.setPrevAstarNodeDir(x, y, 0, dir);
+  }
+
+  static frDirEnum getPrevDir(const FlexGridGraph& grid_graph,
+                              frMIdx x,
+                              frMIdx y)
+  {
+    return grid_graph.getPrevAstarNodeDir(FlexMazeIdx(x, y, 0));
+  }
+
+  static bool isSrc(const FlexGridGraph& grid_graph, frMIdx x, frMIdx y)
+  {
+    return grid_graph.isSrc(x, y, 0);
+  }
+
+  static bool isDst(const FlexGridGraph& grid_graph, frMIdx x, frMIdx y)
+  {
+    return grid_graph.isDst(x, y, 0);
+  }
+
+  static bool hasGuide(const FlexGridGraph& grid_graph, frMIdx x, frMIdx y)
+  {
+    return grid_graph.nodeStates_[grid_graph.getIdx(x, y, 0)]
+           & FlexGridGraph::guide_bit;
+  }
+
+  static const void* nodeBuffer(const FlexGridGraph& grid_graph)
+  {
+    return grid_graph.nodes_.data();
+  }
+
+  static const void* stateBuffer(const FlexGridGraph& grid_graph)
+  {
+    return grid_graph.nodeStates_.data();
+  }
+
+  // The search state of every node written by the tests below.  Node (x, y)
+  // gets a different previous direction and src/dst pattern per node.
+  static frDirEnum expectedDir(frMIdx x, frMIdx y)
+  {
+    return static_cast<frDirEnum>((x + 2 * y) % 7);
+  }
+  static bool expectedSrc(frMIdx x, frMIdx y) { return (x + y) % 2 == 0; }
+  static bool expectedDst(frMIdx x, frMIdx y) { return (x * y) % 3 == 0; }
+
+  void writeStates()
+  {
+    for (frMIdx x = 0; x < x_cnt; x++) {
+      for (frMIdx y = 0; y < y_cnt; y++) {
+        setPrevDir(graph, x, y, expectedDir(x, y));
+        if (expectedSrc(x, y)) {
+          graph.setSrc(x, y, 0);
+        }
+        if (expectedDst(x, y)) {
+          graph.setDst(x, y, 0);
+        }
+      }
+    }
+  }
+
+  static constexpr int x_cnt = 6;
+  static constexpr int y_cnt = 5;
+  FlexGridGraph graph;
+};
+
+BOOST_FIXTURE_TEST_SUITE(grid_graph, GridGraphFixture);
+
+// The previous direction, src, dst and guide share a byte per node and
+// must not overwrite each other.
+BOOST_AUTO_TEST_CASE(state_fields)
+{
+  initGrids(graph, x_cnt, y_cnt, /* follow_guide */ true);
+  graph.setGuide(1, 1, 3, 2, 0);
+  writeStates();
+
+  for (frMIdx x = 0; x < x_cnt; x++) {
+    for (frMIdx y = 0; y < y_cnt; y++) {
+      BOOST_TEST((getPrevDir(graph, x, y) == expectedDir(x, y)));
+      BOOST_TEST(isSrc(graph, x, y) == expectedSrc(x, y));
+      BOOST_TEST(isDst(graph, x, y) == expectedDst(x, y));
+      const bool in_guide = x >= 1 && x <= 3 && y >= 1 && y <= 2;
+      BOOST_TEST(hasGuide(graph, x, y) == in_guide);
+    }
+  }
+
+  // Each field is rewritten without touching the others.
+  setPrevDir(graph, 2, 1, frDirEnum::U);
+  graph.resetSrc(2, 1, 0);
+  graph.setDst(2, 1, 0);
+  BOOST_TEST((getPrevDir(graph, 2, 1) == frDirEnum::U));
+  BOOST_TEST(!isSrc(graph, 2, 1));
+  BOOST_TEST(isDst(graph, 2, 1));
+  BOOST_TEST(hasGuide(graph, 2, 1));
+  setPrevDir(graph, 2, 1, frDirEnum::UNKNOWN);
+  BOOST_TEST((getPrevDir(graph, 2, 1) == frDirEnum::UNKNOWN));
+  BOOST_TEST(isDst(graph, 2, 1));
+  BOOST_TEST(hasGuide(graph, 2, 1));
+}
+
+// The bulk resets clear only their own fields.
+BOOST_AUTO_TEST_CASE(state_resets)
+{
+  initGrids(graph, x_cnt, y_cnt, /* follow_guide */ false);
+  writeStates();
+
+  graph.resetSrc();
+  for (frMIdx x = 0; x < x_cnt; x++) {
+    for (frMIdx y = 0; y < y_cnt; y++) {
+      BOOST_TEST(!isSrc(graph, x, y));
+      BOOST_TEST(isDst(graph, x, y) == expectedDst(x, y));
+      BOOST_TEST((getPrevDir(graph, x, y) == expectedDir(x, y)));
+      BOOST_TEST(hasGuide(graph, x, y));
+    }
+  }
+
+  graph.resetPrevNodeDir();
+  for (frMIdx x = 0; x < x_cnt; x++) {
+    for (frMIdx y = 0; y < y_cnt; y++) {
+      BOOST_TEST((getPrevDir(graph, x, y) == frDirEnum::UNKNOWN));
+      BOOST_TEST(isDst(graph, x, y) == expectedDst(x, y));
+      BOOST_TEST(hasGuide(graph, x, y));
+    }
+  }
+
+  writeStates();
+  graph.resetStatus();
+  for (frMIdx x = 0; x < x_cnt; x++) {
+    for (frMIdx y = 0; y < y_cnt; y++) {
+      BOOST_TEST((getPrevDir(graph, x, y) == frDirEnum::UNKNOWN));
+      BOOST_TEST(!isSrc(graph, x, y));
+      BOOST_TEST(!isDst(graph, x, y));
+      BOOST_TEST(hasGuide(graph, x, y));
+    }
+  }
+}
+
+// A new grid takes over the buffers of a cleaned up one and starts from
+// cleared nodes and search state.
+BOOST_AUTO_TEST_CASE(buffer_reuse)
+{
+  initGrids(graph, x_cnt, y_cnt, /* follow_guide */ true);
+  graph.setGuide(0, 0, x_cnt - 1, y_cnt - 1, 0);
+  writeStates();
+  graph.setSVia(1, 1, 0);
+  const void* nodes = nodeBuffer(graph);
+  const void* states = stateBuffer(graph);
+  graph.cleanup();
+
+  FlexGridGraph next(design->getTech(), logger.get(), nullptr);
+  initGrids(next, x_cnt, y_cnt, /* follow_guide */ true);
+  BOOST_TEST(nodeBuffer(next) == nodes);
+  BOOST_TEST(stateBuffer(next) == states);
+  for (frMIdx x = 0; x < x_cnt; x++) {
+    for (frMIdx y = 0; y < y_cnt; y++) {
+      BOOST_TEST(!next.isSVia(x, y, 0));
+      BOOST_TEST((getPrevDir(next, x, y) == frDirEnum::UNKNOWN));
+      BOOST_TEST(!isSrc(next, x, y));
+      BOOST_TEST(!isDst(next, x, y));
+      BOOST_TEST(!hasGuide(next, x, y));
+    }
+  }
+
+  // A larger grid still gets nodes for every index.
+  next.cleanup();
+  FlexGridGraph larger(design->getTech(), logger.get(), nullptr);
+  initGrids(larger, 2 * x_cnt, 2 * y_cnt, /* follow_guide */ false);
+  frMIdx x_dim, y_dim, z_dim;
+  larger.getDim(x_dim, y_dim, z_dim);
+  BOOST_TEST(x_dim == 2 * x_cnt);
+  BOOST_TEST(y_dim == 2 * y_cnt);
+  BOOST_TEST(z_dim == 1);
+  for (frMIdx x = 0; x < x_dim; x++) {
+    for (frMIdx y = 0; y < y_dim; y++) {
+      BOOST_TEST(hasGuide(larger, x, y));
+      BOOST_TEST(!isSrc(larger, x, y));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace drt
@@ -0,0 +1,15 @@
+# Routing with several threads should give the same result as ispd18_sample,
+# which routes with one thread.
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+set_thread_count 4
+detailed_route -output_drc results/ispd18_sample_threads.output.drc.rpt \
+               -output_maze results/ispd18_sample_threads.output.maze.log \
+               -verbose 0
+
+set def_file [make_result_file ispd18_sample_threads.def]
+write_def $def_file
+diff_files ispd18_sample.defok $def_file
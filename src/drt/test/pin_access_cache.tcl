@@ -0,0 +1,31 @@
+# the second pin access run reuses the access points cached by the first
+source "helpers.tcl"
+read_lef "sky130hs/sky130hs.tlef"
+read_lef "sky130hs/sky130hs_std_cell.lef"
+read_def "top_level_term.def"
+
+proc access_points { } {
+  set block [ord::get_db_block]
+  set aps [list [llength [$block getAccessPoints]]]
+  foreach inst [$block getInsts] {
+    foreach iterm [$inst getITerms] {
+      foreach ap [$iterm getPrefAccessPoints] {
+        set pt [$ap getPoint]
+        lappend aps [list [$inst getName] [[$iterm getMTerm] getName] \
+                       [$pt getX] [$pt getY] [[$ap getLayer] getName]]
+      }
+    }
+  }
+  return $aps
+}
+
+pin_access -bottom_routing_layer met1 -top_routing_layer met5 -verbose 0
+set first [access_points]
+pin_access -bottom_routing_layer met1 -top_routing_layer met5 -verbose 0
+set second [access_points]
+
+if { [llength $first] > 1 && $first == $second } {
+  puts "Both runs found the same access points."
+} else {
+  puts "Access points differ between runs."
+}
@@ -1,14 +1,18 @@
 record_tests {
   ispd18_sample
+  ispd18_sample_threads
   ndr_vias1
   ndr_vias2
   obstruction
   single_step
+  single_step_eco
   ta_ap_aligned
   ta_pin_aligned
   top_level_term
   top_level_term2
   drc_test
+  bench_workers
+  pin_access_cache
   #drt_man_tcl_check
   #drt_readme_msgs_check
 }
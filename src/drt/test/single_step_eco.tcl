@@ -0,0 +1,32 @@
+# Reconnecting a routed pin in place marks its gcell dirty.  The next
+# search and repair iteration only makes the worker of that tile and leaves
+# the routing unchanged.
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+
+detailed_route -output_drc results/single_step_eco.output.drc.rpt \
+               -output_maze results/single_step_eco.output.maze.log \
+               -verbose 0 \
+               -single_step_dr
+
+drt::step_dr 7  0 3 8 0 8 0.95 1 true
+drt::step_dr 7 -2 3 8 8 8 0.95 1 true
+drt::step_dr 7 -5 3 8 8 8 0.95 1 true
+
+set iterm [[[ord::get_db_block] findInst inst4132] findITerm Y]
+set net [$iterm getNet]
+$iterm disconnect
+$iterm connect $net
+
+# One gcell per tile
+set_debug_level DRT workers 1
+drt::step_dr 1 0 3 8 8 8 0.95 0 true
+set_debug_level DRT workers 0
+drt::step_end
+
+set def_file [make_result_file single_step_eco.def]
+write_def $def_file
+diff_files ispd18_sample.defok $def_file
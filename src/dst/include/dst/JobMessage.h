@@ -103,6 +103,9 @@ class JobMessage
 
   static constexpr const char* EOP
       = "\r\nENDOFPACKET\r\n";  // ENDOFPACKET SEQUENCE
+  // Bumped whenever the serialized layout of a message changes so that a
+  // leader and workers from different builds reject each other's messages.
+  static constexpr int WIRE_VERSION = 1;
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
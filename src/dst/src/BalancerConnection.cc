@@ -30,8 +30,8 @@
 
 #include <dst/JobMessage.h>
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/serialization/export.hpp>
@@ -144,13 +144,7 @@ bool readMsg(dst::socket& sock, std::string& dataStr)
   }
 
   auto bufs = receive_buffer.data();
-  auto offset = asio::buffers_begin(bufs) + receive_buffer.size();
-  std::string result;
-  if (offset <= asio::buffers_end(bufs)) {
-    result = std::string(asio::buffers_begin(bufs), offset);
-  }
-
-  dataStr = result;
+  dataStr.assign(asio::buffers_begin(bufs), asio::buffers_end(bufs));
   return !dataStr.empty();
 }
 
@@ -28,11 +28,13 @@
 
 #include "dst/JobMessage.h"
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/unique_ptr.hpp>
-#include <sstream>
 
 #include "dst/BalancerJobDescription.h"
 
@@ -47,6 +49,12 @@ inline bool is_loading(const Archive& ar)
 template <class Archive>
 void JobMessage::serialize(Archive& ar, const unsigned int version)
 {
+  int wire_version = WIRE_VERSION;
+  (ar) & wire_version;
+  if (wire_version != WIRE_VERSION) {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::unsupported_version);
+  }
   (ar) & msg_type_;
   (ar) & job_type_;
   (ar) & desc_;
@@ -60,19 +68,25 @@ bool JobMessage::serializeMsg(SerializeType type,
                               JobMessage& msg,
                               std::string& str)
 {
+  // The archives write to and read from str directly.  Messages carry whole
+  // serialized workers, so copying them through a stringstream is costly.
+  namespace io = boost::iostreams;
   if (type == WRITE) {
     try {
-      std::ostringstream oarchive_stream;
-      boost::archive::text_oarchive archive(oarchive_stream);
-      archive << msg;
-      str = oarchive_stream.str();
+      str.clear();
+      io::stream<io::back_insert_device<std::string>> oarchive_stream(str);
+      {
+        boost::archive::binary_oarchive archive(oarchive_stream);
+        archive << msg;
+      }
+      oarchive_stream.flush();
     } catch (const boost::archive::archive_exception& e) {
       return false;
     }
   } else {
     try {
-      std::istringstream iarchive_stream(str);
-      boost::archive::text_iarchive archive(iarchive_stream);
+      io::stream<io::array_source> iarchive_stream(str.data(), str.size());
+      boost::archive::binary_iarchive archive(iarchive_stream);
       archive >> msg;
     } catch (const boost::archive::archive_exception& e) {
       return false;
@@ -1000,14 +1000,38 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
     gPin->clearWaVars();
   }
 
-#pragma omp parallel for num_threads(num_threads_)
-  for (auto gNet = gNetStor_.begin(); gNet < gNetStor_.end(); ++gNet) {
-    // old-style loop for old OpenMP
-
-    gNet->clearWaVars();
-    gNet->updateBox();
+#pragma omp parallel num_threads(num_threads_)
+  {
+    // Per thread structure-of-arrays copies of the pins of one net so the
+    // exponentials are computed in a loop the compiler can vectorize.
+    std::vector<int> pinX, pinY;
+    std::vector<float> argMinX, argMaxX, argMinY, argMaxY;
+    std::vector<float> expMinX, expMaxX, expMinY, expMaxY;
+
+#pragma omp for
+    for (auto gNet = gNetStor_.begin(); gNet < gNetStor_.end(); ++gNet) {
+      // old-style loop for old OpenMP
+
+      gNet->clearWaVars();
+      gNet->updateBox();
+
+      const auto& gPins = gNet->gPins();
+      const int numPins = gPins.size();
+      pinX.resize(numPins);
+      pinY.resize(numPins);
+      argMinX.resize(numPins);
+      argMaxX.resize(numPins);
+      argMinY.resize(numPins);
+      argMaxY.resize(numPins);
+      expMinX.resize(numPins);
+      expMaxX.resize(numPins);
+      expMinY.resize(numPins);
+      expMaxY.resize(numPins);
+      for (int i = 0; i < numPins; i++) {
+        pinX[i] = gPins[i]->cx();
+        pinY[i] = gPins[i]->cy();
+      }
 
-    for (auto& gPin : gNet->gPins()) {
       // The WA terms are shift invariant:
       //
       //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
@@ -1015,72 +1039,90 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       //   Sum(exp(x_i))          Sum(exp(x_i - C))
       //
       // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
-
-      // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
-        gNet->addWaExpMinSumX(gPin->minExpSumX());
-        gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumX());
-        }
+      const int lx = gNet->lx();
+      const int ux = gNet->ux();
+      const int ly = gNet->ly();
+      const int uy = gNet->uy();
+#pragma omp simd
+      for (int i = 0; i < numPins; i++) {
+        argMinX[i] = (lx - pinX[i]) * wlCoeffX;
+        argMaxX[i] = (pinX[i] - ux) * wlCoeffX;
+        argMinY[i] = (ly - pinY[i]) * wlCoeffY;
+        argMaxY[i] = (pinY[i] - uy) * wlCoeffY;
+        expMinX[i] = fastExp(argMinX[i]);
+        expMaxX[i] = fastExp(argMaxX[i]);
+        expMinY[i] = fastExp(argMinY[i]);
+        expMaxY[i] = fastExp(argMaxY[i]);
       }
 
-      // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
-        gNet->addWaExpMaxSumX(gPin->maxExpSumX());
-        gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumX());
+      // The exponentials of pins below the force bar are dropped here, and
+      // the net sums are accumulated in pin order as before.
+      const float bar = nbVars_.minWireLengthForceBar;
+      for (int i = 0; i < numPins; i++) {
+        GPin* gPin = gPins[i];
+
+        // min x
+        if (argMinX[i] > bar) {
+          gPin->setMinExpSumX(expMinX[i]);
+          gNet->addWaExpMinSumX(gPin->minExpSumX());
+          gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
+          if (gPin->gCell() && gPin->gCell()->isInstance()) {
+            debugPrint(log_,
+                       GPL,
+                       "wlUpdateWA",
+                       1,
+                       "MinX updated: {} {:g}",
+                       gPin->gCell()->instance()->dbInst()->getConstName(),
+                       gPin->minExpSumX());
+          }
         }
-      }
 
-      // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
-        gNet->addWaExpMinSumY(gPin->minExpSumY());
-        gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumY());
+        // max x
+        if (argMaxX[i] > bar) {
+          gPin->setMaxExpSumX(expMaxX[i]);
+          gNet->addWaExpMaxSumX(gPin->maxExpSumX());
+          gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
+          if (gPin->gCell() && gPin->gCell()->isInstance()) {
+            debugPrint(log_,
+                       GPL,
+                       "wlUpdateWA",
+                       1,
+                       "MaxX updated: {} {:g}",
+                       gPin->gCell()->instance()->dbInst()->getConstName(),
+                       gPin->maxExpSumX());
+          }
         }
-      }
 
-      // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
-        gNet->addWaExpMaxSumY(gPin->maxExpSumY());
-        gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumY());
+        // min y
+        if (argMinY[i] > bar) {
+          gPin->setMinExpSumY(expMinY[i]);
+          gNet->addWaExpMinSumY(gPin->minExpSumY());
+          gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
+          if (gPin->gCell() && gPin->gCell()->isInstance()) {
+            debugPrint(log_,
+                       GPL,
+                       "wlUpdateWA",
+                       1,
+                       "MinY updated: {} {:g}",
+                       gPin->gCell()->instance()->dbInst()->getConstName(),
+                       gPin->minExpSumY());
+          }
+        }
+
+        // max y
+        if (argMaxY[i] > bar) {
+          gPin->setMaxExpSumY(expMaxY[i]);
+          gNet->addWaExpMaxSumY(gPin->maxExpSumY());
+          gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
+          if (gPin->gCell() && gPin->gCell()->isInstance()) {
+            debugPrint(log_,
+                       GPL,
+                       "wlUpdateWA",
+                       1,
+                       "MaxY updated: {} {:g}",
+                       gPin->gCell()->instance()->dbInst()->getConstName(),
+                       gPin->maxExpSumY());
+          }
         }
       }
     }
@@ -173,6 +173,7 @@ class GlobalRouter : public ant::GlobalRouteSource
                            int layer,
                            float reduction_percentage);
   void setVerbose(const bool v);
+  void setNumThreads(int num_threads);
   void setOverflowIterations(int iterations);
   void setCongestionReportIterStep(int congestion_report_iter_step);
   void setCongestionReportFile(const char* file_name);
@@ -459,6 +460,7 @@ class GlobalRouter : public ant::GlobalRouteSource
   std::vector<RegionAdjustment> region_adjustments_;
 
   bool verbose_;
+  int num_threads_;
   int min_layer_for_clock_;
   int max_layer_for_clock_;
 
@@ -99,6 +99,7 @@ GlobalRouter::GlobalRouter()
       macro_extension_(0),
       initialized_(false),
       verbose_(false),
+      num_threads_(1),
       min_layer_for_clock_(-1),
       max_layer_for_clock_(-2),
       seed_(0),
@@ -321,6 +322,7 @@ void GlobalRouter::repairAntennas(odb::dbMTerm* diode_mterm,
                    diode_mterm->getConstName());
   }
 
+  repair_antennas_->clearCleanNets();
   bool violations = true;
   int itr = 0;
   while (violations && itr < iterations) {
@@ -328,7 +330,7 @@ void GlobalRouter::repairAntennas(odb::dbMTerm* diode_mterm,
       logger_->info(GRT, 6, "Repairing antennas, iteration {}.", itr + 1);
     }
     violations = repair_antennas_->checkAntennaViolations(
-        routes_, max_routing_layer_, diode_mterm, ratio_margin);
+        routes_, max_routing_layer_, diode_mterm, ratio_margin, num_threads_);
     if (violations) {
       IncrementalGRoute incr_groute(this, block_);
       repair_antennas_->repairAntennas(diode_mterm);
@@ -1446,6 +1448,11 @@ void GlobalRouter::setVerbose(const bool v)
   verbose_ = v;
 }
 
+void GlobalRouter::setNumThreads(int num_threads)
+{
+  num_threads_ = num_threads;
+}
+
 void GlobalRouter::setOverflowIterations(int iterations)
 {
   overflow_iterations_ = iterations;
@@ -1565,6 +1572,7 @@ void GlobalRouter::ensureLayerForGuideDimension(int max_routing_layer)
 void GlobalRouter::configFastRoute()
 {
   fastroute_->setVerbose(verbose_);
+  fastroute_->setNumThreads(num_threads_);
   fastroute_->setOverflowIterations(overflow_iterations_);
   fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
 
@@ -2371,6 +2379,9 @@ void GlobalRouter::mergeResults(NetRouteMap& routes)
     odb::dbNet* db_net = net_route.first;
     GRoute& route = net_route.second;
     routes_[db_net] = route;
+    if (repair_antennas_ != nullptr) {
+      repair_antennas_->routeChanged(db_net);
+    }
   }
 }
 
@@ -188,6 +188,7 @@ set_perturbation_amount(int perturbation)
 void
 global_route(bool start_incremental, bool end_incremental)
 {
+  getGlobalRouter()->setNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
   getGlobalRouter()->globalRoute(true, start_incremental, end_incremental);
 }
 
@@ -206,6 +207,7 @@ route_layer_lengths(odb::dbNet* db_net)
 void
 repair_antennas(odb::dbMTerm* diode_mterm, int iterations, float ratio_margin)
 {
+  getGlobalRouter()->setNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
   getGlobalRouter()->repairAntennas(diode_mterm, iterations, ratio_margin);
 }
 
@@ -46,6 +46,7 @@
 #include "Pin.h"
 #include "grt/GlobalRouter.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -70,23 +71,57 @@ RepairAntennas::RepairAntennas(GlobalRouter* grouter,
 bool RepairAntennas::checkAntennaViolations(NetRouteMap& routing,
                                             int max_routing_layer,
                                             odb::dbMTerm* diode_mterm,
-                                            float ratio_margin)
+                                            float ratio_margin,
+                                            int num_threads)
 {
   makeNetWires(routing, max_routing_layer);
   arc_->initAntennaRules();
+
+  // Nets found clean in a previous iteration and not rerouted since cannot
+  // have new violations, so only the other nets are checked.
+  std::vector<odb::dbNet*> nets;
   for (auto& [db_net, route] : routing) {
-    if (db_net->getWire()) {
-      std::vector<ant::Violation> net_violations
-          = arc_->getAntennaViolations(db_net, diode_mterm, ratio_margin);
-      if (!net_violations.empty()) {
-        antenna_violations_[db_net] = std::move(net_violations);
-        debugPrint(logger_,
-                   GRT,
-                   "repair_antennas",
-                   1,
-                   "antenna violations {}",
-                   db_net->getConstName());
-      }
+    if (db_net->getWire() == nullptr) {
+      continue;
+    }
+    if (clean_nets_.find(db_net) != clean_nets_.end()) {
+      continue;
+    }
+    nets.push_back(db_net);
+  }
+  debugPrint(logger_,
+             GRT,
+             "repair_antennas",
+             1,
+             "checking {} of {} nets",
+             nets.size(),
+             routing.size());
+
+  std::vector<std::vector<ant::Violation>> nets_violations(nets.size());
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+  for (int i = 0; i < nets.size(); i++) {
+    try {
+      nets_violations[i]
+          = arc_->getAntennaViolations(nets[i], diode_mterm, ratio_margin);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (int i = 0; i < nets.size(); i++) {
+    odb::dbNet* db_net = nets[i];
+    if (nets_violations[i].empty()) {
+      clean_nets_.insert(db_net);
+    } else {
+      antenna_violations_[db_net] = std::move(nets_violations[i]);
+      debugPrint(logger_,
+                 GRT,
+                 "repair_antennas",
+                 1,
+                 "antenna violations {}",
+                 db_net->getConstName());
     }
   }
   destroyNetWires();
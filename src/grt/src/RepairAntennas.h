@@ -39,6 +39,7 @@
 #include <boost/geometry/index/rtree.hpp>
 #include <boost/iterator/function_output_iterator.hpp>
 #include <string>
+#include <unordered_set>
 
 #include "ant/AntennaChecker.hh"
 #include "dpl/Opendp.h"
@@ -94,7 +95,8 @@ class RepairAntennas
   bool checkAntennaViolations(NetRouteMap& routing,
                               int max_routing_layer,
                               odb::dbMTerm* diode_mterm,
-                              float ratio_margin);
+                              float ratio_margin,
+                              int num_threads);
   void repairAntennas(odb::dbMTerm* diode_mterm);
   int illegalDiodePlacementCount() const
   {
@@ -108,6 +110,9 @@ class RepairAntennas
   }
   int getDiodesCount() { return diode_insts_.size(); }
   void clearViolations() { antenna_violations_.clear(); }
+  void clearCleanNets() { clean_nets_.clear(); }
+  // the net has to be checked again by the next checkAntennaViolations
+  void routeChanged(odb::dbNet* net) { clean_nets_.erase(net); }
   void makeNetWires(NetRouteMap& routing, int max_routing_layer);
   void destroyNetWires();
   odb::dbMTerm* findDiodeMTerm();
@@ -189,6 +194,8 @@ class RepairAntennas
   odb::dbBlock* block_;
   std::vector<odb::dbInst*> diode_insts_;
   AntennaViolations antenna_violations_;
+  // nets without violations that were not rerouted since they were checked
+  std::unordered_set<odb::dbNet*> clean_nets_;
   int unique_diode_index_;
   int illegal_diode_placement_count_;
 };
@@ -93,6 +93,44 @@ struct DebugSetting
 
 using stt::Tree;
 
+// Scratch state of the 2D maze router. Each thread routing nets concurrently
+// in mazeRouteMSMD owns one workspace, so nets with disjoint routing regions
+// never share heaps, distance grids or back-tracking information.
+// The grids only cover the routing region of the current net and are indexed
+// with gcell coordinates through setRegion.
+struct MazeWorkspace
+{
+  // size the grids for regions of up to width x height gcells
+  void init(int width, int height);
+  // map the grids onto region, which must fit in the size given to init
+  void setRegion(const odb::Rect& region);
+
+  multi_array<float, 2> d1;
+  multi_array<float, 2> d2;
+  multi_array<short, 2> parent_x1;
+  multi_array<short, 2> parent_y1;
+  multi_array<short, 2> parent_x3;
+  multi_array<short, 2> parent_y3;
+  multi_array<bool, 2> hv;
+  multi_array<bool, 2> hyper_v;
+  multi_array<bool, 2> hyper_h;
+  multi_array<bool, 2> in_region;
+  multi_array<int, 2> corr_edge;
+  std::vector<float*> src_heap;
+  std::vector<float*> dest_heap;
+  std::vector<bool> pop_heap2;
+  std::vector<OrderNetEdge> net_eo;
+  // gcells whose usage was incremented, merged into h/v_used_ggrid_ by the
+  // calling thread
+  std::vector<std::pair<int, int>> h_used_ggrid;
+  std::vector<std::pair<int, int>> v_used_ggrid;
+  // enlarge value of the last edge routed, -1 if no edge was routed
+  int last_enlarge = -1;
+  // gcell mapped to the first element of the grids
+  int origin_x = 0;
+  int origin_y = 0;
+};
+
 class FastRouteCore
 {
  public:
@@ -184,6 +222,7 @@ class FastRouteCore
   void incrementEdge3DUsage(int x1, int y1, int x2, int y2, int layer);
   void setMaxNetDegree(int);
   void setVerbose(bool v);
+  void setNumThreads(int num_threads) { num_threads_ = num_threads; }
   void setCriticalNetsPercentage(float u);
   float getCriticalNetsPercentage() { return critical_nets_percentage_; };
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
@@ -252,6 +291,34 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteMSMDNet(const int netID,
+                        const int iter,
+                        const int expand,
+                        const int ripup_threshold,
+                        const int maze_edge_threshold,
+                        const float cost_height,
+                        const int cost_type,
+                        const float logis_cof,
+                        const int via,
+                        const int slope,
+                        const int L,
+                        const float slack_th,
+                        const odb::Rect& allowed_region,
+                        MazeWorkspace& ws);
+  void mazeRouteMSMDParallel(const std::vector<int>& net_order,
+                             const std::vector<odb::Rect>& regions,
+                             const int iter,
+                             const int expand,
+                             const int ripup_threshold,
+                             const int maze_edge_threshold,
+                             const float cost_height,
+                             const int cost_type,
+                             const float logis_cof,
+                             const int via,
+                             const int slope,
+                             const int L,
+                             const float slack_th);
+  odb::Rect mazeNetRegion(const int netID, const int iter, const int expand);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -288,10 +355,7 @@ class FastRouteCore
   void convertToMazerouteNet(const int netID);
   void setupHeap(const int netID,
                  const int edgeID,
-                 std::vector<float*>& src_heap,
-                 std::vector<float*>& dest_heap,
-                 multi_array<float, 2>& d1,
-                 multi_array<float, 2>& d2,
+                 MazeWorkspace& ws,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -499,7 +563,7 @@ class FastRouteCore
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -558,6 +622,7 @@ class FastRouteCore
   bool has_2D_overflow_;
   int grid_hv_;
   bool verbose_;
+  int num_threads_;
   float critical_nets_percentage_;
   int via_cost_;
   int mazeedge_threshold_;
@@ -587,7 +652,6 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -602,15 +666,8 @@ class FastRouteCore
   multi_array<Edge, 2> h_edges_;       // The way it is indexed is (Y, X)
   multi_array<Edge3D, 3> h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
   multi_array<Edge3D, 3> v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<int, 2> corr_edge_;
-  multi_array<short, 2> parent_x1_;
-  multi_array<short, 2> parent_y1_;
-  multi_array<short, 2> parent_x3_;
-  multi_array<short, 2> parent_y3_;
-  multi_array<bool, 2> hv_;
-  multi_array<bool, 2> hyper_v_;
-  multi_array<bool, 2> hyper_h_;
   multi_array<bool, 2> in_region_;
+  std::vector<MazeWorkspace> maze_workspaces_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
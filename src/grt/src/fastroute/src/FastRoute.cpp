@@ -75,6 +75,7 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       has_2D_overflow_(false),
       grid_hv_(0),
       verbose_(false),
+      num_threads_(1),
       critical_nets_percentage_(10),
       via_cost_(0),
       mazeedge_threshold_(0),
@@ -118,23 +119,12 @@ void FastRouteCore::clear()
   h_edges_3D_.resize(boost::extents[0][0][0]);
   v_edges_3D_.resize(boost::extents[0][0][0]);
 
-  parent_x1_.resize(boost::extents[0][0]);
-  parent_y1_.resize(boost::extents[0][0]);
-  parent_x3_.resize(boost::extents[0][0]);
-  parent_y3_.resize(boost::extents[0][0]);
-
-  net_eo_.clear();
-
   xcor_.clear();
   ycor_.clear();
   dcor_.clear();
 
-  hv_.resize(boost::extents[0][0]);
-  hyper_v_.resize(boost::extents[0][0]);
-  hyper_h_.resize(boost::extents[0][0]);
-  corr_edge_.resize(boost::extents[0][0]);
-
   in_region_.resize(boost::extents[0][0]);
+  maze_workspaces_.clear();
 
   v_capacity_3D_.clear();
   h_capacity_3D_.clear();
@@ -194,11 +184,6 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
     last_row_h_capacity_3D_[i] = 0;
   }
 
-  hv_.resize(boost::extents[y_range_][x_range_]);
-  hyper_v_.resize(boost::extents[y_range_][x_range_]);
-  hyper_h_.resize(boost::extents[y_range_][x_range_]);
-  corr_edge_.resize(boost::extents[y_range_][x_range_]);
-
   in_region_.resize(boost::extents[y_range_][x_range_]);
 
   cost_hvh_.resize(x_range_);  // Horizontal first Z
@@ -647,11 +632,6 @@ void FastRouteCore::initAuxVar()
   initNetAuxVars();
 
   grid_hv_ = x_range_ * y_range_;
-
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
 }
 
 void FastRouteCore::initNetAuxVars()
@@ -953,7 +933,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1372,7 +1351,7 @@ NetRouteMap FastRouteCore::run()
   }
 
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
+  maze_workspaces_.clear();
   net_ids_.clear();
   return routes;
 }
@@ -30,11 +30,15 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <array>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -519,6 +523,61 @@ void FastRouteCore::convertToMazeroute()
   check2DEdgesUsage();
 }
 
+template <typename T>
+static void resizeGrid(multi_array<T, 2>& grid,
+                       const int width,
+                       const int height)
+{
+  grid.reindex(0);
+  grid.resize(boost::extents[height][width]);
+}
+
+template <typename T>
+static void setGridOrigin(multi_array<T, 2>& grid, const int x, const int y)
+{
+  const std::array<boost::multi_array_types::index, 2> bases{y, x};
+  grid.reindex(bases);
+}
+
+void MazeWorkspace::init(const int width, const int height)
+{
+  if (d1.shape()[0] == height && d1.shape()[1] == width) {
+    return;
+  }
+  resizeGrid(d1, width, height);
+  resizeGrid(d2, width, height);
+  resizeGrid(parent_x1, width, height);
+  resizeGrid(parent_y1, width, height);
+  resizeGrid(parent_x3, width, height);
+  resizeGrid(parent_y3, width, height);
+  resizeGrid(hv, width, height);
+  resizeGrid(hyper_v, width, height);
+  resizeGrid(hyper_h, width, height);
+  resizeGrid(in_region, width, height);
+  std::fill_n(in_region.data(), in_region.num_elements(), false);
+  resizeGrid(corr_edge, width, height);
+  pop_heap2.assign(width * height, false);
+  origin_x = 0;
+  origin_y = 0;
+}
+
+void MazeWorkspace::setRegion(const odb::Rect& region)
+{
+  origin_x = region.xMin();
+  origin_y = region.yMin();
+  setGridOrigin(d1, origin_x, origin_y);
+  setGridOrigin(d2, origin_x, origin_y);
+  setGridOrigin(parent_x1, origin_x, origin_y);
+  setGridOrigin(parent_y1, origin_x, origin_y);
+  setGridOrigin(parent_x3, origin_x, origin_y);
+  setGridOrigin(parent_y3, origin_x, origin_y);
+  setGridOrigin(hv, origin_x, origin_y);
+  setGridOrigin(hyper_v, origin_x, origin_y);
+  setGridOrigin(hyper_h, origin_x, origin_y);
+  setGridOrigin(in_region, origin_x, origin_y);
+  setGridOrigin(corr_edge, origin_x, origin_y);
+}
+
 // non recursive version of heapify
 static void heapify(std::vector<float*>& array)
 {
@@ -730,18 +789,22 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 // dest_heap - the heap storing the addresses for d2
 void FastRouteCore::setupHeap(const int netID,
                               const int edgeID,
-                              std::vector<float*>& src_heap,
-                              std::vector<float*>& dest_heap,
-                              multi_array<float, 2>& d1,
-                              multi_array<float, 2>& d2,
+                              MazeWorkspace& ws,
                               const int regionX1,
                               const int regionX2,
                               const int regionY1,
                               const int regionY2)
 {
+  std::vector<float*>& src_heap = ws.src_heap;
+  std::vector<float*>& dest_heap = ws.dest_heap;
+  multi_array<float, 2>& d1 = ws.d1;
+  multi_array<float, 2>& d2 = ws.d2;
+  multi_array<bool, 2>& in_region = ws.in_region;
+  multi_array<int, 2>& corr_edge = ws.corr_edge;
+
   for (int i = regionY1; i <= regionY2; i++) {
     for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
+      in_region[i][j] = true;
   }
 
   const auto& treeedges = sttrees_[netID].edges;
@@ -808,12 +871,12 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into src_heap if in enlarged region
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region[nbr_node.y][nbr_node.x]) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d1[nbrY][nbrX] = 0;
             src_heap.push_back(&d1[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            corr_edge[nbrY][nbrX] = edge;
           }
           const Route* route = &(treeedges[edge].route);
           if (route->type != RouteType::MazeRoute) {
@@ -825,10 +888,10 @@ void FastRouteCore::setupHeap(const int netID,
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
 
-            if (in_region_[y_grid][x_grid]) {
+            if (in_region[y_grid][x_grid]) {
               d1[y_grid][x_grid] = 0;
               src_heap.push_back(&d1[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if not a degraded edge (len>0)
@@ -878,12 +941,12 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into dest_heap
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region[nbr_node.y][nbr_node.x]) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d2[nbrY][nbrX] = 0;
             dest_heap.push_back(&d2[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            corr_edge[nbrY][nbrX] = edge;
           }
 
           const Route* route = &(treeedges[edge].route);
@@ -895,10 +958,10 @@ void FastRouteCore::setupHeap(const int netID,
           for (int j = 1; j < route->routelen; j++) {
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
-            if (in_region_[y_grid][x_grid]) {
+            if (in_region[y_grid][x_grid]) {
               d2[y_grid][x_grid] = 0;
               dest_heap.push_back(&d2[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if the edge is not degraded (len>0)
@@ -912,7 +975,7 @@ void FastRouteCore::setupHeap(const int netID,
 
   for (int i = regionY1; i <= regionY2; i++) {
     for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
+      in_region[i][j] = false;
   }
 }
 
@@ -1317,8 +1380,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
                                   float& slack_th)
 {
   // maze routing for multi-source, multi-destination
-  int tmpX, tmpY;
-
   const int max_usage_multiplier = 40;
 
   // allocate memory for distance and parent and pop_heap
@@ -1334,11 +1395,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
         = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
   if (ordering) {
     if (critical_nets_percentage_) {
       slack_th = CalculatePartialSlack();
@@ -1346,787 +1402,1041 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
     StNetOrder();
   }
 
-  std::vector<float*> src_heap;
-  std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
-
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
-
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
-
+  std::vector<int> net_order(net_ids_.size());
   for (int nidRPC = 0; nidRPC < net_ids_.size(); nidRPC++) {
-    const int netID
+    net_order[nidRPC]
         = ordering ? tree_order_cong_[nidRPC].treeIndex : net_ids_[nidRPC];
+  }
 
-    const int num_terminals = sttrees_[netID].num_terminals;
+  // The serial flow searches the full grid. The parallel flow limits each
+  // net to its region so that nets of the same level can be routed together.
+  const odb::Rect grid_region(0, 0, x_grid_ - 1, y_grid_ - 1);
+  std::vector<odb::Rect> regions(net_order.size(), grid_region);
+  int max_width = x_grid_;
+  int max_height = y_grid_;
+  if (num_threads_ > 1) {
+    max_width = 1;
+    max_height = 1;
+    for (int i = 0; i < net_order.size(); i++) {
+      regions[i] = mazeNetRegion(net_order[i], iter, expand);
+      max_width = std::max(max_width, regions[i].dx() + 1);
+      max_height = std::max(max_height, regions[i].dy() + 1);
+    }
+  }
+
+  const int num_workspaces = std::max(num_threads_, 1);
+  if (maze_workspaces_.size() != num_workspaces) {
+    maze_workspaces_.resize(num_workspaces);
+  }
+  for (MazeWorkspace& ws : maze_workspaces_) {
+    ws.init(max_width, max_height);
+  }
+
+  if (num_threads_ > 1) {
+    mazeRouteMSMDParallel(net_order,
+                          regions,
+                          iter,
+                          expand,
+                          ripup_threshold,
+                          maze_edge_threshold,
+                          cost_height,
+                          cost_type,
+                          logis_cof,
+                          via,
+                          slope,
+                          L,
+                          slack_th);
+  } else {
+    MazeWorkspace& ws = maze_workspaces_[0];
+    ws.last_enlarge = -1;
+    ws.setRegion(grid_region);
+    for (const int netID : net_order) {
+      while (!mazeRouteMSMDNet(netID,
+                               iter,
+                               expand,
+                               ripup_threshold,
+                               maze_edge_threshold,
+                               cost_height,
+                               cost_type,
+                               logis_cof,
+                               via,
+                               slope,
+                               L,
+                               slack_th,
+                               grid_region,
+                               ws)) {
+        reInitTree(netID);
+      }
+    }
+    h_used_ggrid_.insert(ws.h_used_ggrid.begin(), ws.h_used_ggrid.end());
+    v_used_ggrid_.insert(ws.v_used_ggrid.begin(), ws.v_used_ggrid.end());
+    ws.h_used_ggrid.clear();
+    ws.v_used_ggrid.clear();
+    if (ws.last_enlarge >= 0) {
+      enlarge_ = ws.last_enlarge;
+    }
+  }
 
-    const int origENG = expand;
+  h_cost_table_.clear();
+  v_cost_table_.clear();
+}
 
-    netedgeOrderDec(netID);
+// Returns the gcells that the maze routing of a net can read or modify in the
+// current iteration: its current tree and routes, enlarged by the expansion
+// applied to each of its edges.
+odb::Rect FastRouteCore::mazeNetRegion(const int netID,
+                                       const int iter,
+                                       const int expand)
+{
+  const auto& treenodes = sttrees_[netID].nodes;
+  const auto& treeedges = sttrees_[netID].edges;
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
+  odb::Rect region;
+  region.mergeInit();
+  for (const TreeEdge& treeedge : treeedges) {
+    const TreeNode& node1 = treenodes[treeedge.n1];
+    const TreeNode& node2 = treenodes[treeedge.n2];
+    const int enlarge
+        = std::min(expand, (iter / 6 + 3) * treeedge.route.routelen);
+    odb::Rect edge_region;
+    odb::Rect(node1.x, node1.y, node2.x, node2.y).bloat(enlarge, edge_region);
+    region.merge(edge_region);
+    for (int i = 0; i < treeedge.route.gridsX.size(); i++) {
+      const int x = treeedge.route.gridsX[i];
+      const int y = treeedge.route.gridsY[i];
+      region.merge(odb::Rect(x, y, x, y));
+    }
+  }
+  for (const TreeNode& node : treenodes) {
+    region.merge(odb::Rect(node.x, node.y, node.x, node.y));
+  }
+
+  return odb::Rect(std::max(region.xMin(), 0),
+                   std::max(region.yMin(), 0),
+                   std::min(region.xMax(), x_grid_ - 1),
+                   std::min(region.yMax(), y_grid_ - 1));
+}
+
+void FastRouteCore::mazeRouteMSMDParallel(
+    const std::vector<int>& net_order,
+    const std::vector<odb::Rect>& regions,
+    const int iter,
+    const int expand,
+    const int ripup_threshold,
+    const int maze_edge_threshold,
+    const float cost_height,
+    const int cost_type,
+    const float logis_cof,
+    const int via,
+    const int slope,
+    const int L,
+    const float slack_th)
+{
+  // Every net gets a level one above the highest level of the preceding nets
+  // whose regions overlap its own. Nets in the same level touch disjoint
+  // edges and are routed concurrently, and the levels are routed in order,
+  // so each net sees the same edge usage for any number of threads.
+  const int tile = std::max(1, std::max(x_grid_, y_grid_) / 256);
+  const int tiles_x = (x_grid_ + tile - 1) / tile;
+  const int tiles_y = (y_grid_ + tile - 1) / tile;
+  std::vector<int> tile_level(tiles_x * tiles_y, -1);
+
+  std::vector<std::vector<int>> levels;
+  for (int i = 0; i < net_order.size(); i++) {
+    const int tx1 = regions[i].xMin() / tile;
+    const int tx2 = regions[i].xMax() / tile;
+    const int ty1 = regions[i].yMin() / tile;
+    const int ty2 = regions[i].yMax() / tile;
+
+    int level = 0;
+    for (int ty = ty1; ty <= ty2; ty++) {
+      for (int tx = tx1; tx <= tx2; tx++) {
+        level = std::max(level, tile_level[ty * tiles_x + tx] + 1);
+      }
+    }
+    for (int ty = ty1; ty <= ty2; ty++) {
+      for (int tx = tx1; tx <= tx2; tx++) {
+        tile_level[ty * tiles_x + tx] = level;
+      }
+    }
+
+    if (level >= levels.size()) {
+      levels.resize(level + 1);
+    }
+    levels[level].push_back(i);
+  }
+
+  std::vector<int> last_enlarge(net_order.size(), -1);
+  utl::ThreadException exception;
+  for (const std::vector<int>& level : levels) {
+    std::vector<char> failed(level.size(), false);
+
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+    for (int j = 0; j < level.size(); j++) {
+      try {
+        MazeWorkspace& ws = maze_workspaces_[omp_get_thread_num()];
+        const int idx = level[j];
+        ws.last_enlarge = -1;
+        ws.setRegion(regions[idx]);
+        failed[j] = !mazeRouteMSMDNet(net_order[idx],
+                                      iter,
+                                      expand,
+                                      ripup_threshold,
+                                      maze_edge_threshold,
+                                      cost_height,
+                                      cost_type,
+                                      logis_cof,
+                                      via,
+                                      slope,
+                                      L,
+                                      slack_th,
+                                      regions[idx],
+                                      ws);
+        last_enlarge[idx] = ws.last_enlarge;
+      } catch (...) {
+        exception.capture();
       }
+    }
+    exception.rethrow();
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
-
-      if (!enter) {
+    // nets whose tree could not be updated are rebuilt and routed again in
+    // order, as in the serial flow
+    MazeWorkspace& ws = maze_workspaces_[0];
+    for (int j = 0; j < level.size(); j++) {
+      if (!failed[j]) {
         continue;
       }
+      const int idx = level[j];
+      const int netID = net_order[idx];
+      ws.setRegion(regions[idx]);
+      do {
+        reInitTree(netID);
+        ws.last_enlarge = -1;
+      } while (!mazeRouteMSMDNet(netID,
+                                 iter,
+                                 expand,
+                                 ripup_threshold,
+                                 maze_edge_threshold,
+                                 cost_height,
+                                 cost_type,
+                                 logis_cof,
+                                 via,
+                                 slope,
+                                 L,
+                                 slack_th,
+                                 regions[idx],
+                                 ws));
+      if (ws.last_enlarge >= 0) {
+        last_enlarge[idx] = ws.last_enlarge;
+      }
+    }
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+    for (MazeWorkspace& thread_ws : maze_workspaces_) {
+      h_used_ggrid_.insert(thread_ws.h_used_ggrid.begin(),
+                           thread_ws.h_used_ggrid.end());
+      v_used_ggrid_.insert(thread_ws.v_used_ggrid.begin(),
+                           thread_ws.v_used_ggrid.end());
+      thread_ws.h_used_ggrid.clear();
+      thread_ws.v_used_ggrid.clear();
+    }
+  }
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+  // keep the enlarge of the last routed edge in net order, as the serial
+  // flow does
+  for (auto it = last_enlarge.rbegin(); it != last_enlarge.rend(); it++) {
+    if (*it >= 0) {
+      enlarge_ = *it;
+      break;
+    }
+  }
+}
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+bool FastRouteCore::mazeRouteMSMDNet(const int netID,
+                                     const int iter,
+                                     const int expand,
+                                     const int ripup_threshold,
+                                     const int maze_edge_threshold,
+                                     const float cost_height,
+                                     const int cost_type,
+                                     const float logis_cof,
+                                     const int via,
+                                     const int slope,
+                                     const int L,
+                                     const float slack_th,
+                                     const odb::Rect& allowed_region,
+                                     MazeWorkspace& ws)
+{
+  int tmpX, tmpY;
 
-      int decrease = 0;
+  multi_array<float, 2>& d1 = ws.d1;
+  multi_array<float, 2>& d2 = ws.d2;
+  multi_array<short, 2>& parent_x1 = ws.parent_x1;
+  multi_array<short, 2>& parent_y1 = ws.parent_y1;
+  multi_array<short, 2>& parent_x3 = ws.parent_x3;
+  multi_array<short, 2>& parent_y3 = ws.parent_y3;
+  multi_array<bool, 2>& hv = ws.hv;
+  multi_array<bool, 2>& hyper_v = ws.hyper_v;
+  multi_array<bool, 2>& hyper_h = ws.hyper_h;
+  multi_array<int, 2>& corr_edge = ws.corr_edge;
+  std::vector<float*>& src_heap = ws.src_heap;
+  std::vector<float*>& dest_heap = ws.dest_heap;
+  std::vector<bool>& pop_heap2 = ws.pop_heap2;
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
-        }
+  const int num_terminals = sttrees_[netID].num_terminals;
+
+  const int origENG = expand;
+
+  netedgeOrderDec(netID, ws.net_eo);
+
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = ws.net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
+      continue;
+    }
+
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
+
+    if (!enter) {
+      continue;
+    }
+
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    const int enlarge
+        = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+    ws.last_enlarge = enlarge;
+
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    const int regionX1
+        = std::max(xmin - enlarge + decrease, allowed_region.xMin());
+    const int regionX2
+        = std::min(xmax + enlarge - decrease, allowed_region.xMax());
+    const int regionY1
+        = std::max(ymin - enlarge + decrease, allowed_region.yMin());
+    const int regionY2
+        = std::min(ymax + enlarge - decrease, allowed_region.yMax());
+
+    // initialize d1[][] and d2[][] as BIG_INT
+    for (int i = regionY1; i <= regionY2; i++) {
+      for (int j = regionX1; j <= regionX2; j++) {
+        d1[i][j] = BIG_INT;
+        d2[i][j] = BIG_INT;
+        hyper_h[i][j] = false;
+        hyper_v[i][j] = false;
       }
+    }
 
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+    // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
+    // grids on the two subtrees
+    setupHeap(netID, edgeID, ws, regionX1, regionX2, regionY1, regionY2);
+
+    // while loop to find shortest path
+    const int grid_width = d1.shape()[1];
+    int ind1 = (src_heap[0] - d1.data());
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - d2.data())] = true;
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = ws.origin_x + ind1 % grid_width;
+      const int curY = ws.origin_y + ind1 / grid_width;
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv[curY][curX]) {
+          preX = parent_x1[curY][curX];
+          preY = parent_y1[curY][curX];
         } else {
-          preX = curX;
-          preY = curY;
+          preX = parent_x3[curY][curX];
+          preY = parent_y3[curY][curX];
         }
+      } else {
+        preX = curX;
+        preY = curY;
+      }
 
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      removeMin(src_heap);
+
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX - 1].usage_red()
+                         + L * h_edges_[curY][(curX - 1)].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_[curY][curX].usage_red()
+                             + L * h_edges_[curY][curX].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY][curX + 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // right
-        if (curX < regionX2) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+        tmpX = curX - 1;  // the left neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // left neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          float* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
+      // right
+      if (curX < regionX2) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX].usage_red()
+                         + L * h_edges_[curY][curX].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_[curY][curX - 1].usage_red()
+                             + L * h_edges_[curY][curX - 1].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY][curX - 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX + 1;  // the right neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // right neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          float* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
         }
-        // bottom
-        if (curY > regionY1) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // bottom
+      if (curY > regionY1) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY - 1][curX].usage_red()
+                         + L * v_edges_[curY - 1][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_[curY][curX].usage_red()
+                             + L * v_edges_[curY][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY + 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpY = curY - 1;  // the bottom neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          float* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
         }
-        // top
-        if (curY < regionY2) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // top
+      if (curY < regionY2) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY][curX].usage_red()
+                         + L * v_edges_[curY][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_[curY - 1][curX].usage_red()
+                             + L * v_edges_[curY - 1][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY - 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpY = curY + 1;  // the top neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // top neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          float* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
         }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = (src_heap[0] - d1.data());
 
-      }  // while loop
+    }  // while loop
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - d2.data())] = false;
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = ws.origin_x + ind1 % grid_width;
+    const int crossY = ws.origin_y + ind1 / grid_width;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv[tmpY][tmpX]) {
+          curY = parent_y1[tmpY][tmpX];
+        } else {
+          curX = parent_x3[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
-        // split neighbor edge and return id new node
-        n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
+
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
+      // split neighbor edge and return id new node
+      n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    }
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
       }
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          151,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            151,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
-        // split neighbor edge and return id new node
-        n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    // (2) consider subtree2
+    if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
+      // split neighbor edge and return id new node
+      n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    }
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
       }
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          152,
+                          "Net {} has errors during updateRouteType1.",
+                          nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            152,
-                            "Net {} has errors during updateRouteType1.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          153,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            153,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-      }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
-      }
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-        }
+    int edgeCost = nets_[netID]->getEdgeCost();
+
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[min_y][gridsX[i]].usage += edgeCost;
+        ws.v_used_ggrid.emplace_back(min_y, gridsX[i]);
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][min_x].usage += edgeCost;
+        ws.h_used_ggrid.emplace_back(gridsY[i], min_x);
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+  }  // loop edgeID
 
-  h_cost_table_.clear();
-  v_cost_table_.clear();
+  return true;
 }
 
 void FastRouteCore::findCongestedEdgesNets(
@@ -0,0 +1,29 @@
+# check that serial maze routing keeps its guides and that parallel maze
+# routing gives the same guides on every run
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set guide_file1 [make_result_file maze_threads1.guide]
+set guide_file2 [make_result_file maze_threads2.guide]
+set guide_file3 [make_result_file maze_threads3.guide]
+
+set_global_routing_layer_adjustment metal2 0.9
+set_global_routing_layer_adjustment metal3 0.9
+set_global_routing_layer_adjustment metal4-metal10 1
+
+set_routing_layers -signal metal2-metal10
+
+set_thread_count 1
+global_route -allow_congestion
+write_guides $guide_file1
+diff_files congestion1.guideok $guide_file1
+
+set_thread_count 4
+global_route -allow_congestion
+write_guides $guide_file2
+
+global_route -allow_congestion
+write_guides $guide_file3
+
+diff_files $guide_file2 $guide_file3
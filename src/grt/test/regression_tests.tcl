@@ -22,6 +22,7 @@ record_tests {
   invalid_routing_layer
   invalid_pin_placement
   macro_obs_not_aligned
+  maze_threads
   modeling_instance_obs
   multiple_calls
   ndr_1w_3s
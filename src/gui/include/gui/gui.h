@@ -608,6 +608,11 @@ class Gui
   void centerAt(const odb::Point& focus_dbu);
   void setResolution(double pixels_per_dbu);
 
+  // Limit the memory each layout viewer uses to cache the drawn layout
+  void setTileCacheSize(int megabytes);
+  // Set the width and height of the tiles the layout is drawn in
+  void setTileSize(int pixels);
+
   // Save layout to an image file
   void saveImage(const std::string& filename,
                  const odb::Rect& region = odb::Rect(),
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "densityPyramid.h"
+
+#include <algorithm>
+
+namespace gui {
+
+DensityPyramid::DensityPyramid(const odb::Rect& bounds, int bin_size)
+    : bounds_(bounds), bin_size_(bin_size)
+{
+  for (int size = bin_size;; size *= 2) {
+    const int bins_x = std::max(1, (bounds.dx() + size - 1) / size);
+    const int bins_y = std::max(1, (bounds.dy() + size - 1) / size);
+    levels_.push_back({bins_x, bins_y, std::vector<float>(bins_x * bins_y)});
+    if (bins_x == 1 && bins_y == 1) {
+      break;
+    }
+  }
+}
+
+void DensityPyramid::add(const odb::Rect& rect, const float sign)
+{
+  for (int level = 0; level < getLevels(); level++) {
+    addToLevel(level, rect, sign);
+  }
+}
+
+void DensityPyramid::addFine(const odb::Rect& rect)
+{
+  if (!levels_.empty()) {
+    addToLevel(0, rect, 1.0f);
+  }
+}
+
+void DensityPyramid::addToLevel(const int level,
+                                const odb::Rect& rect,
+                                const float sign)
+{
+  if (!rect.overlaps(bounds_)) {
+    return;
+  }
+  const odb::Rect clipped = rect.intersect(bounds_);
+  if (clipped.area() == 0) {
+    return;
+  }
+
+  Level& data = levels_[level];
+  const int size = getBinSize(level);
+  const double bin_area = static_cast<double>(size) * size;
+
+  const int x_lo = clipped.xMin() - bounds_.xMin();
+  const int y_lo = clipped.yMin() - bounds_.yMin();
+  const int x_hi = clipped.xMax() - bounds_.xMin();
+  const int y_hi = clipped.yMax() - bounds_.yMin();
+  const int bin_x_hi = std::min((x_hi - 1) / size, data.bins_x - 1);
+  const int bin_y_hi = std::min((y_hi - 1) / size, data.bins_y - 1);
+
+  for (int bin_y = y_lo / size; bin_y <= bin_y_hi; bin_y++) {
+    const int dy = std::min(y_hi, (bin_y + 1) * size)
+                   - std::max(y_lo, bin_y * size);
+    for (int bin_x = x_lo / size; bin_x <= bin_x_hi; bin_x++) {
+      const int dx = std::min(x_hi, (bin_x + 1) * size)
+                     - std::max(x_lo, bin_x * size);
+      data.density[bin_y * data.bins_x + bin_x]
+          += sign * (static_cast<double>(dx) * dy / bin_area);
+    }
+  }
+}
+
+bool DensityPyramid::getWindow(const odb::Rect& area,
+                               const double max_bin_size,
+                               DensityWindow& window) const
+{
+  window.bins_x = 0;
+  window.bins_y = 0;
+  window.density.clear();
+  if (levels_.empty() || getBinSize(0) > max_bin_size) {
+    return false;
+  }
+  int level = 0;
+  while (level + 1 < getLevels() && getBinSize(level + 1) <= max_bin_size) {
+    level++;
+  }
+
+  if (!area.overlaps(bounds_)) {
+    return true;
+  }
+  const odb::Rect clipped = area.intersect(bounds_);
+  const Level& data = levels_[level];
+  const int size = getBinSize(level);
+  const int x_lo = (clipped.xMin() - bounds_.xMin()) / size;
+  const int y_lo = (clipped.yMin() - bounds_.yMin()) / size;
+  const int x_hi
+      = std::min((clipped.xMax() - bounds_.xMin()) / size, data.bins_x - 1);
+  const int y_hi
+      = std::min((clipped.yMax() - bounds_.yMin()) / size, data.bins_y - 1);
+
+  window.bounds = odb::Rect(bounds_.xMin() + x_lo * size,
+                            bounds_.yMin() + y_lo * size,
+                            bounds_.xMin() + (x_hi + 1) * size,
+                            bounds_.yMin() + (y_hi + 1) * size);
+  window.bins_x = x_hi - x_lo + 1;
+  window.bins_y = y_hi - y_lo + 1;
+  window.density.reserve(window.bins_x * window.bins_y);
+  for (int y = y_lo; y <= y_hi; y++) {
+    const auto row = data.density.begin() + y * data.bins_x;
+    window.density.insert(window.density.end(), row + x_lo, row + x_hi + 1);
+  }
+  return true;
+}
+
+void DensityPyramid::buildLevels()
+{
+  for (int level = 1; level < getLevels(); level++) {
+    const Level& fine = levels_[level - 1];
+    Level& coarse = levels_[level];
+    std::fill(coarse.density.begin(), coarse.density.end(), 0.0f);
+    for (int y = 0; y < fine.bins_y; y++) {
+      for (int x = 0; x < fine.bins_x; x++) {
+        coarse.density[(y / 2) * coarse.bins_x + x / 2]
+            += fine.density[y * fine.bins_x + x] / 4;
+      }
+    }
+  }
+}
+
+}  // namespace gui
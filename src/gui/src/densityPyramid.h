@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <vector>
+
+#include "odb/geom.h"
+
+namespace gui {
+
+// Copy of the bins of one level of a DensityPyramid over an area, so they
+// can be drawn without holding on to the pyramid.
+struct DensityWindow
+{
+  odb::Rect bounds;  // area covered by the bins
+  int bins_x = 0;
+  int bins_y = 0;
+  std::vector<float> density;  // row major from the lower left bin
+};
+
+// Multi-resolution occupancy raster of a set of rectangles, used to draw
+// zoomed out views without visiting every shape.  Level 0 divides the
+// bounds into square bins of bin_size dbu and each following level merges
+// 2x2 bins of the one below, up to a single bin.  A bin holds the area of
+// the rectangles inside it divided by the bin area.  Overlapping rectangles
+// are summed so the value may exceed 1.
+class DensityPyramid
+{
+ public:
+  DensityPyramid() = default;
+  DensityPyramid(const odb::Rect& bounds, int bin_size);
+
+  // Adds (sign 1) or removes (sign -1) the rect on every level.
+  void add(const odb::Rect& rect, float sign = 1.0f);
+
+  // Adds the rect on level 0 only, for bulk loading.  buildLevels must be
+  // called once all the rects are added.
+  void addFine(const odb::Rect& rect);
+  void buildLevels();
+
+  // Copies the bins overlapping the area from the coarsest level whose bins
+  // are no larger than max_bin_size.  Returns false if even the finest bins
+  // are larger.
+  bool getWindow(const odb::Rect& area,
+                 double max_bin_size,
+                 DensityWindow& window) const;
+
+  const odb::Rect& getBounds() const { return bounds_; }
+  int getLevels() const { return levels_.size(); }
+  int getBinSize(int level) const { return bin_size_ << level; }
+  int getBinsX(int level) const { return levels_[level].bins_x; }
+  int getBinsY(int level) const { return levels_[level].bins_y; }
+  float getDensity(int level, int x, int y) const
+  {
+    const Level& data = levels_[level];
+    return data.density[y * data.bins_x + x];
+  }
+
+ private:
+  struct Level
+  {
+    int bins_x;
+    int bins_y;
+    std::vector<float> density;  // row major
+  };
+
+  void addToLevel(int level, const odb::Rect& rect, float sign);
+
+  odb::Rect bounds_;
+  int bin_size_ = 1;
+  std::vector<Level> levels_;
+};
+
+}  // namespace gui
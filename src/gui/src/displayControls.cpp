@@ -1549,6 +1549,17 @@ bool DisplayControls::isNetSelectable(odb::dbNet* net)
   return isModelRowSelectable(getNetRow(net));
 }
 
+// The group is only checked when all of its rows are
+bool DisplayControls::areAllNetsVisible()
+{
+  return nets_group_.visible->checkState() == Qt::Checked;
+}
+
+bool DisplayControls::areAllInstancesVisible()
+{
+  return instance_group_.visible->checkState() == Qt::Checked;
+}
+
 bool DisplayControls::areInstanceNamesVisible()
 {
   return isModelRowVisible(&instance_shapes_.names);
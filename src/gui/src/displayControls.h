@@ -210,6 +210,8 @@ class DisplayControls : public QDockWidget,
   bool isSelectable(const odb::dbTechLayer* layer) override;
   bool isNetVisible(odb::dbNet* net) override;
   bool isNetSelectable(odb::dbNet* net) override;
+  bool areAllNetsVisible() override;
+  bool areAllInstancesVisible() override;
   bool isInstanceVisible(odb::dbInst* inst) override;
   bool isInstanceSelectable(odb::dbInst* inst) override;
   bool areInstanceNamesVisible() override;
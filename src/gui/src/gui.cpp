@@ -672,6 +672,16 @@ void Gui::setResolution(double pixels_per_dbu)
   main_window->getLayoutViewer()->setResolution(pixels_per_dbu);
 }
 
+void Gui::setTileCacheSize(int megabytes)
+{
+  main_window->getLayoutTabs()->setTileCacheSize(megabytes);
+}
+
+void Gui::setTileSize(int pixels)
+{
+  main_window->getLayoutTabs()->setTileSize(pixels);
+}
+
 void Gui::saveImage(const std::string& filename,
                     const odb::Rect& region,
                     int width_px,
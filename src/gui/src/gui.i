@@ -256,6 +256,28 @@ void set_resolution(double dbu_per_pixel)
   gui->setResolution(1 / dbu_per_pixel);
 }
 
+void set_tile_cache_size(int megabytes)
+{
+  if (!check_gui("set_tile_cache_size")) {
+    return;
+  }
+  auto gui = gui::Gui::get();
+  gui->setTileCacheSize(megabytes);
+}
+
+void set_tile_size(int pixels)
+{
+  if (!check_gui("set_tile_size")) {
+    return;
+  }
+  if (pixels <= 0 || pixels % 8 != 0) {
+    auto logger = ord::OpenRoad::openRoad()->getLogger();
+    logger->error(GUI, 100, "Tile size must be a positive multiple of 8.");
+  }
+  auto gui = gui::Gui::get();
+  gui->setTileSize(pixels);
+}
+
 void design_created()
 {
   if (!check_gui("design_created")) {
@@ -88,6 +88,8 @@ void LayoutTabs::blockLoaded(odb::dbBlock* block)
                                  showRulerAsEuclidian_,
                                  this);
   viewer->setLogger(logger_);
+  viewer->setTileCacheSize(tile_cache_size_);
+  viewer->setTileSize(tile_size_);
   viewers_.push_back(viewer);
   if (command_executing_) {
     viewer->commandAboutToExecute();
@@ -191,6 +193,29 @@ void LayoutTabs::fullRepaint()
   }
 }
 
+void LayoutTabs::viewRepaint()
+{
+  for (auto viewer : viewers_) {
+    viewer->viewRepaint();
+  }
+}
+
+void LayoutTabs::setTileCacheSize(int megabytes)
+{
+  tile_cache_size_ = megabytes;
+  for (auto viewer : viewers_) {
+    viewer->setTileCacheSize(megabytes);
+  }
+}
+
+void LayoutTabs::setTileSize(int pixels)
+{
+  tile_size_ = pixels;
+  for (auto viewer : viewers_) {
+    viewer->setTileSize(pixels);
+  }
+}
+
 void LayoutTabs::startRulerBuild()
 {
   if (current_viewer_) {
@@ -110,6 +110,9 @@ class LayoutTabs : public QTabWidget
   void blockLoaded(odb::dbBlock* block);
   void fit();
   void fullRepaint();
+  void viewRepaint();
+  void setTileCacheSize(int megabytes);
+  void setTileSize(int pixels);
   void startRulerBuild();
   void cancelRulerBuild();
   void selection(const Selected& selection);
@@ -142,6 +145,8 @@ class LayoutTabs : public QTabWidget
   std::function<bool(void)> showRulerAsEuclidian_;
   utl::Logger* logger_;
   bool command_executing_ = false;
+  int tile_cache_size_ = 128;  // MB per viewer
+  int tile_size_ = 256;        // pixels
 
   // Set of nets to focus drawing on, if empty draw everything
   std::set<odb::dbNet*> focus_nets_;
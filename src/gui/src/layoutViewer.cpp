@@ -189,6 +189,7 @@ void LayoutViewer::setLoadingState()
 void LayoutViewer::setBlock(odb::dbBlock* block)
 {
   block_ = block;
+  viewer_thread_.clearTileCache();
 
   if (block && cut_maximum_size_.empty()) {
     generateCutLayerMaximumSizes();
@@ -307,6 +308,17 @@ void LayoutViewer::setResolution(qreal pixels_per_dbu)
   centerAt(center);
 }
 
+void LayoutViewer::setTileCacheSize(int megabytes)
+{
+  viewer_thread_.setTileCacheSize(megabytes);
+}
+
+void LayoutViewer::setTileSize(int pixels)
+{
+  viewer_thread_.setTileSize(pixels);
+  viewRepaint();
+}
+
 void LayoutViewer::updateCenter(int dx, int dy)
 {
   // modify the center according to the dx and dy
@@ -501,6 +513,7 @@ std::pair<LayoutViewer::Edge, bool> LayoutViewer::searchNearestEdge(
   if (!hasDesign()) {
     return {Edge(), false};
   }
+  const Search::ReadGuard guard(search_);
 
   const int search_radius = block_->getDbUnitsPerMicron();
 
@@ -815,6 +828,7 @@ void LayoutViewer::selectAt(odb::Rect region, std::vector<Selected>& selections)
   if (!hasDesign()) {
     return;
   }
+  const Search::ReadGuard guard(search_);
 
   // Look for the selected object in reverse layer order
   auto& renderers = Gui::get()->renderers();
@@ -1309,7 +1323,7 @@ void LayoutViewer::updateScaleAndCentering(const QSize& new_size)
                  ((new_area.height() + bounds.dy() * pixels_per_dbu_) / 2
                   + bounds.yMin() * pixels_per_dbu_));
 
-    fullRepaint();
+    viewRepaint();
   }
 }
 
@@ -1380,12 +1394,14 @@ void LayoutViewer::boxesByLayer(dbMaster* master, LayerBoxes& boxes)
 const LayoutViewer::Boxes* LayoutViewer::boxesByLayer(dbMaster* master,
                                                       dbTechLayer* layer)
 {
+  std::unique_lock<std::mutex> lock(cell_boxes_mutex_);
   auto it = cell_boxes_.find(master);
   if (it == cell_boxes_.end()) {
     LayerBoxes& boxes = cell_boxes_[master];
     boxesByLayer(master, boxes);
   }
   it = cell_boxes_.find(master);
+  lock.unlock();  // map nodes are stable
   LayerBoxes& boxes = it->second;
 
   auto layer_it = boxes.find(layer);
@@ -1858,10 +1874,16 @@ void LayoutViewer::paintEvent(QPaintEvent* event)
 }
 
 void LayoutViewer::fullRepaint()
+{
+  viewer_thread_.clearTileCache();
+  viewRepaint();
+}
+
+void LayoutViewer::viewRepaint()
 {
   if (command_executing_ && !paused_) {
     QTimer::singleShot(
-        5 /*ms*/, this, &LayoutViewer::fullRepaint);  // retry later
+        5 /*ms*/, this, &LayoutViewer::viewRepaint);  // retry later
     return;
   }
 
@@ -1980,7 +2002,7 @@ void LayoutViewer::setScroller(LayoutScroll* scroller)
   connect(scroller_,
           &LayoutScroll::centerChanged,
           this,
-          &LayoutViewer::fullRepaint);
+          &LayoutViewer::viewRepaint);
 }
 
 void LayoutViewer::viewportUpdated()
@@ -2001,7 +2023,7 @@ void LayoutViewer::viewportUpdated()
   if (!zoomed_in) {
     resize(scroller_->maximumViewportSize());
   }
-  fullRepaint();
+  viewRepaint();
 }
 
 void LayoutViewer::saveImage(const QString& filepath,
@@ -49,6 +49,7 @@
 #include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "gui/gui.h"
@@ -239,12 +240,21 @@ class LayoutViewer : public QWidget
   // set the layout resolution
   void setResolution(qreal pixels_per_dbu);
 
+  // limit the memory used to cache the drawn layout
+  void setTileCacheSize(int megabytes);
+  // set the width and height of the drawn layout tiles
+  void setTileSize(int pixels);
+
   // update the fit resolution (the maximum pixels_per_dbu without scroll bars)
   void viewportUpdated();
 
   // signals that the cache should be flushed and a full repaint should occur.
   void fullRepaint();
 
+  // repaint reusing the cached layout tiles, for changes that only move the
+  // view or touch what is drawn over the layout (selection, rulers, ...).
+  void viewRepaint();
+
   odb::Point getVisibleCenter();
 
   void selectHighlightConnectedInst(bool select_flag);
@@ -384,6 +394,7 @@ class LayoutViewer : public QWidget
   int max_depth_;
   Search search_;
   CellBoxes cell_boxes_;
+  std::mutex cell_boxes_mutex_;  // the tiles are rendered in parallel
   QRect rubber_band_;  // screen coordinates
   QPoint mouse_press_pos_;
   QPoint mouse_move_pos_;
@@ -190,10 +190,10 @@ MainWindow::MainWindow(QWidget* parent)
       });
 
   connect(
-      this, &MainWindow::selectionChanged, viewers_, &LayoutTabs::fullRepaint);
+      this, &MainWindow::selectionChanged, viewers_, &LayoutTabs::viewRepaint);
   connect(
-      this, &MainWindow::highlightChanged, viewers_, &LayoutTabs::fullRepaint);
-  connect(this, &MainWindow::rulersChanged, viewers_, &LayoutTabs::fullRepaint);
+      this, &MainWindow::highlightChanged, viewers_, &LayoutTabs::viewRepaint);
+  connect(this, &MainWindow::rulersChanged, viewers_, &LayoutTabs::viewRepaint);
 
   connect(controls_, &DisplayControls::selected, [=](const Selected& selected) {
     setSelected(selected);
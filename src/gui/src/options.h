@@ -65,6 +65,8 @@ class Options
   virtual bool isSelectable(const odb::dbTechLayer* layer) = 0;
   virtual bool isNetVisible(odb::dbNet* net) = 0;
   virtual bool isNetSelectable(odb::dbNet* net) = 0;
+  virtual bool areAllNetsVisible() = 0;
+  virtual bool areAllInstancesVisible() = 0;
   virtual bool isInstanceVisible(odb::dbInst* inst) = 0;
   virtual bool isInstanceSelectable(odb::dbInst* inst) = 0;
   virtual bool areInstanceNamesVisible() = 0;
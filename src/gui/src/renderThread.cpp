@@ -33,7 +33,12 @@
 #include "renderThread.h"
 
 #include <QPainterPath>
+#include <QRunnable>
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
+#include "densityPyramid.h"
 #include "layoutViewer.h"
 #include "odb/dbShape.h"
 #include "odb/dbTransform.h"
@@ -57,6 +62,21 @@ using odb::Rect;
 
 using utl::GUI;
 
+namespace {
+
+class TileRunnable : public QRunnable
+{
+ public:
+  TileRunnable(std::function<void()> draw) : draw_(std::move(draw)) {}
+
+  void run() override { draw_(); }
+
+ private:
+  std::function<void()> draw_;
+};
+
+}  // namespace
+
 RenderThread::RenderThread(LayoutViewer* viewer) : viewer_(viewer)
 {
 }
@@ -71,6 +91,32 @@ void RenderThread::exit()
   wait();
 }
 
+void RenderThread::clearTileCache()
+{
+  tile_cache_.clear();
+}
+
+void RenderThread::setTileCacheSize(int megabytes)
+{
+  tile_cache_megabytes_ = megabytes;
+  updateMaxCachedTiles();
+}
+
+void RenderThread::setTileSize(int pixels)
+{
+  tile_size_ = pixels;
+  updateMaxCachedTiles();
+  tile_cache_.clear();
+}
+
+void RenderThread::updateMaxCachedTiles()
+{
+  const int tile_size = tile_size_;
+  const int64_t tile_bytes = int64_t{tile_size} * tile_size * 4;
+  const int64_t bytes = int64_t{tile_cache_megabytes_} << 20;
+  tile_cache_.setMaxTiles(std::max<int64_t>(1, bytes / tile_bytes));
+}
+
 void RenderThread::setLogger(utl::Logger* logger)
 {
   logger_ = logger;
@@ -123,13 +169,7 @@ void RenderThread::run()
                  draw_bounds.height(),
                  QImage::Format_ARGB32_Premultiplied);
     // drawing can be interrupted by setting restart_
-    draw(image,
-         draw_bounds,
-         selected,
-         highlighted,
-         rulers,
-         1.0,
-         Qt::transparent);
+    drawTiled(image, draw_bounds, selected, highlighted, rulers);
     if (!restart_) {
       is_rendering_ = false;
 
@@ -213,13 +253,262 @@ void RenderThread::draw(QImage& image,
     image.fill(background);
   }
 
-  drawBlock(&painter, viewer_->block_, dbu_bounds, 0);
+  utl::Timer io_pins_setup;
+  setupIOPins(viewer_->block_, dbu_bounds);
+  debugPrint(logger_, GUI, "draw", 1, "io pins setup {}", io_pins_setup);
+
+  // The image is drawn in tiles like the layout viewer but without caching
+  const int tile_size = tile_size_;
+  std::vector<QRect> tiles_bounds;
+  for (int y = 0; y < image.height(); y += tile_size) {
+    for (int x = 0; x < image.width(); x += tile_size) {
+      tiles_bounds.emplace_back(x, y, tile_size, tile_size);
+    }
+  }
+  std::vector<QImage> images;
+  std::vector<char> complete;
+  drawTiles(painter.transform(), tiles_bounds, images, complete);
+
+  painter.save();
+  painter.resetTransform();
+  const int tile_count = tiles_bounds.size();
+  for (int i = 0; i < tile_count; i++) {
+    if (complete[i]) {
+      painter.drawImage(tiles_bounds[i].topLeft(), images[i]);
+    }
+  }
+  painter.restore();
+
+  drawRenderers(gui_painter, viewer_->block_);
+
+  // draw selected and over top level and fast painting events
+  drawSelected(gui_painter, selected);
+  // Always last so on top
+  drawHighlighted(gui_painter, highlighted);
+  drawRulers(gui_painter, rulers);
+}
+
+void RenderThread::drawTiled(QImage& image,
+                             const QRect& draw_bounds,
+                             const SelectionSet& selected,
+                             const HighlightSet& highlighted,
+                             const Rulers& rulers)
+{
+  if (image.isNull()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(drawing_mutex_);
+  utl::Timer timer;
+
+  image.fill(Qt::transparent);
+
+  const Rect dbu_bounds = viewer_->screenToDBU(draw_bounds);
+  dbBlock* block = viewer_->block_;
+
+  if (!is_first_render_done_ && !restart_) {
+    QPainter painter(&image);
+    painter.translate(-draw_bounds.topLeft());
+    painter.translate(viewer_->centering_shift_);
+    painter.scale(viewer_->pixels_per_dbu_, -viewer_->pixels_per_dbu_);
+    GuiPainter gui_painter(&painter,
+                           viewer_->options_,
+                           dbu_bounds,
+                           viewer_->pixels_per_dbu_,
+                           block->getDbUnitsPerMicron());
+    drawDesignLoadingMessage(gui_painter, dbu_bounds);
+    painter.end();
+    emit done(image, draw_bounds);
+
+    // Erase the first render indication so it does not remain on the screen
+    // when the design is drawn for the first time
+    image.fill(Qt::transparent);
+  }
+
+  // Read once so the frame's tiles all have the same size; a new size
+  // clears the cache after the frame began, so these tiles are not kept.
+  const int tile_size = tile_size_;
+  const QPoint& shift = viewer_->centering_shift_;
+  const int generation = tile_cache_.beginFrame({viewer_->pixels_per_dbu_,
+                                                 shift.x(),
+                                                 shift.y(),
+                                                 draw_bounds.width(),
+                                                 draw_bounds.height()});
+
+  // The pixel grid may start at negative coordinates so round down.
+  auto tile_of = [tile_size](int pixel) {
+    return pixel >= 0 ? pixel / tile_size : (pixel + 1) / tile_size - 1;
+  };
+  const int col_lo = tile_of(draw_bounds.left());
+  const int col_hi = tile_of(draw_bounds.right());
+  const int row_lo = tile_of(draw_bounds.top());
+  const int row_hi = tile_of(draw_bounds.bottom());
+
+  std::vector<TileCache::Index> missing;
+  for (int row = row_lo; row <= row_hi; row++) {
+    for (int col = col_lo; col <= col_hi; col++) {
+      if (tile_cache_.find({col, row}) == nullptr) {
+        missing.emplace_back(col, row);
+      }
+    }
+  }
+
+  if (!missing.empty()) {
+    utl::Timer io_pins_setup;
+    setupIOPins(block, dbu_bounds);
+    debugPrint(logger_, GUI, "draw", 1, "io pins setup {}", io_pins_setup);
+
+    // The tiles are in the viewer's pixels
+    QTransform xfm;
+    xfm.translate(shift.x(), shift.y());
+    xfm.scale(viewer_->pixels_per_dbu_, -viewer_->pixels_per_dbu_);
+
+    const int tile_count = missing.size();
+    std::vector<QRect> tiles_bounds;
+    tiles_bounds.reserve(tile_count);
+    for (const auto& [col, row] : missing) {
+      tiles_bounds.emplace_back(
+          col * tile_size, row * tile_size, tile_size, tile_size);
+    }
+    std::vector<QImage> images;
+    std::vector<char> complete;
+    const bool current = drawTiles(xfm, tiles_bounds, images, complete);
+
+    // Drop the tiles if the layout changed while they were drawn.
+    for (int i = 0; i < tile_count; i++) {
+      if (complete[i] && current) {
+        tile_cache_.store(missing[i], std::move(images[i]), generation);
+      }
+    }
+    debugPrint(logger_,
+               GUI,
+               "draw",
+               1,
+               "{} of {} tiles rendered",
+               tile_count,
+               (row_hi - row_lo + 1) * (col_hi - col_lo + 1));
+  }
+
+  if (restart_) {
+    return;
+  }
+
+  QPainter painter(&image);
+  for (int row = row_lo; row <= row_hi; row++) {
+    for (int col = col_lo; col <= col_hi; col++) {
+      const QImage* tile = tile_cache_.find({col, row});
+      if (tile == nullptr) {
+        continue;
+      }
+      painter.drawImage(
+          QPoint(col * tile_size, row * tile_size) - draw_bounds.topLeft(),
+          *tile);
+    }
+  }
+
+  painter.setRenderHints(QPainter::Antialiasing);
+  painter.translate(-draw_bounds.topLeft());
+  painter.translate(viewer_->centering_shift_);
+  painter.scale(viewer_->pixels_per_dbu_, -viewer_->pixels_per_dbu_);
+
+  GuiPainter gui_painter(&painter,
+                         viewer_->options_,
+                         dbu_bounds,
+                         viewer_->pixels_per_dbu_,
+                         block->getDbUnitsPerMicron());
+
+  // The renderers are not cached as they may change at any time.
+  drawRenderers(gui_painter, block);
 
   // draw selected and over top level and fast painting events
   drawSelected(gui_painter, selected);
   // Always last so on top
   drawHighlighted(gui_painter, highlighted);
   drawRulers(gui_painter, rulers);
+
+  tile_cache_.evict();
+  debugPrint(logger_, GUI, "draw", 1, "tiled render {}", timer);
+}
+
+// Draws the layout, without the renderers, into one image per tile on the
+// tile pool.  xfm maps dbu to the pixels the tiles' bounds are in.  A tile
+// is complete if no restart was requested while it was drawn.  Returns
+// false if the layout changed while the tiles were drawn.
+bool RenderThread::drawTiles(const QTransform& xfm,
+                             const std::vector<QRect>& tiles_bounds,
+                             std::vector<QImage>& images,
+                             std::vector<char>& complete)
+{
+  dbBlock* block = viewer_->block_;
+  Search& search = viewer_->search_;
+
+  // Build the search trees up front and keep them as they are until the
+  // tiles are done so that no tile updates a tree another tile is reading.
+  search.updateTrees(block);
+  for (dbBlock* child : block->getChildren()) {
+    search.updateTrees(child);
+  }
+  search.setReadOnly(true);
+
+  const int tile_count = tiles_bounds.size();
+  const QTransform to_dbu = xfm.inverted();
+  std::vector<Rect> dbu_bounds;
+  dbu_bounds.reserve(tile_count);
+  Rect frame_bounds;
+  frame_bounds.mergeInit();
+  for (const QRect& tile_bounds : tiles_bounds) {
+    const QRectF bounds = to_dbu.mapRect(QRectF(tile_bounds));
+    dbu_bounds.emplace_back(static_cast<int>(std::floor(bounds.left())),
+                            static_cast<int>(std::floor(bounds.top())),
+                            static_cast<int>(std::ceil(bounds.right())),
+                            static_cast<int>(std::ceil(bounds.bottom())));
+    frame_bounds.merge(dbu_bounds.back());
+  }
+
+  // Search the instances once and give each tile the ones it overlaps
+  utl::Timer inst_timer;
+  const std::vector<dbInst*> insts = searchInstances(block, frame_bounds);
+  debugPrint(logger_, GUI, "draw", 1, "inst search {}", inst_timer);
+
+  images.assign(tile_count, QImage());
+  complete.assign(tile_count, false);
+  for (int i = 0; i < tile_count; i++) {
+    auto draw_tile = [this, i, block, &xfm, &tiles_bounds, &dbu_bounds, &insts,
+                      &images, &complete] {
+      if (restart_) {
+        return;
+      }
+      const QRect& tile_bounds = tiles_bounds[i];
+      const Rect& bounds = dbu_bounds[i];
+      std::vector<dbInst*> tile_insts;
+      for (dbInst* inst : insts) {
+        if (inst->getBBox()->getBox().intersects(bounds)) {
+          tile_insts.push_back(inst);
+        }
+      }
+
+      QImage& tile = images[i];
+      tile = QImage(tile_bounds.size(), QImage::Format_ARGB32_Premultiplied);
+      tile.fill(Qt::transparent);
+      QPainter painter(&tile);
+      painter.setRenderHints(QPainter::Antialiasing);
+      painter.setTransform(xfm
+                           * QTransform::fromTranslate(-tile_bounds.left(),
+                                                       -tile_bounds.top()));
+
+      drawBlock(&painter, block, bounds, tile_insts, 0);
+      complete[i] = !restart_;
+    };
+    tile_pool_.start(new TileRunnable(draw_tile));
+  }
+  tile_pool_.waitForDone();
+
+  search.setReadOnly(false);
+
+  bool current = !search.needsUpdate(block);
+  for (dbBlock* child : block->getChildren()) {
+    current = current && !search.needsUpdate(child);
+  }
+  return current;
 }
 
 QColor RenderThread::getColor(dbTechLayer* layer)
@@ -268,6 +557,16 @@ void RenderThread::addInstTransform(QTransform& xfm,
   }
 }
 
+// Safe to call from the tile pool as it doesn't add to the map.
+int RenderThread::cutMaximumSize(dbTechLayer* layer) const
+{
+  auto it = viewer_->cut_maximum_size_.find(layer);
+  if (it == viewer_->cut_maximum_size_.end()) {
+    return 0;
+  }
+  return it->second;
+}
+
 bool RenderThread::instanceBelowMinSize(dbInst* inst)
 {
   dbMaster* master = inst->getMaster();
@@ -492,6 +791,92 @@ void RenderThread::drawInstanceOutlines(QPainter* painter,
   painter->setTransform(initial_xfm);
 }
 
+// True if the placed instances are too small to tell apart and are drawn
+// as a density raster instead of one by one.
+bool RenderThread::isInstanceDensityVisible(odb::dbBlock* block)
+{
+  // The raster can't filter by instance type or color by module
+  auto* options = viewer_->options_;
+  if (options->isDetailedVisibility() || !options->areAllInstancesVisible()
+      || options->isModuleView() || options->areAccessPointsVisible()) {
+    return false;
+  }
+
+  const int bin_size = viewer_->search_.getInstDensityBinSize(block);
+  return bin_size * viewer_->pixels_per_dbu_ <= 1.0;
+}
+
+void RenderThread::drawInstanceDensity(QPainter* painter,
+                                       odb::dbBlock* block,
+                                       const Rect& bounds)
+{
+  if (!isInstanceDensityVisible(block)) {
+    return;
+  }
+
+  DensityWindow window;
+  if (viewer_->search_.searchInstDensity(
+          block, bounds, 1.0 / viewer_->pixels_per_dbu_, window)) {
+    drawDensity(painter, window, Qt::gray);
+  }
+}
+
+// Draws the routing of the layer as a density raster when the individual
+// shapes are too small to tell apart.  Returns false if the shapes should
+// be drawn one by one.
+bool RenderThread::drawShapeDensity(QPainter* painter,
+                                    odb::dbBlock* block,
+                                    dbTechLayer* layer,
+                                    const Rect& bounds)
+{
+  // The raster can't filter by net
+  auto* options = viewer_->options_;
+  if (options->isDetailedVisibility() || !viewer_->focus_nets_.empty()
+      || !options->areAllNetsVisible() || !options->areRoutingSegmentsVisible()
+      || !options->areRoutingViasVisible()
+      || !options->areSpecialRoutingSegmentsVisible()
+      || !options->areSpecialRoutingViasVisible()) {
+    return false;
+  }
+
+  DensityWindow window;
+  if (!viewer_->search_.searchShapeDensity(
+          block, layer, bounds, 1.0 / viewer_->pixels_per_dbu_, window)) {
+    return false;
+  }
+  drawDensity(painter, window, getColor(layer));
+  return true;
+}
+
+// Draws the bins as an image in the color with the alpha scaled by the
+// density.
+void RenderThread::drawDensity(QPainter* painter,
+                               const DensityWindow& window,
+                               const QColor& color)
+{
+  if (window.density.empty()) {
+    return;
+  }
+
+  // Row y of the image is bin row y as the painter flips y
+  QImage image(window.bins_x, window.bins_y, QImage::Format_ARGB32);
+  for (int y = 0; y < window.bins_y; y++) {
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+    for (int x = 0; x < window.bins_x; x++) {
+      const float value
+          = std::clamp(window.density[y * window.bins_x + x], 0.0f, 1.0f);
+      line[x] = qRgba(color.red(),
+                      color.green(),
+                      color.blue(),
+                      std::lround(value * color.alpha()));
+    }
+  }
+
+  const Rect& bounds = window.bounds;
+  painter->drawImage(
+      QRectF(bounds.xMin(), bounds.yMin(), bounds.dx(), bounds.dy()), image);
+}
+
 // Draw the instances' shapes
 void RenderThread::drawInstanceShapes(dbTechLayer* layer,
                                       QPainter* painter,
@@ -883,7 +1268,7 @@ void RenderThread::drawLayer(QPainter* painter,
   // Skip the cut layer if the cuts will be too small to see
   const bool draw_shapes
       = !(layer->getType() == dbTechLayerType::CUT
-          && viewer_->cut_maximum_size_[layer] < shape_limit);
+          && cutMaximumSize(layer) < shape_limit);
   const bool layer_is_routing = layer->getType() == dbTechLayerType::CUT
                                 || layer->getType() == dbTechLayerType::ROUTING;
 
@@ -891,6 +1276,11 @@ void RenderThread::drawLayer(QPainter* painter,
     drawInstanceShapes(layer, painter, insts, bounds, gui_painter);
   }
 
+  // When zoomed out the routing is drawn as a density raster instead
+  const bool draw_density
+      = draw_shapes && layer_is_routing
+        && drawShapeDensity(painter, block, layer, bounds);
+
   drawObstructions(block, layer, painter, bounds);
 
   const bool draw_routing
@@ -903,7 +1293,7 @@ void RenderThread::drawLayer(QPainter* painter,
   painter->setBrush(QBrush(color, brush_pattern));
   painter->setPen(QPen(color, 0));
   if (draw_shapes) {
-    if (draw_routing || draw_vias) {
+    if ((draw_routing || draw_vias) && !draw_density) {
       auto box_iter = viewer_->search_.searchBoxShapes(block,
                                                        layer,
                                                        bounds.xMin(),
@@ -932,7 +1322,8 @@ void RenderThread::drawLayer(QPainter* painter,
       }
     }
 
-    if (viewer_->options_->areSpecialRoutingViasVisible() && layer_is_routing) {
+    if (viewer_->options_->areSpecialRoutingViasVisible() && layer_is_routing
+        && !draw_density) {
       if (layer->getType() == dbTechLayerType::CUT) {
         drawViaShapes(painter, block, layer, layer, bounds, shape_limit);
       } else {
@@ -941,12 +1332,12 @@ void RenderThread::drawLayer(QPainter* painter,
         // will be too small based on the cut size (enclosure shapes
         // are generally only slightly larger).
         if (auto upper = layer->getUpperLayer()) {
-          if (viewer_->cut_maximum_size_[upper] >= shape_limit) {
+          if (cutMaximumSize(upper) >= shape_limit) {
             drawViaShapes(painter, block, upper, layer, bounds, shape_limit);
           }
         }
         if (auto lower = layer->getLowerLayer()) {
-          if (viewer_->cut_maximum_size_[lower] >= shape_limit) {
+          if (cutMaximumSize(lower) >= shape_limit) {
             drawViaShapes(painter, block, lower, layer, bounds, shape_limit);
           }
         }
@@ -954,7 +1345,7 @@ void RenderThread::drawLayer(QPainter* painter,
     }
 
     if (viewer_->options_->areSpecialRoutingSegmentsVisible()
-        && layer_is_routing) {
+        && layer_is_routing && !draw_density) {
       auto polygon_iter = viewer_->search_.searchSNetShapes(block,
                                                             layer,
                                                             bounds.xMin(),
@@ -1023,14 +1414,6 @@ void RenderThread::drawLayer(QPainter* painter,
     drawNetTracks(gui_painter, layer);
   }
 
-  for (auto* renderer : Gui::get()->renderers()) {
-    if (restart_) {
-      break;
-    }
-    gui_painter.saveState();
-    renderer->drawLayer(layer, gui_painter);
-    gui_painter.restoreState();
-  }
   debugPrint(logger_,
              GUI,
              "draw",
@@ -1045,12 +1428,12 @@ void RenderThread::drawLayer(QPainter* painter,
 void RenderThread::drawBlock(QPainter* painter,
                              dbBlock* block,
                              const Rect& bounds,
+                             const std::vector<dbInst*>& insts,
                              int depth)
 {
   utl::Timer timer;
 
   utl::Timer manufacturing_grid_timer;
-  const int instance_limit = viewer_->instanceSizeLimit();
 
   GuiPainter gui_painter(painter,
                          viewer_->options_,
@@ -1074,31 +1457,9 @@ void RenderThread::drawBlock(QPainter* painter,
              "manufacturing grid {}",
              manufacturing_grid_timer);
 
-  utl::Timer inst_timer;
-  auto inst_range = viewer_->search_.searchInsts(block,
-                                                 bounds.xMin(),
-                                                 bounds.yMin(),
-                                                 bounds.xMax(),
-                                                 bounds.yMax(),
-                                                 instance_limit);
-
-  // Cache the search results as we will iterate over the instances
-  // for each layer.
-  std::vector<dbInst*> insts;
-  insts.reserve(10000);
-  for (auto* inst : inst_range) {
-    if (restart_) {
-      break;
-    }
-    if (viewer_->options_->isInstanceVisible(inst)) {
-      insts.push_back(inst);
-    }
-  }
-  debugPrint(logger_, GUI, "draw", 1, "inst search {}", inst_timer);
-
-  utl::Timer io_pins_setup;
-  setupIOPins(block, bounds);
-  debugPrint(logger_, GUI, "draw", 1, "io pins setup {}", io_pins_setup);
+  utl::Timer inst_density;
+  drawInstanceDensity(painter, block, bounds);
+  debugPrint(logger_, GUI, "draw", 1, "inst density {}", inst_density);
 
   utl::Timer insts_outline;
   drawInstanceOutlines(painter, insts);
@@ -1164,18 +1525,90 @@ void RenderThread::drawBlock(QPainter* painter,
   drawGCellGrid(painter, bounds);
   debugPrint(logger_, GUI, "draw", 1, "save cell grid {}", inst_cell_grid);
 
-  utl::Timer inst_save_restore;
-  for (auto* renderer : Gui::get()->renderers()) {
+  debugPrint(logger_, GUI, "draw", 1, "total render {}", timer);
+}
+
+// Searches the instances of the block to draw one by one.  The search
+// results are cached as we will iterate over the instances for each layer.
+std::vector<dbInst*> RenderThread::searchInstances(dbBlock* block,
+                                                   const Rect& bounds)
+{
+  int instance_limit = viewer_->instanceSizeLimit();
+  if (isInstanceDensityVisible(block)) {
+    // Only the instances left out of the density are drawn one by one
+    instance_limit = viewer_->search_.getLargeInstHeight(block);
+  }
+  auto inst_range = viewer_->search_.searchInsts(block,
+                                                 bounds.xMin(),
+                                                 bounds.yMin(),
+                                                 bounds.xMax(),
+                                                 bounds.yMax(),
+                                                 instance_limit);
+
+  std::vector<dbInst*> insts;
+  insts.reserve(10000);
+  for (auto* inst : inst_range) {
     if (restart_) {
       break;
     }
+    if (viewer_->options_->isInstanceVisible(inst)) {
+      insts.push_back(inst);
+    }
+  }
+  return insts;
+}
+
+// The renderers are drawn once over the whole frame rather than per tile
+// as they are not written to be called from several threads at once.
+void RenderThread::drawRenderers(GuiPainter& gui_painter, dbBlock* block)
+{
+  utl::Timer renderers;
+  const auto& frame_renderers = Gui::get()->renderers();
+  if (frame_renderers.empty()) {
+    return;
+  }
+
+  std::vector<dbTechLayer*> layers;
+  dbTech* tech = block->getTech();
+  std::set<dbTech*> child_techs;
+  for (auto child : block->getChildren()) {
+    dbTech* child_tech = child->getTech();
+    if (child_tech != tech) {
+      child_techs.insert(child_tech);
+    }
+  }
+  for (dbTech* child_tech : child_techs) {
+    for (dbTechLayer* layer : child_tech->getLayers()) {
+      layers.push_back(layer);
+    }
+  }
+  for (dbTechLayer* layer : tech->getLayers()) {
+    layers.push_back(layer);
+  }
+
+  for (dbTechLayer* layer : layers) {
+    if (!viewer_->options_->isVisible(layer)) {
+      continue;
+    }
+    for (auto* renderer : frame_renderers) {
+      if (restart_) {
+        return;
+      }
+      gui_painter.saveState();
+      renderer->drawLayer(layer, gui_painter);
+      gui_painter.restoreState();
+    }
+  }
+
+  for (auto* renderer : frame_renderers) {
+    if (restart_) {
+      return;
+    }
     gui_painter.saveState();
     renderer->drawObjects(gui_painter);
     gui_painter.restoreState();
   }
-  debugPrint(logger_, GUI, "draw", 1, "renderers {}", inst_save_restore);
-
-  debugPrint(logger_, GUI, "draw", 1, "total render {}", timer);
+  debugPrint(logger_, GUI, "draw", 1, "renderers {}", renderers);
 }
 
 void RenderThread::drawGCellGrid(QPainter* painter, const odb::Rect& bounds)
@@ -1515,10 +1948,11 @@ void RenderThread::drawIOPins(Painter& painter,
                               const odb::Rect& bounds,
                               odb::dbTechLayer* layer)
 {
-  const auto& pins = pins_[layer];
-  if (pins.empty()) {
+  auto pins_it = pins_.find(layer);
+  if (pins_it == pins_.end() || pins_it->second.empty()) {
     return;
   }
+  const auto& pins = pins_it->second;
 
   const auto die_area = block->getDieArea();
 
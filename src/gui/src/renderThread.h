@@ -35,18 +35,24 @@
 #include <QMutex>
 #include <QPainter>
 #include <QThread>
+#include <QThreadPool>
 #include <QWaitCondition>
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <utility>
 
 #include "gui/gui.h"
 #include "odb/db.h"
 #include "ruler.h"
+#include "tileCache.h"
 #include "utl/Logger.h"
 
 namespace gui {
 
 class LayoutViewer;
 class GuiPainter;
+struct DensityWindow;
 
 class RenderThread : public QThread
 {
@@ -64,6 +70,13 @@ class RenderThread : public QThread
 
   void exit();
 
+  // Drop the cached layout tiles; the layout must be redrawn.
+  void clearTileCache();
+  // Limit the memory held by the cached layout tiles.
+  void setTileCacheSize(int megabytes);
+  // The width and height of the layout tiles in pixels.
+  void setTileSize(int pixels);
+
   // Only to be used by save_image for synchronous rendering
   void draw(QImage& image,
             const QRect& draw_bounds,
@@ -82,11 +95,27 @@ class RenderThread : public QThread
  private:
   void run() override;
 
+  // Draws the layout from cached tiles, rendering the missing ones in
+  // parallel, with the selection, highlight and rulers on top.
+  void drawTiled(QImage& image,
+                 const QRect& draw_bounds,
+                 const SelectionSet& selected,
+                 const HighlightSet& highlighted,
+                 const Rulers& rulers);
+  bool drawTiles(const QTransform& xfm,
+                 const std::vector<QRect>& tiles_bounds,
+                 std::vector<QImage>& images,
+                 std::vector<char>& complete);
+  void updateMaxCachedTiles();
+
   void setupIOPins(odb::dbBlock* block, const odb::Rect& bounds);
 
+  std::vector<odb::dbInst*> searchInstances(odb::dbBlock* block,
+                                            const odb::Rect& bounds);
   void drawBlock(QPainter* painter,
                  odb::dbBlock* block,
                  const odb::Rect& bounds,
+                 const std::vector<odb::dbInst*>& insts,
                  int depth);
   void drawLayer(QPainter* painter,
                  odb::dbBlock* block,
@@ -101,6 +130,17 @@ class RenderThread : public QThread
 
   void drawInstanceOutlines(QPainter* painter,
                             const std::vector<odb::dbInst*>& insts);
+  bool isInstanceDensityVisible(odb::dbBlock* block);
+  void drawInstanceDensity(QPainter* painter,
+                           odb::dbBlock* block,
+                           const odb::Rect& bounds);
+  bool drawShapeDensity(QPainter* painter,
+                        odb::dbBlock* block,
+                        odb::dbTechLayer* layer,
+                        const odb::Rect& bounds);
+  void drawDensity(QPainter* painter,
+                   const DensityWindow& window,
+                   const QColor& color);
   void drawInstanceShapes(odb::dbTechLayer* layer,
                           QPainter* painter,
                           const std::vector<odb::dbInst*>& insts,
@@ -148,8 +188,10 @@ class RenderThread : public QThread
   void drawModuleView(QPainter* painter,
                       const std::vector<odb::dbInst*>& insts);
   void drawRulers(Painter& painter, const Rulers& rulers);
+  void drawRenderers(GuiPainter& gui_painter, odb::dbBlock* block);
 
   bool instanceBelowMinSize(odb::dbInst* inst);
+  int cutMaximumSize(odb::dbTechLayer* layer) const;
 
   void addInstTransform(QTransform& xfm, const odb::dbTransform& inst_xfm);
   QColor getColor(odb::dbTechLayer* layer);
@@ -183,6 +225,13 @@ class RenderThread : public QThread
   std::map<odb::dbTechLayer*,
            std::vector<std::pair<odb::dbBTerm*, odb::dbBox*>>>
       pins_;
+
+  // The layout is drawn in square tiles aligned to the viewer's pixel grid.
+  TileCache tile_cache_;
+  QThreadPool tile_pool_;
+
+  std::atomic_int tile_size_{256};  // pixels
+  std::atomic_int tile_cache_megabytes_{128};
 };
 
 }  // namespace gui
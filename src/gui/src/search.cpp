@@ -32,10 +32,12 @@
 
 #include "search.h"
 
+#include <algorithm>
 #include <tuple>
 #include <utility>
 
 #include "odb/dbShape.h"
+#include "ord/OpenRoad.hh"
 
 namespace gui {
 
@@ -92,12 +94,12 @@ void Search::inDbFillCreate(odb::dbFill* fill)
 
 void Search::inDbWireCreate(odb::dbWire* wire)
 {
-  clearShapes();
+  netModified(wire->getNet());
 }
 
 void Search::inDbWireDestroy(odb::dbWire* wire)
 {
-  clearShapes();
+  netModified(wire->getNet());
 }
 
 void Search::inDbSWireCreate(odb::dbSWire* wire)
@@ -162,7 +164,7 @@ void Search::inDbRowDestroy(odb::dbRow* row)
 
 void Search::inDbWirePostModify(odb::dbWire* wire)
 {
-  clearShapes();
+  netModified(wire->getNet());
 }
 
 void Search::setTopBlock(odb::dbBlock* block)
@@ -190,6 +192,109 @@ void Search::setTopBlock(odb::dbBlock* block)
   emit newBlock(block);
 }
 
+void Search::updateTrees(odb::dbBlock* block)
+{
+  BlockData& data = getData(block);
+  if (!data.shapes_init_ || data.has_modified_nets_) {
+    updateShapes(block);
+  }
+  if (!data.fills_init_) {
+    updateFills(block);
+  }
+  if (!data.insts_init_) {
+    updateInsts(block);
+  }
+  if (!data.blockages_init_) {
+    updateBlockages(block);
+  }
+  if (!data.obstructions_init_) {
+    updateObstructions(block);
+  }
+  if (!data.rows_init_) {
+    updateRows(block);
+  }
+}
+
+void Search::setReadOnly(bool read_only)
+{
+  read_only_ = read_only;
+  if (!read_only) {
+    return;
+  }
+
+  auto wait_for_updates = [](BlockData& data) {
+    std::scoped_lock lock(data.shapes_init_mutex_,
+                          data.fills_init_mutex_,
+                          data.insts_init_mutex_,
+                          data.blockages_init_mutex_,
+                          data.obstructions_init_mutex_,
+                          data.rows_init_mutex_);
+  };
+  wait_for_updates(top_block_data_);
+  for (auto& [block, data] : child_block_data_) {
+    wait_for_updates(data);
+  }
+}
+
+bool Search::needsUpdate(odb::dbBlock* block)
+{
+  BlockData& data = getData(block);
+  return !data.shapes_init_ || data.has_modified_nets_ || !data.fills_init_
+         || !data.insts_init_ || !data.blockages_init_
+         || !data.obstructions_init_ || !data.rows_init_;
+}
+
+// The densities are updated in place so the bins are copied out under the
+// lock that guards their updates.
+bool Search::searchShapeDensity(odb::dbBlock* block,
+                                odb::dbTechLayer* layer,
+                                const odb::Rect& bounds,
+                                const double max_bin_size,
+                                DensityWindow& window)
+{
+  BlockData& data = getData(block);
+  if (!data.shapes_init_ || data.has_modified_nets_) {
+    updateShapes(block);
+  }
+
+  std::lock_guard<std::mutex> lock(data.shapes_init_mutex_);
+  auto it = data.shape_density_.find(layer);
+  if (it == data.shape_density_.end()) {
+    return false;
+  }
+  return it->second.getWindow(bounds, max_bin_size, window);
+}
+
+bool Search::searchInstDensity(odb::dbBlock* block,
+                               const odb::Rect& bounds,
+                               const double max_bin_size,
+                               DensityWindow& window)
+{
+  BlockData& data = getData(block);
+  if (!data.insts_init_) {
+    updateInsts(block);
+  }
+
+  std::lock_guard<std::mutex> lock(data.insts_init_mutex_);
+  return data.inst_density_.getWindow(bounds, max_bin_size, window);
+}
+
+int Search::getInstDensityBinSize(odb::dbBlock* block)
+{
+  BlockData& data = getData(block);
+  if (!data.insts_init_) {
+    updateInsts(block);
+  }
+
+  std::lock_guard<std::mutex> lock(data.insts_init_mutex_);
+  return data.inst_density_.getBinSize(0);
+}
+
+int Search::getLargeInstHeight(odb::dbBlock* block)
+{
+  return large_inst_bins_ * getInstDensityBinSize(block);
+}
+
 void Search::announceModified(std::atomic_bool& flag)
 {
   const bool prev_flag = flag.exchange(false);
@@ -215,6 +320,37 @@ void Search::clearShapes()
   announceModified(top_block_data_.shapes_init_);
 }
 
+// Queues the net's routing shapes to be replaced on the next search.
+void Search::netModified(odb::dbNet* net)
+{
+  if (net == nullptr || net->getBlock() != top_block_) {
+    clearShapes();
+    return;
+  }
+
+  BlockData& data = top_block_data_;
+  if (!data.shapes_init_) {
+    return;  // the trees will be rebuilt anyway
+  }
+
+  bool first = false;
+  bool too_many = false;
+  {
+    std::lock_guard<std::mutex> lock(data.modified_nets_mutex_);
+    first = data.modified_nets_.empty();
+    data.modified_nets_.insert(net);
+    too_many = static_cast<int>(data.modified_nets_.size())
+               > max_incremental_nets_;
+    data.has_modified_nets_ = true;
+  }
+
+  if (too_many) {
+    clearShapes();
+  } else if (first) {
+    emit modified();
+  }
+}
+
 void Search::clearFills()
 {
   announceModified(top_block_data_.fills_init_);
@@ -245,17 +381,58 @@ Search::BlockData& Search::getData(odb::dbBlock* block)
   return block == top_block_ ? top_block_data_ : child_block_data_[block];
 }
 
+// The number of ReadGuards held by this thread.
+static thread_local int read_guards = 0;
+
+Search::ReadGuard::ReadGuard(Search& search)
+{
+  if (read_guards++ == 0) {
+    lock_ = std::shared_lock<std::shared_mutex>(search.trees_mutex_);
+  }
+}
+
+Search::ReadGuard::~ReadGuard()
+{
+  read_guards--;
+}
+
+// Waits for the readers on other threads to finish.  The lock is empty if
+// the trees must not be updated: while they are read only, or if this
+// thread holds a ReadGuard.
+std::unique_lock<std::shared_mutex> Search::lockTreesForUpdate()
+{
+  if (read_only_ || read_guards > 0) {
+    return {};
+  }
+  return std::unique_lock<std::shared_mutex>(trees_mutex_);
+}
+
 void Search::updateShapes(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
+  auto trees_lock = lockTreesForUpdate();
+  if (!trees_lock.owns_lock()) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(data.shapes_init_mutex_);
+  if (read_only_) {
+    return;  // the trees are being searched from several threads
+  }
   if (data.shapes_init_) {
-    return;  // already done by another thread
+    // already built, possibly by another thread
+    updateModifiedNets(data);
+    return;
   }
 
+  {
+    std::lock_guard<std::mutex> modified_lock(data.modified_nets_mutex_);
+    data.modified_nets_.clear();
+    data.has_modified_nets_ = false;
+  }
   data.box_shapes_.clear();
   data.snet_via_shapes_.clear();
   data.snet_shapes_.clear();
+  data.net_bboxes_.clear();
 
   LayerMap<std::vector<SNetValue<odb::dbNet*>>> snet_shapes;
   LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>> snet_net_via_shapes;
@@ -275,22 +452,19 @@ void Search::updateShapes(odb::dbBlock* block)
 
   LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>> net_shapes;
   for (odb::dbNet* net : block->getNets()) {
-    addNet(net, net_shapes);
+    const odb::Rect bbox = addNet(net, net_shapes);
+    if (!bbox.isInverted()) {
+      data.net_bboxes_[net] = bbox;
+    }
   }
 
   for (odb::dbBTerm* term : block->getBTerms()) {
-    for (odb::dbBPin* pin : term->getBPins()) {
-      odb::dbPlacementStatus status = pin->getPlacementStatus();
-      if (status == odb::dbPlacementStatus::NONE
-          || status == odb::dbPlacementStatus::UNPLACED) {
-        continue;
-      }
-      for (odb::dbBox* box : pin->getBoxes()) {
-        if (!box) {
-          continue;
-        }
-        odb::dbTechLayer* layer = box->getTechLayer();
-        net_shapes[layer].emplace_back(box->getBox(), false, term->getNet());
+    const odb::Rect bbox = addBPins(term, net_shapes);
+    odb::dbNet* net = term->getNet();
+    if (net != nullptr && !bbox.isInverted()) {
+      auto [it, inserted] = data.net_bboxes_.emplace(net, bbox);
+      if (!inserted) {
+        it->second.merge(bbox);
       }
     }
   }
@@ -299,13 +473,140 @@ void Search::updateShapes(odb::dbBlock* block)
         layer_shapes.begin(), layer_shapes.end());
   }
 
+  updateShapeDensity(data, block);
+
   data.shapes_init_ = true;
 }
 
+DensityPyramid Search::makeDensity(odb::dbBlock* block) const
+{
+  odb::Rect bounds = block->getDieArea();
+  if (bounds.area() == 0) {
+    bounds = block->getBBox()->getBox();
+  }
+  const int bin_size
+      = std::max(1, (bounds.maxDXDY() + density_bins_ - 1) / density_bins_);
+  return DensityPyramid(bounds, bin_size);
+}
+
+// Rebuilds the density of every layer from the shape trees, with the
+// layers split across the threads set for OpenROAD.  This runs on the GUI
+// or render thread, one at a time under shapes_init_mutex_.
+void Search::updateShapeDensity(BlockData& data, odb::dbBlock* block)
+{
+  data.empty_density_ = makeDensity(block);
+  data.shape_density_.clear();
+  std::vector<odb::dbTechLayer*> layers;
+  auto add_layer = [&](odb::dbTechLayer* layer) {
+    if (data.shape_density_.emplace(layer, data.empty_density_).second) {
+      layers.push_back(layer);
+    }
+  };
+  for (const auto& [layer, rtree] : data.box_shapes_) {
+    add_layer(layer);
+  }
+  for (const auto& [layer, rtree] : data.snet_shapes_) {
+    add_layer(layer);
+  }
+  for (const auto& [layer, rtree] : data.snet_via_shapes_) {
+    add_layer(layer);
+  }
+
+  const int layer_count = layers.size();
+  const int threads = std::max(
+      1, std::min(layer_count, ord::OpenRoad::openRoad()->getThreadCount()));
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+  for (int i = 0; i < layer_count; i++) {
+    odb::dbTechLayer* layer = layers[i];
+    DensityPyramid& density = data.shape_density_.at(layer);
+    auto box_it = data.box_shapes_.find(layer);
+    if (box_it != data.box_shapes_.end()) {
+      for (const auto& [box, is_via, net] : box_it->second) {
+        density.addFine(box);
+      }
+    }
+    auto snet_it = data.snet_shapes_.find(layer);
+    if (snet_it != data.snet_shapes_.end()) {
+      for (const auto& [sbox, poly, net] : snet_it->second) {
+        density.addFine(sbox->getBox());
+      }
+    }
+    // Only the cut layer of special vias is counted.
+    auto via_it = data.snet_via_shapes_.find(layer);
+    if (via_it != data.snet_via_shapes_.end()) {
+      for (const auto& [sbox, net] : via_it->second) {
+        density.addFine(sbox->getBox());
+      }
+    }
+    density.buildLevels();
+  }
+}
+
+// Replaces the routing shapes of the modified nets.  The caller must hold
+// shapes_init_mutex_.
+void Search::updateModifiedNets(BlockData& data)
+{
+  std::set<odb::dbNet*> nets;
+  {
+    std::lock_guard<std::mutex> lock(data.modified_nets_mutex_);
+    nets.swap(data.modified_nets_);
+    data.has_modified_nets_ = false;
+  }
+
+  for (odb::dbNet* net : nets) {
+    auto bbox_it = data.net_bboxes_.find(net);
+    if (bbox_it != data.net_bboxes_.end()) {
+      const odb::Rect& old_bbox = bbox_it->second;
+      std::vector<RouteBoxValue<odb::dbNet*>> old_shapes;
+      for (auto& [layer, rtree] : data.box_shapes_) {
+        old_shapes.clear();
+        rtree.query(bgi::intersects(old_bbox)
+                        && bgi::satisfies(
+                            [net](const RouteBoxValue<odb::dbNet*>& shape) {
+                              return std::get<2>(shape) == net;
+                            }),
+                    std::back_inserter(old_shapes));
+        rtree.remove(old_shapes.begin(), old_shapes.end());
+        DensityPyramid& density = data.shape_density_.at(layer);
+        for (const auto& [box, is_via, shape_net] : old_shapes) {
+          density.add(box, -1.0f);
+        }
+      }
+      data.net_bboxes_.erase(bbox_it);
+    }
+
+    // The bterm pins of the net share its entry in net_bboxes_, so they are
+    // added back too.
+    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>> net_shapes;
+    odb::Rect bbox = addNet(net, net_shapes);
+    for (odb::dbBTerm* term : net->getBTerms()) {
+      bbox.merge(addBPins(term, net_shapes));
+    }
+    for (const auto& [layer, layer_shapes] : net_shapes) {
+      data.box_shapes_[layer].insert(layer_shapes.begin(), layer_shapes.end());
+      auto [density_it, inserted]
+          = data.shape_density_.emplace(layer, data.empty_density_);
+      for (const auto& [box, is_via, shape_net] : layer_shapes) {
+        density_it->second.add(box);
+      }
+    }
+    if (!bbox.isInverted()) {
+      data.net_bboxes_[net] = bbox;
+    }
+  }
+}
+
 void Search::updateFills(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
+  auto trees_lock = lockTreesForUpdate();
+  if (!trees_lock.owns_lock()) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(data.fills_init_mutex_);
+  if (read_only_) {
+    return;  // the trees are being searched from several threads
+  }
   if (data.fills_init_) {
     return;  // already done by another thread
   }
@@ -326,7 +627,14 @@ void Search::updateFills(odb::dbBlock* block)
 void Search::updateInsts(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
+  auto trees_lock = lockTreesForUpdate();
+  if (!trees_lock.owns_lock()) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(data.insts_init_mutex_);
+  if (read_only_) {
+    return;  // the trees are being searched from several threads
+  }
   if (data.insts_init_) {
     return;  // already done by another thread
   }
@@ -341,13 +649,30 @@ void Search::updateInsts(odb::dbBlock* block)
   }
   data.insts_ = RtreeDBox<odb::dbInst*>(insts.begin(), insts.end());
 
+  data.inst_density_ = makeDensity(block);
+  const int large_height = large_inst_bins_ * data.inst_density_.getBinSize(0);
+  for (odb::dbInst* inst : insts) {
+    const odb::Rect bbox = inst->getBBox()->getBox();
+    if (bbox.dy() < large_height) {
+      data.inst_density_.addFine(bbox);
+    }
+  }
+  data.inst_density_.buildLevels();
+
   data.insts_init_ = true;
 }
 
 void Search::updateBlockages(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
+  auto trees_lock = lockTreesForUpdate();
+  if (!trees_lock.owns_lock()) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(data.blockages_init_mutex_);
+  if (read_only_) {
+    return;  // the trees are being searched from several threads
+  }
   if (data.blockages_init_) {
     return;  // already done by another thread
   }
@@ -367,7 +692,14 @@ void Search::updateBlockages(odb::dbBlock* block)
 void Search::updateObstructions(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
+  auto trees_lock = lockTreesForUpdate();
+  if (!trees_lock.owns_lock()) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(data.obstructions_init_mutex_);
+  if (read_only_) {
+    return;  // the trees are being searched from several threads
+  }
   if (data.obstructions_init_) {
     return;  // already done by another thread
   }
@@ -390,7 +722,14 @@ void Search::updateObstructions(odb::dbBlock* block)
 void Search::updateRows(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
+  auto trees_lock = lockTreesForUpdate();
+  if (!trees_lock.owns_lock()) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(data.rows_init_mutex_);
+  if (read_only_) {
+    return;  // the trees are being searched from several threads
+  }
   if (data.rows_init_) {
     return;  // already done by another thread
   }
@@ -464,14 +803,19 @@ void Search::addSNet(
   }
 }
 
-void Search::addNet(
+// Returns the bounding box of the added shapes, which is inverted if
+// there are none.
+odb::Rect Search::addNet(
     odb::dbNet* net,
     LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes)
 {
+  odb::Rect bbox;
+  bbox.mergeInit();
+
   odb::dbWire* wire = net->getWire();
 
   if (wire == nullptr) {
-    return;
+    return bbox;
   }
 
   odb::dbWireShapeItr itr;
@@ -479,11 +823,44 @@ void Search::addNet(
 
   for (itr.begin(wire); itr.next(s);) {
     if (s.isVia()) {
+      // the via's cut and enclosures are within its bbox
+      bbox.merge(s.getBox());
       addVia(net, &s, itr._prev_x, itr._prev_y, tree_shapes);
     } else {
+      bbox.merge(s.getBox());
       tree_shapes[s.getTechLayer()].emplace_back(s.getBox(), false, net);
     }
   }
+
+  return bbox;
+}
+
+// Returns the bounding box of the added shapes, which is inverted if
+// there are none.
+odb::Rect Search::addBPins(
+    odb::dbBTerm* term,
+    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes)
+{
+  odb::Rect bbox;
+  bbox.mergeInit();
+
+  for (odb::dbBPin* pin : term->getBPins()) {
+    odb::dbPlacementStatus status = pin->getPlacementStatus();
+    if (status == odb::dbPlacementStatus::NONE
+        || status == odb::dbPlacementStatus::UNPLACED) {
+      continue;
+    }
+    for (odb::dbBox* box : pin->getBoxes()) {
+      if (!box) {
+        continue;
+      }
+      odb::dbTechLayer* layer = box->getTechLayer();
+      bbox.merge(box->getBox());
+      tree_shapes[layer].emplace_back(box->getBox(), false, term->getNet());
+    }
+  }
+
+  return bbox;
 }
 
 template <typename T>
@@ -571,7 +948,7 @@ Search::RoutingRange Search::searchBoxShapes(odb::dbBlock* block,
                                              int min_size)
 {
   BlockData& data = getData(block);
-  if (!data.shapes_init_) {
+  if (!data.shapes_init_ || data.has_modified_nets_) {
     updateShapes(block);
   }
 
@@ -603,7 +980,7 @@ Search::SNetSBoxRange Search::searchSNetViaShapes(odb::dbBlock* block,
                                                   int min_size)
 {
   BlockData& data = getData(block);
-  if (!data.shapes_init_) {
+  if (!data.shapes_init_ || data.has_modified_nets_) {
     updateShapes(block);
   }
 
@@ -635,7 +1012,7 @@ Search::SNetShapeRange Search::searchSNetShapes(odb::dbBlock* block,
                                                 int min_size)
 {
   BlockData& data = getData(block);
-  if (!data.shapes_init_) {
+  if (!data.shapes_init_ || data.has_modified_nets_) {
     updateShapes(block);
   }
 
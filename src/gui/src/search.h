@@ -36,7 +36,10 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 
+#include "densityPyramid.h"
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
 #include "odb/geom.h"
@@ -51,8 +54,14 @@ namespace bgi = boost::geometry::index;
 // rtree.  OpenDB also has some code for this purpose but I
 // find it confusing so just made a simpler solution for now.
 //
-// Currently this class is static once built and doesn't follow
-// db changes.  TODO: this should be into an observer of OpenDB.
+// Changes to routed net wires are applied incrementally to the
+// routing shape trees on the next search.  Other db changes
+// invalidate the affected trees, which are rebuilt on the next search.
+//
+// The searches return ranges over the trees, so a tree must not change
+// while a range over it is in use.  The trees are only updated by the
+// searches of the render thread.  Any other thread must hold a ReadGuard
+// while it searches and uses the results.
 class Search : public QObject, public odb::dbBlockCallBackObj
 {
   Q_OBJECT
@@ -154,6 +163,32 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   // Build the structure for the given block.
   void setTopBlock(odb::dbBlock* block);
 
+  // Holds off the tree updates of other threads while the results of
+  // the searches are in use.  The searches of the thread holding it use
+  // the trees as they are and never update them.  Guards nest.
+  class ReadGuard
+  {
+   public:
+    explicit ReadGuard(Search& search);
+    ~ReadGuard();
+
+   private:
+    std::shared_lock<std::shared_mutex> lock_;
+  };
+
+  // Bring all the trees of the block up to date so that the following
+  // searches only read them.  Used before searching from several threads.
+  void updateTrees(odb::dbBlock* block);
+
+  // While read only the searches use the trees as they are and never
+  // update them, so several threads can search at once.  Enabling waits
+  // for the updates already under way.
+  void setReadOnly(bool read_only);
+
+  // True if a tree of the block is out of date, eg it changed while the
+  // searches were read only.
+  bool needsUpdate(odb::dbBlock* block);
+
   // Find all box shapes in the given bounds on the given layer which
   // are at least min_size in either dimension.
   RoutingRange searchBoxShapes(odb::dbBlock* block,
@@ -228,6 +263,25 @@ class Search : public QObject, public odb::dbBlockCallBackObj
                       int y_hi,
                       int min_height = 0);
 
+  // Copies the occupancy of the routing and special routing shapes on the
+  // given layer over bounds, from the coarsest level with bins no larger
+  // than max_bin_size.  Returns false if the layer has no shapes or its
+  // bins are too large.
+  bool searchShapeDensity(odb::dbBlock* block,
+                          odb::dbTechLayer* layer,
+                          const odb::Rect& bounds,
+                          double max_bin_size,
+                          DensityWindow& window);
+
+  // Same for the occupancy of the placed instances.  Instances at least
+  // getLargeInstHeight tall are left out as they are drawn one by one.
+  bool searchInstDensity(odb::dbBlock* block,
+                         const odb::Rect& bounds,
+                         double max_bin_size,
+                         DensityWindow& window);
+  int getInstDensityBinSize(odb::dbBlock* block);
+  int getLargeInstHeight(odb::dbBlock* block);
+
   void clearShapes();
   void clearFills();
   void clearInsts();
@@ -271,27 +325,39 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   void addSNet(odb::dbNet* net,
                LayerMap<std::vector<SNetValue<odb::dbNet*>>>& net_shapes,
                LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes);
-  void addNet(odb::dbNet* net,
-              LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes);
+  odb::Rect addNet(
+      odb::dbNet* net,
+      LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes);
   void addVia(odb::dbNet* net,
               odb::dbShape* shape,
               int x,
               int y,
               LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes);
+  odb::Rect addBPins(
+      odb::dbBTerm* term,
+      LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes);
 
+  void netModified(odb::dbNet* net);
   void updateShapes(odb::dbBlock* block);
+  void updateModifiedNets(BlockData& data);
   void updateFills(odb::dbBlock* block);
   void updateInsts(odb::dbBlock* block);
   void updateBlockages(odb::dbBlock* block);
   void updateObstructions(odb::dbBlock* block);
   void updateRows(odb::dbBlock* block);
+  void updateShapeDensity(BlockData& data, odb::dbBlock* block);
+  DensityPyramid makeDensity(odb::dbBlock* block) const;
 
   void clear();
 
   void announceModified(std::atomic_bool& flag);
   BlockData& getData(odb::dbBlock* block);
+  std::unique_lock<std::shared_mutex> lockTreesForUpdate();
 
   odb::dbBlock* top_block_{nullptr};
+  std::atomic_bool read_only_{false};
+  // Held shared by the ReadGuards and exclusively by the tree updates.
+  std::shared_mutex trees_mutex_;
 
   struct BlockData
   {
@@ -304,10 +370,21 @@ class Search : public QObject, public odb::dbBlockCallBackObj
     LayerMap<RtreeSNetShapes<odb::dbNet*>> snet_shapes_;
     std::atomic_bool shapes_init_{false};
     std::mutex shapes_init_mutex_;
+    // Bounding box of the shapes of each net in box_shapes_ so they can be
+    // found and removed when the net's wire changes.
+    std::map<odb::dbNet*, odb::Rect> net_bboxes_;
+    // Nets whose wire changed since box_shapes_ was last updated.
+    std::set<odb::dbNet*> modified_nets_;
+    std::atomic_bool has_modified_nets_{false};
+    std::mutex modified_nets_mutex_;
+    // Kept in sync with the shape trees above.
+    LayerMap<DensityPyramid> shape_density_;
+    DensityPyramid empty_density_;  // same bounds, for new layers
     LayerMap<RtreeFill> fills_;
     std::atomic_bool fills_init_{false};
     std::mutex fills_init_mutex_;
     RtreeDBox<odb::dbInst*> insts_;
+    DensityPyramid inst_density_;
     std::atomic_bool insts_init_{false};
     std::mutex insts_init_mutex_;
     RtreeDBox<odb::dbBlockage*> blockages_;
@@ -322,6 +399,15 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   };
   std::map<odb::dbBlock*, BlockData> child_block_data_;
   BlockData top_block_data_;
+
+  // Past this many modified nets it is faster to rebuild the routing
+  // shape trees than to update them net by net.
+  static constexpr int max_incremental_nets_ = 1000;
+  // Number of finest density bins along the longer side of the block.
+  static constexpr int density_bins_ = 1024;
+  // Instances this many finest bins tall are shown individually as soon as
+  // the density is drawn (see LayoutViewer::nominalViewableResolution).
+  static constexpr int large_inst_bins_ = 5;
 };
 
 }  // namespace gui
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "tileCache.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace gui {
+
+int TileCache::beginFrame(const View& view)
+{
+  const int generation = generation_;
+  if (generation != cache_generation_) {
+    views_.clear();
+    cache_generation_ = generation;
+  }
+  frame_++;
+  tiles_ = &views_[view];
+  return generation;
+}
+
+const QImage* TileCache::find(const Index& index)
+{
+  auto it = tiles_->find(index);
+  if (it == tiles_->end()) {
+    return nullptr;
+  }
+  it->second.last_used = frame_;
+  return &it->second.image;
+}
+
+void TileCache::store(const Index& index, QImage image, const int generation)
+{
+  if (generation != generation_) {
+    return;  // cleared while the tile was drawn
+  }
+  (*tiles_)[index] = {std::move(image), frame_};
+}
+
+void TileCache::evict()
+{
+  const int count = size();
+  const int max_tiles = max_tiles_;
+  if (count <= max_tiles) {
+    return;
+  }
+
+  std::vector<std::tuple<uint64_t, View, Index>> ages;
+  ages.reserve(count);
+  for (const auto& [view, tiles] : views_) {
+    for (const auto& [index, tile] : tiles) {
+      ages.emplace_back(tile.last_used, view, index);
+    }
+  }
+  std::sort(ages.begin(), ages.end());
+  for (int i = 0; i < count - max_tiles; i++) {
+    const auto& [last_used, view, index] = ages[i];
+    auto view_it = views_.find(view);
+    view_it->second.erase(index);
+    if (view_it->second.empty() && &view_it->second != tiles_) {
+      views_.erase(view_it);
+    }
+  }
+}
+
+int TileCache::size() const
+{
+  int count = 0;
+  for (const auto& [view, tiles] : views_) {
+    count += tiles.size();
+  }
+  return count;
+}
+
+}  // namespace gui
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <QImage>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace gui {
+
+// The layout tiles drawn by a render thread.  Tiles are kept per view so
+// that panning and returning to an earlier zoom only draws the tiles that
+// were never drawn.  Only the render thread uses it, except for clear and
+// setMaxTiles.
+class TileCache
+{
+ public:
+  // resolution, centering shift and viewport size
+  using View = std::tuple<qreal, int, int, int, int>;
+  using Index = std::pair<int, int>;  // column, row
+
+  // Drops all the tiles, from the next frame on.  Tiles drawn during the
+  // current frame are not kept.
+  void clear() { generation_++; }
+  void setMaxTiles(int max_tiles) { max_tiles_ = max_tiles; }
+
+  // Starts a frame drawn in view.  Returns the generation to store its
+  // tiles with.
+  int beginFrame(const View& view);
+  // The tile of the frame's view at index, or nullptr if it is not drawn.
+  const QImage* find(const Index& index);
+  // Keeps a tile drawn during the frame, unless the cache was cleared
+  // after the frame began.
+  void store(const Index& index, QImage image, int generation);
+  // Drops the least recently used tiles over the limit.
+  void evict();
+
+  int size() const;
+
+ private:
+  struct Tile
+  {
+    QImage image;
+    uint64_t last_used = 0;
+  };
+
+  std::map<View, std::map<Index, Tile>> views_;
+  std::map<Index, Tile>* tiles_ = nullptr;  // of the frame's view
+  uint64_t frame_ = 0;
+  int cache_generation_ = 0;
+  std::atomic_int generation_{0};
+  std::atomic_int max_tiles_{512};
+};
+
+}  // namespace gui
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "densityPyramid.h"
+#include "odb/geom.h"
+
+namespace gui {
+namespace {
+
+void expectEqualLevels(const DensityPyramid& a, const DensityPyramid& b)
+{
+  ASSERT_EQ(a.getLevels(), b.getLevels());
+  for (int level = 0; level < a.getLevels(); level++) {
+    ASSERT_EQ(a.getBinsX(level), b.getBinsX(level));
+    ASSERT_EQ(a.getBinsY(level), b.getBinsY(level));
+    for (int y = 0; y < a.getBinsY(level); y++) {
+      for (int x = 0; x < a.getBinsX(level); x++) {
+        EXPECT_NEAR(
+            a.getDensity(level, x, y), b.getDensity(level, x, y), 1e-5)
+            << "level " << level << " bin " << x << " " << y;
+      }
+    }
+  }
+}
+
+TEST(TestDensityPyramid, Levels)
+{
+  const DensityPyramid density(odb::Rect(0, 0, 1000, 600), 100);
+
+  // 10x6, 5x3, 3x2, 2x1, 1x1
+  ASSERT_EQ(density.getLevels(), 5);
+  EXPECT_EQ(density.getBinsX(0), 10);
+  EXPECT_EQ(density.getBinsY(0), 6);
+  EXPECT_EQ(density.getBinsX(2), 3);
+  EXPECT_EQ(density.getBinsY(2), 2);
+  EXPECT_EQ(density.getBinsX(4), 1);
+  EXPECT_EQ(density.getBinsY(4), 1);
+  EXPECT_EQ(density.getBinSize(3), 800);
+}
+
+// Adding on every level must match adding on level 0 and merging.
+TEST(TestDensityPyramid, AddMatchesBuildLevels)
+{
+  const odb::Rect bounds(-500, 200, 1730, 1190);
+  const std::vector<odb::Rect> rects = {
+      {-500, 200, -400, 300},    // lower left bin
+      {0, 500, 900, 510},        // spans several bins
+      {1600, 1100, 1730, 1190},  // upper right partial bin
+      {-800, 100, 2000, 1500},   // covers everything, clipped
+      {100, 100, 200, 150},      // outside
+      {300, 700, 300, 900},      // no area
+  };
+
+  DensityPyramid added(bounds, 64);
+  DensityPyramid built(bounds, 64);
+  for (const odb::Rect& rect : rects) {
+    added.add(rect);
+    built.addFine(rect);
+  }
+  built.buildLevels();
+
+  expectEqualLevels(added, built);
+  // The covering rect fills the bins inside the bounds
+  EXPECT_NEAR(added.getDensity(0, 5, 5), 1.0f, 1e-5);
+}
+
+TEST(TestDensityPyramid, RemoveRestoresEmpty)
+{
+  const odb::Rect bounds(0, 0, 1000, 1000);
+  const odb::Rect rect(130, 270, 810, 290);
+
+  DensityPyramid density(bounds, 100);
+  density.add(rect);
+  density.add(rect, -1.0f);
+
+  expectEqualLevels(density, DensityPyramid(bounds, 100));
+}
+
+// The search adds and removes the shapes of edited nets in place for as
+// long as the design is open.  The bins must not drift from a rebuild.
+TEST(TestDensityPyramid, ManyEditsMatchRebuild)
+{
+  const odb::Rect bounds(0, 0, 5000, 3000);
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int> x_dist(-200, 5200);
+  std::uniform_int_distribution<int> y_dist(-200, 3200);
+  std::uniform_int_distribution<int> size_dist(0, 800);
+
+  DensityPyramid edited(bounds, 40);
+  std::vector<odb::Rect> rects;
+  for (int cycle = 0; cycle < 20; cycle++) {
+    for (int i = 0; i < 200; i++) {
+      const int x = x_dist(random);
+      const int y = y_dist(random);
+      const odb::Rect rect(x, y, x + size_dist(random), y + size_dist(random));
+      rects.push_back(rect);
+      edited.add(rect);
+    }
+    // Remove every other rect, as a rerouted net drops its old shapes
+    std::vector<odb::Rect> kept;
+    for (int i = 0; i < static_cast<int>(rects.size()); i++) {
+      if (i % 2 == cycle % 2) {
+        edited.add(rects[i], -1.0f);
+      } else {
+        kept.push_back(rects[i]);
+      }
+    }
+    rects.swap(kept);
+  }
+
+  DensityPyramid rebuilt(bounds, 40);
+  for (const odb::Rect& rect : rects) {
+    rebuilt.addFine(rect);
+  }
+  rebuilt.buildLevels();
+
+  expectEqualLevels(edited, rebuilt);
+}
+
+// Edge bins extend past the bounds; only the area inside counts and it is
+// divided by the full bin area.
+TEST(TestDensityPyramid, EdgeBinClipping)
+{
+  DensityPyramid density(odb::Rect(0, 0, 1000, 600), 256);
+  ASSERT_EQ(density.getBinsX(0), 4);
+  ASSERT_EQ(density.getBinsY(0), 3);
+
+  density.add(odb::Rect(900, -100, 1100, 100));
+
+  const float bin_area = 256.0f * 256.0f;
+  EXPECT_NEAR(density.getDensity(0, 3, 0), 100 * 100 / bin_area, 1e-6);
+  EXPECT_EQ(density.getDensity(0, 2, 0), 0.0f);
+  EXPECT_EQ(density.getDensity(0, 3, 1), 0.0f);
+  EXPECT_NEAR(density.getDensity(1, 1, 0), 100 * 100 / (4 * bin_area), 1e-6);
+  EXPECT_NEAR(
+      density.getDensity(2, 0, 0), 100 * 100 / (16 * bin_area), 1e-6);
+}
+
+TEST(TestDensityPyramid, Window)
+{
+  DensityPyramid density(odb::Rect(0, 0, 1000, 1000), 100);
+  density.add(odb::Rect(200, 200, 400, 400));
+
+  DensityWindow window;
+  // The finest bins are too large
+  EXPECT_FALSE(density.getWindow(odb::Rect(0, 0, 1000, 1000), 50, window));
+  EXPECT_TRUE(window.density.empty());
+
+  // Level 1, clipped to the bounds
+  ASSERT_TRUE(
+      density.getWindow(odb::Rect(-300, 250, 450, 2000), 250, window));
+  EXPECT_EQ(window.bounds, odb::Rect(0, 200, 600, 1000));
+  ASSERT_EQ(window.bins_x, 3);
+  ASSERT_EQ(window.bins_y, 4);
+  ASSERT_EQ(window.density.size(), 12u);
+  EXPECT_NEAR(window.density[0], 0.0f, 1e-6);
+  EXPECT_NEAR(window.density[1], 1.0f, 1e-6);  // bin (1, 1) of level 1
+  EXPECT_NEAR(window.density[3], 0.0f, 1e-6);
+
+  // Outside the bounds
+  EXPECT_TRUE(density.getWindow(odb::Rect(2000, 0, 3000, 10), 100, window));
+  EXPECT_TRUE(window.density.empty());
+}
+
+}  // namespace
+}  // namespace gui
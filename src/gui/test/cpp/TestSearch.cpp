@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbWireCodec.h"
+#include "search.h"
+
+namespace gui {
+namespace {
+
+using Shape = std::tuple<int, int, int, int, bool, odb::dbNet*>;
+
+class TestSearch : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = odb::dbDatabase::create();
+    tech_ = odb::dbTech::create(db_, "tech");
+    m1_ = odb::dbTechLayer::create(tech_, "m1", odb::dbTechLayerType::ROUTING);
+    m1_->setWidth(100);
+    m2_ = odb::dbTechLayer::create(tech_, "m2", odb::dbTechLayerType::ROUTING);
+    m2_->setWidth(100);
+    odb::dbChip* chip = odb::dbChip::create(db_);
+    block_ = odb::dbBlock::create(chip, "top", tech_);
+    block_->setDieArea(odb::Rect(0, 0, 10000, 10000));
+  }
+
+  void TearDown() override { odb::dbDatabase::destroy(db_); }
+
+  odb::dbNet* makeNet(const char* name, int y)
+  {
+    odb::dbNet* net = odb::dbNet::create(block_, name);
+    route(net, m1_, 1000, y, 9000, y);
+    return net;
+  }
+
+  static void route(odb::dbNet* net,
+                    odb::dbTechLayer* layer,
+                    int x1,
+                    int y1,
+                    int x2,
+                    int y2)
+  {
+    odb::dbWire* wire = net->getWire();
+    if (wire != nullptr) {
+      odb::dbWire::destroy(wire);
+    }
+    wire = odb::dbWire::create(net);
+    odb::dbWireEncoder encoder;
+    encoder.begin(wire);
+    encoder.newPath(layer, odb::dbWireType::ROUTED);
+    encoder.addPoint(x1, y1);
+    encoder.addPoint(x2, y2);
+    encoder.end();
+  }
+
+  // The shapes on the layer, sorted so searches can be compared.
+  std::vector<Shape> shapes(Search& search, odb::dbTechLayer* layer)
+  {
+    std::vector<Shape> found;
+    for (const auto& [box, is_via, net] :
+         search.searchBoxShapes(block_, layer, 0, 0, 10000, 10000)) {
+      found.emplace_back(
+          box.xMin(), box.yMin(), box.xMax(), box.yMax(), is_via, net);
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+  }
+
+  odb::dbDatabase* db_ = nullptr;
+  odb::dbTech* tech_ = nullptr;
+  odb::dbTechLayer* m1_ = nullptr;
+  odb::dbTechLayer* m2_ = nullptr;
+  odb::dbBlock* block_ = nullptr;
+};
+
+// Wire edits are applied to the built trees in place.  The result must
+// match trees built from scratch.
+TEST_F(TestSearch, WireEditMatchesRebuild)
+{
+  odb::dbNet* a = makeNet("a", 1000);
+  odb::dbNet* b = makeNet("b", 3000);
+  makeNet("c", 5000);
+
+  Search search;
+  search.setTopBlock(block_);
+  ASSERT_EQ(shapes(search, m1_).size(), 3u);
+
+  auto expect_rebuilt = [&]() {
+    Search rebuilt;
+    rebuilt.setTopBlock(block_);
+    EXPECT_EQ(shapes(search, m1_), shapes(rebuilt, m1_));
+    EXPECT_EQ(shapes(search, m2_), shapes(rebuilt, m2_));
+  };
+
+  route(a, m1_, 2000, 7000, 8000, 7000);  // moved
+  route(b, m2_, 1000, 3000, 9000, 3000);  // changed layer
+  expect_rebuilt();
+  EXPECT_EQ(shapes(search, m1_).size(), 2u);
+  EXPECT_EQ(shapes(search, m2_).size(), 1u);
+
+  odb::dbWire::destroy(a->getWire());  // removed
+  expect_rebuilt();
+  EXPECT_EQ(shapes(search, m1_).size(), 1u);
+}
+
+// Zoomed in the routing is drawn shape by shape and zoomed out as a
+// density raster.  The raster must follow wire edits like the shapes do.
+TEST_F(TestSearch, ShapeDensityFollowsZoomAndEdits)
+{
+  odb::dbNet* a = makeNet("a", 1000);
+  odb::dbNet* b = makeNet("b", 3000);
+  makeNet("c", 5000);
+
+  Search search;
+  search.setTopBlock(block_);
+  const odb::Rect all(0, 0, 10000, 10000);
+  const int bin_size = search.getInstDensityBinSize(block_);
+  DensityWindow window;
+
+  // Bins larger than a pixel can't stand in for the shapes
+  EXPECT_FALSE(
+      search.searchShapeDensity(block_, m1_, all, bin_size - 1, window));
+  EXPECT_TRUE(search.searchShapeDensity(block_, m1_, all, bin_size, window));
+  EXPECT_FALSE(search.searchShapeDensity(block_, m2_, all, bin_size, window));
+
+  route(a, m1_, 2000, 7000, 8000, 7000);
+  route(b, m2_, 1000, 3000, 9000, 3000);
+  odb::dbWire::destroy(a->getWire());
+  route(a, m1_, 1000, 9000, 5000, 9000);
+
+  Search rebuilt;
+  rebuilt.setTopBlock(block_);
+  for (odb::dbTechLayer* layer : {m1_, m2_}) {
+    for (const int max_bin_size : {bin_size, 4 * bin_size, 10000}) {
+      DensityWindow expected;
+      ASSERT_TRUE(search.searchShapeDensity(
+          block_, layer, all, max_bin_size, window));
+      ASSERT_TRUE(rebuilt.searchShapeDensity(
+          block_, layer, all, max_bin_size, expected));
+      EXPECT_EQ(window.bounds, expected.bounds);
+      ASSERT_EQ(window.density.size(), expected.density.size());
+      for (int i = 0; i < static_cast<int>(expected.density.size()); i++) {
+        EXPECT_NEAR(window.density[i], expected.density[i], 1e-5)
+            << layer->getName() << " bin " << i;
+      }
+    }
+  }
+}
+
+// The searches of a thread holding a ReadGuard leave the trees as they
+// are, so ranges handed out earlier stay valid.
+TEST_F(TestSearch, ReadGuardHoldsOffUpdates)
+{
+  odb::dbNet* a = makeNet("a", 1000);
+
+  Search search;
+  search.setTopBlock(block_);
+  const std::vector<Shape> before = shapes(search, m1_);
+  ASSERT_EQ(before.size(), 1u);
+
+  route(a, m1_, 1000, 6000, 9000, 6000);
+  {
+    const Search::ReadGuard guard(search);
+    const Search::ReadGuard nested(search);
+    EXPECT_EQ(shapes(search, m1_), before);
+  }
+
+  Search rebuilt;
+  rebuilt.setTopBlock(block_);
+  EXPECT_NE(shapes(search, m1_), before);
+  EXPECT_EQ(shapes(search, m1_), shapes(rebuilt, m1_));
+}
+
+// A tiled frame searches read only.  An edit made meanwhile is left for
+// later: the frame sees the old shapes and the search reports it needs
+// an update, which the next frame applies.
+TEST_F(TestSearch, ReadOnlyDefersEdits)
+{
+  odb::dbNet* a = makeNet("a", 1000);
+
+  Search search;
+  search.setTopBlock(block_);
+  search.updateTrees(block_);
+  const std::vector<Shape> before = shapes(search, m1_);
+  EXPECT_FALSE(search.needsUpdate(block_));
+
+  search.setReadOnly(true);
+  route(a, m1_, 1000, 6000, 9000, 6000);
+  EXPECT_EQ(shapes(search, m1_), before);
+  EXPECT_TRUE(search.needsUpdate(block_));
+
+  search.setReadOnly(false);
+  search.updateTrees(block_);
+  EXPECT_FALSE(search.needsUpdate(block_));
+  Search rebuilt;
+  rebuilt.setTopBlock(block_);
+  EXPECT_NE(shapes(search, m1_), before);
+  EXPECT_EQ(shapes(search, m1_), shapes(rebuilt, m1_));
+}
+
+}  // namespace
+}  // namespace gui
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "tileCache.h"
+
+namespace gui {
+namespace {
+
+const TileCache::View kView{1.0, 0, 0, 800, 600};
+const TileCache::View kZoomed{0.5, 0, 0, 800, 600};
+
+QImage tile(const QColor& color)
+{
+  QImage image(8, 8, QImage::Format_ARGB32_Premultiplied);
+  image.fill(color);
+  return image;
+}
+
+// A view repaint draws the same design again, so the tiles are reused.
+TEST(TestTileCache, ViewRepaintHits)
+{
+  TileCache cache;
+  int generation = cache.beginFrame(kView);
+  EXPECT_EQ(cache.find({0, 0}), nullptr);
+  cache.store({0, 0}, tile(Qt::red), generation);
+
+  cache.beginFrame(kView);
+  const QImage* found = cache.find({0, 0});
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(found->pixelColor(0, 0), QColor(Qt::red));
+  EXPECT_EQ(cache.find({1, 0}), nullptr);
+
+  // Each view has its own tiles.
+  generation = cache.beginFrame(kZoomed);
+  EXPECT_EQ(cache.find({0, 0}), nullptr);
+  cache.store({0, 0}, tile(Qt::blue), generation);
+  cache.beginFrame(kView);
+  EXPECT_EQ(cache.find({0, 0})->pixelColor(0, 0), QColor(Qt::red));
+  EXPECT_EQ(cache.size(), 2);
+}
+
+// A full repaint means the design changed, so no tile is reused.
+TEST(TestTileCache, FullRepaintMisses)
+{
+  TileCache cache;
+  const int generation = cache.beginFrame(kView);
+  cache.store({0, 0}, tile(Qt::red), generation);
+
+  cache.clear();
+  cache.beginFrame(kView);
+  EXPECT_EQ(cache.find({0, 0}), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+// A tile drawn while the design changed may show the old design, so it is
+// dropped rather than kept for later frames.
+TEST(TestTileCache, ClearDuringFrameDropsTiles)
+{
+  TileCache cache;
+  const int generation = cache.beginFrame(kView);
+  cache.clear();
+  cache.store({0, 0}, tile(Qt::red), generation);
+  EXPECT_EQ(cache.size(), 0);
+
+  const int next = cache.beginFrame(kView);
+  EXPECT_EQ(cache.find({0, 0}), nullptr);
+  cache.store({0, 0}, tile(Qt::blue), next);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+// Over the limit the tiles used longest ago go first.
+TEST(TestTileCache, EvictsLeastRecentlyUsed)
+{
+  TileCache cache;
+  cache.setMaxTiles(2);
+
+  int generation = cache.beginFrame(kView);
+  cache.store({0, 0}, tile(Qt::red), generation);
+  cache.store({1, 0}, tile(Qt::red), generation);
+  generation = cache.beginFrame(kZoomed);
+  cache.store({0, 0}, tile(Qt::blue), generation);
+
+  cache.beginFrame(kView);
+  ASSERT_NE(cache.find({1, 0}), nullptr);
+  cache.evict();
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.find({0, 0}), nullptr);
+  EXPECT_NE(cache.find({1, 0}), nullptr);
+  cache.beginFrame(kZoomed);
+  EXPECT_NE(cache.find({0, 0}), nullptr);
+}
+
+}  // namespace
+}  // namespace gui
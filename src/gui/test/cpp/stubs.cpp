@@ -0,0 +1,16 @@
+#include "ord/OpenRoad.hh"
+
+// Stubs out the functions from OpenRoad that the search trees use.
+namespace ord {
+
+OpenRoad* OpenRoad::openRoad()
+{
+  return nullptr;
+}
+
+int OpenRoad::getThreadCount()
+{
+  return 1;
+}
+
+}  // namespace ord
@@ -1,4 +1,5 @@
 record_tests {
+  save_image_tiled
   supported
   #gui_man_tcl_check
   #gui_readme_msgs_check
@@ -0,0 +1,32 @@
+# save_image draws the layout in tiles on a thread pool.  The image must
+# not depend on the tiling, so the seams between tiles must not show.
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def gcd_nangate45.def
+
+set ::env(QT_QPA_PLATFORM) "offscreen"
+set tiled [make_result_file save_image_tiled.png]
+set single [make_result_file save_image_single.png]
+gui::show "gui::set_tile_size 256; save_image -width 1000 $tiled;\
+  gui::set_tile_size 2048; save_image -width 1000 $single; gui::hide" false
+
+proc read_png { file } {
+  set stream [open $file rb]
+  set data [read $stream]
+  close $stream
+  return $data
+}
+set tiled_data [read_png $tiled]
+set single_data [read_png $single]
+
+# The size is in the PNG header; the image spans several 256 pixel tiles
+# but only one 2048 pixel tile
+binary scan $tiled_data x16II width height
+if { $width <= 256 || $height <= 256 || $width > 2048 || $height > 2048 } {
+  puts "fail: image is $width x $height"
+} elseif { $tiled_data ne $single_data } {
+  # Both are encoded the same way so equal pixels give equal files
+  puts "fail: tiled image differs from the single tile image"
+} else {
+  puts "pass"
+}
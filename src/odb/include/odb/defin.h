@@ -70,6 +70,9 @@ class defin
   void skipBlockWires();
   void skipFillWires();
   void continueOnErrors();
+  // Builds the COMPONENTS and NETS on a separate thread while parsing when
+  // threads > 1.
+  void setThreadCount(int threads);
   void namesAreDBIDs();
   void setAssemblyMode();
   void useBlockName(const char* name);
@@ -65,6 +65,8 @@ class defout
   void setUseMasterIds(bool value);
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
+  // Formats COMPONENTS and NETS on this many threads; the output is the same.
+  void setThreadCount(int threads);
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
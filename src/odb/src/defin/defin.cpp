@@ -82,6 +82,11 @@ void defin::continueOnErrors()
   _reader->continueOnErrors();
 }
 
+void defin::setThreadCount(int threads)
+{
+  _reader->setThreadCount(threads);
+}
+
 void defin::namesAreDBIDs()
 {
   _reader->namesAreDBIDs();
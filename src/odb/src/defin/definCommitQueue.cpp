@@ -0,0 +1,321 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definCommitQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "definComponent.h"
+#include "definNet.h"
+#include "definReader.h"
+#include "odb/dbTypes.h"
+
+namespace odb {
+
+void definCommitQueue::Batch::clear()
+{
+  ops.clear();
+  strings.clear();
+}
+
+uint32_t definCommitQueue::Batch::addString(const char* str)
+{
+  const uint32_t offset = strings.size();
+  strings.append(str);
+  strings.push_back('\0');
+  return offset;
+}
+
+definCommitQueue::definCommitQueue(definReader* reader) : reader_(reader)
+{
+}
+
+definCommitQueue::~definCommitQueue()
+{
+  stop();
+}
+
+void definCommitQueue::start()
+{
+  if (isStarted()) {
+    return;
+  }
+  finished_ = false;
+  error_ = nullptr;
+  thread_ = std::thread(&definCommitQueue::run, this);
+}
+
+void definCommitQueue::add(const Type type,
+                           std::initializer_list<int> args,
+                           const char* str0,
+                           const char* str1)
+{
+  Op op{type, {0, 0, 0, 0}, 0.0, {0, 0}};
+  std::copy(args.begin(), args.end(), op.args);
+  push(op, str0, str1);
+}
+
+void definCommitQueue::addReal(const Type type,
+                               const char* name,
+                               const double value)
+{
+  Op op{type, {0, 0, 0, 0}, value, {0, 0}};
+  push(op, name, nullptr);
+}
+
+void definCommitQueue::push(Op& op, const char* str0, const char* str1)
+{
+  if (str0 != nullptr) {
+    op.str[0] = batch_.addString(str0);
+  }
+  if (str1 != nullptr) {
+    op.str[1] = batch_.addString(str1);
+  }
+  batch_.ops.push_back(op);
+
+  if (!isStarted()) {
+    execute(batch_);
+    batch_.clear();
+  } else if (batch_.ops.size() >= batch_size_) {
+    flushBatch();
+  }
+}
+
+void definCommitQueue::execute(const Batch& batch)
+{
+  definComponent* componentR = reader_->_componentR;
+  definNet* netR = reader_->_netR;
+
+  for (const Op& op : batch.ops) {
+    const int* a = op.args;
+    const char* s0 = batch.strings.c_str() + op.str[0];
+    const char* s1 = batch.strings.c_str() + op.str[1];
+    switch (op.type) {
+      case COMPONENT_BEGIN:
+        componentR->begin(s0, s1);
+        break;
+      case COMPONENT_SOURCE:
+        componentR->source(dbSourceType((dbSourceType::Value) a[0]));
+        break;
+      case COMPONENT_WEIGHT:
+        componentR->weight(a[0]);
+        break;
+      case COMPONENT_REGION:
+        componentR->region(s0);
+        break;
+      case COMPONENT_HALO:
+        componentR->halo(a[0], a[1], a[2], a[3]);
+        break;
+      case COMPONENT_PLACEMENT:
+        componentR->placement(a[0], a[1], a[2], a[3]);
+        break;
+      case COMPONENT_PROPERTY_INT:
+        componentR->property(s0, a[0]);
+        break;
+      case COMPONENT_PROPERTY_REAL:
+        componentR->property(s0, op.real);
+        break;
+      case COMPONENT_PROPERTY_STRING:
+        componentR->property(s0, s1);
+        break;
+      case COMPONENT_END:
+        componentR->end();
+        break;
+      case NET_BEGIN:
+        netR->begin(s0);
+        break;
+      case NET_USE:
+        netR->use(dbSigType((dbSigType::Value) a[0]));
+        break;
+      case NET_SOURCE:
+        netR->source(dbSourceType((dbSourceType::Value) a[0]));
+        break;
+      case NET_FIXEDBUMP:
+        netR->fixedbump();
+        break;
+      case NET_WEIGHT:
+        netR->weight(a[0]);
+        break;
+      case NET_NON_DEFAULT_RULE:
+        netR->nonDefaultRule(s0);
+        break;
+      case NET_MUSTJOIN:
+        netR->beginMustjoin(s0, s1);
+        break;
+      case NET_CONNECTION:
+        netR->connection(s0, s1);
+        break;
+      case NET_WIRE:
+        netR->wire(dbWireType((dbWireType::Value) a[0]));
+        break;
+      case NET_PATH:
+        netR->path(s0);
+        break;
+      case NET_PATH_TAPER:
+        netR->pathTaper(s0);
+        break;
+      case NET_PATH_TAPER_RULE:
+        netR->pathTaperRule(s0, s1);
+        break;
+      case NET_PATH_VIA:
+        netR->pathVia(s0);
+        break;
+      case NET_PATH_VIA_ROTATED:
+        netR->pathVia(s0, dbOrientType((dbOrientType::Value) a[0]));
+        break;
+      case NET_PATH_POINT:
+        netR->pathPoint(a[0], a[1]);
+        break;
+      case NET_PATH_POINT_EXT:
+        netR->pathPoint(a[0], a[1], a[2]);
+        break;
+      case NET_PATH_RECT:
+        netR->pathRect(a[0], a[1], a[2], a[3]);
+        break;
+      case NET_PATH_COLOR:
+        netR->pathColor(a[0]);
+        break;
+      case NET_PATH_VIA_COLOR:
+        netR->pathViaColor(a[0], a[1], a[2]);
+        break;
+      case NET_PATH_END:
+        netR->pathEnd();
+        break;
+      case NET_WIRE_END:
+        netR->wireEnd();
+        break;
+      case NET_PROPERTY_INT:
+        netR->property(s0, a[0]);
+        break;
+      case NET_PROPERTY_REAL:
+        netR->property(s0, op.real);
+        break;
+      case NET_PROPERTY_STRING:
+        netR->property(s0, s1);
+        break;
+      case NET_END:
+        netR->end();
+        break;
+      case ERROR:
+        reader_->reportError(s0);
+        break;
+    }
+  }
+}
+
+void definCommitQueue::flushBatch()
+{
+  if (batch_.empty()) {
+    return;
+  }
+  bool failed;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    has_space_.wait(lock, [this] {
+      return queue_.size() < max_batches_ || error_ != nullptr;
+    });
+    failed = error_ != nullptr;
+    if (!failed) {
+      queue_.push_back(std::move(batch_));
+    }
+  }
+  batch_.clear();
+  if (failed) {
+    // Surface the error now rather than parsing the rest of the section.
+    finish();
+  }
+  has_batch_.notify_one();
+}
+
+void definCommitQueue::finish()
+{
+  if (!isStarted()) {
+    return;
+  }
+  flushBatch();
+  stop();
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void definCommitQueue::stop()
+{
+  if (!isStarted()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+  }
+  has_batch_.notify_one();
+  thread_.join();
+  queue_.clear();
+}
+
+void definCommitQueue::run()
+{
+  while (true) {
+    Batch batch;
+    bool failed;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      has_batch_.wait(lock, [this] { return finished_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      batch = std::move(queue_.front());
+      queue_.pop_front();
+      failed = error_ != nullptr;
+    }
+    has_space_.notify_one();
+    if (failed) {
+      continue;
+    }
+    try {
+      execute(batch);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+      has_space_.notify_one();
+    }
+  }
+}
+
+}  // namespace odb
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace odb {
+
+class definReader;
+
+// Runs the db updates recorded by the COMPONENTS and NETS parser callbacks on
+// a separate thread, in the order they were recorded, so building the block
+// overlaps with parsing the rest of the section.  When the thread isn't
+// started the updates run immediately on the caller's thread.
+class definCommitQueue
+{
+ public:
+  // One definComponent or definNet call.
+  enum Type : uint8_t
+  {
+    COMPONENT_BEGIN,            // str: id, master
+    COMPONENT_SOURCE,           // arg: dbSourceType
+    COMPONENT_WEIGHT,           // arg: weight
+    COMPONENT_REGION,           // str: region
+    COMPONENT_HALO,             // arg: left, bottom, right, top
+    COMPONENT_PLACEMENT,        // arg: status, x, y, orient
+    COMPONENT_PROPERTY_INT,     // str: name; arg: value
+    COMPONENT_PROPERTY_REAL,    // str: name; real: value
+    COMPONENT_PROPERTY_STRING,  // str: name, value
+    COMPONENT_END,
+    NET_BEGIN,             // str: name
+    NET_USE,               // arg: dbSigType
+    NET_SOURCE,            // arg: dbSourceType
+    NET_FIXEDBUMP,         //
+    NET_WEIGHT,            // arg: weight
+    NET_NON_DEFAULT_RULE,  // str: rule
+    NET_MUSTJOIN,          // str: instance, pin
+    NET_CONNECTION,        // str: instance, pin
+    NET_WIRE,              // arg: dbWireType
+    NET_PATH,              // str: layer
+    NET_PATH_TAPER,        // str: layer
+    NET_PATH_TAPER_RULE,   // str: layer, rule
+    NET_PATH_VIA,          // str: via
+    NET_PATH_VIA_ROTATED,  // str: via; arg: dbOrientType
+    NET_PATH_POINT,        // arg: x, y
+    NET_PATH_POINT_EXT,    // arg: x, y, ext
+    NET_PATH_RECT,         // arg: dx1, dy1, dx2, dy2
+    NET_PATH_COLOR,        // arg: mask
+    NET_PATH_VIA_COLOR,    // arg: bottom, cut, top masks
+    NET_PATH_END,
+    NET_WIRE_END,
+    NET_PROPERTY_INT,     // str: name; arg: value
+    NET_PROPERTY_REAL,    // str: name; real: value
+    NET_PROPERTY_STRING,  // str: name, value
+    NET_END,
+    ERROR  // str: message, reported through definReader::reportError
+  };
+
+  explicit definCommitQueue(definReader* reader);
+  ~definCommitQueue();
+
+  void start();
+  bool isStarted() const { return thread_.joinable(); }
+
+  // Records a call to run after every call recorded before it.  The strings
+  // are copied.
+  void add(Type type,
+           std::initializer_list<int> args = {},
+           const char* str0 = nullptr,
+           const char* str1 = nullptr);
+  void addReal(Type type, const char* name, double value);
+
+  // Waits until every recorded call has run and stops the thread.  The first
+  // exception thrown by a call is rethrown here; the calls recorded after it
+  // are dropped.
+  void finish();
+
+ private:
+  struct Op
+  {
+    Type type;
+    int args[4];
+    double real;
+    // offsets of the strings in Batch::strings
+    uint32_t str[2];
+  };
+
+  struct Batch
+  {
+    std::vector<Op> ops;
+    std::string strings;
+
+    bool empty() const { return ops.empty(); }
+    void clear();
+    uint32_t addString(const char* str);
+  };
+
+  void push(Op& op, const char* str0, const char* str1);
+  void execute(const Batch& batch);
+  void flushBatch();
+  void stop();
+  void run();
+
+  static constexpr size_t batch_size_ = 4096;
+  static constexpr size_t max_batches_ = 16;
+
+  definReader* reader_;
+  Batch batch_;
+  std::deque<Batch> queue_;
+  std::mutex mutex_;
+  std::condition_variable has_batch_;
+  std::condition_variable has_space_;
+  bool finished_ = false;
+  // guarded by mutex_
+  std::exception_ptr error_;
+  std::thread thread_;
+};
+
+}  // namespace odb
@@ -73,11 +73,13 @@
 namespace odb {
 
 definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
+    : _commit_queue(this)
 {
   _db = db;
   _block_name = nullptr;
   parent_ = nullptr;
   _continue_on_errors = false;
+  _thread_count = 1;
   version_ = nullptr;
   hier_delimeter_ = 0;
   left_bus_delimeter_ = 0;
@@ -191,6 +193,20 @@ void definReader::continueOnErrors()
   _continue_on_errors = true;
 }
 
+void definReader::setThreadCount(int threads)
+{
+  _thread_count = threads;
+}
+
+void definReader::startCommitQueue()
+{
+  // Other modes look up existing objects while parsing, so the db must not
+  // change underneath the parser.
+  if (_thread_count > 1 && _mode == defin::DEFAULT) {
+    _commit_queue.start();
+  }
+}
+
 void definReader::replaceWires()
 {
   _netR->replaceWires();
@@ -270,6 +286,31 @@ static void handle_props(DEF_TYPE* def_obj, CALLBACK* callback)
   }
 }
 
+// Like handle_props, but the callbacks are recorded in the commit queue.
+template <typename DEF_TYPE>
+static void commit_props(definCommitQueue& queue,
+                         DEF_TYPE* def_obj,
+                         definCommitQueue::Type int_type,
+                         definCommitQueue::Type real_type,
+                         definCommitQueue::Type string_type)
+{
+  for (int i = 0; i < def_obj->numProps(); ++i) {
+    switch (def_obj->propType(i)) {
+      case 'R':
+        queue.addReal(real_type, def_obj->propName(i), def_obj->propNumber(i));
+        break;
+      case 'I':
+        queue.add(int_type, {(int) def_obj->propNumber(i)}, def_obj->propName(i));
+        break;
+      case 'S': /* fallthru */
+      case 'N': /* fallthru */
+      case 'Q':
+        queue.add(string_type, {}, def_obj->propName(i), def_obj->propValue(i));
+        break;
+    }
+  }
+}
+
 static std::string renameBlock(dbBlock* parent, const char* old_name)
 {
   int cnt = 1;
@@ -468,7 +509,6 @@ int definReader::componentsCallback(defrCallbackType_e /* unused: type */,
 {
   definReader* reader = (definReader*) data;
   CHECKBLOCK
-  definComponent* componentR = reader->_componentR;
   if (reader->_mode != defin::DEFAULT
       && reader->_block->findInst(comp->id()) == nullptr) {
     std::string modeStr
@@ -493,34 +533,59 @@ int definReader::componentsCallback(defrCallbackType_e /* unused: type */,
     UNSUPPORTED("ROUTEHALO on component is unsupported");
   }
 
-  componentR->begin(comp->id(), comp->name());
+  definCommitQueue& queue = reader->_commit_queue;
+  queue.add(definCommitQueue::COMPONENT_BEGIN, {}, comp->id(), comp->name());
   if (comp->hasSource()) {
-    componentR->source(dbSourceType(comp->source()));
+    queue.add(definCommitQueue::COMPONENT_SOURCE,
+              {dbSourceType(comp->source()).getValue()});
   }
   if (comp->hasWeight()) {
-    componentR->weight(comp->weight());
+    queue.add(definCommitQueue::COMPONENT_WEIGHT, {comp->weight()});
   }
   if (comp->hasRegionName()) {
-    componentR->region(comp->regionName());
+    queue.add(definCommitQueue::COMPONENT_REGION, {}, comp->regionName());
   }
   if (comp->hasHalo() > 0) {
     int left, bottom, right, top;
     comp->haloEdges(&left, &bottom, &right, &top);
-    componentR->halo(left, bottom, right, top);
+    queue.add(definCommitQueue::COMPONENT_HALO, {left, bottom, right, top});
   }
 
-  componentR->placement(comp->placementStatus(),
-                        comp->placementX(),
-                        comp->placementY(),
-                        comp->placementOrient());
+  queue.add(definCommitQueue::COMPONENT_PLACEMENT,
+            {comp->placementStatus(),
+             comp->placementX(),
+             comp->placementY(),
+             comp->placementOrient()});
 
-  handle_props(comp, componentR);
+  commit_props(queue,
+               comp,
+               definCommitQueue::COMPONENT_PROPERTY_INT,
+               definCommitQueue::COMPONENT_PROPERTY_REAL,
+               definCommitQueue::COMPONENT_PROPERTY_STRING);
 
-  componentR->end();
+  queue.add(definCommitQueue::COMPONENT_END);
 
   return PARSE_OK;
 }
 
+int definReader::componentsStartCallback(defrCallbackType_e /* unused: type */,
+                                         int /* unused: number */,
+                                         defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  reader->startCommitQueue();
+  return PARSE_OK;
+}
+
+int definReader::componentsEndCallback(defrCallbackType_e /* unused: type */,
+                                       void* /* unused: v */,
+                                       defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  reader->_commit_queue.finish();
+  return PARSE_OK;
+}
+
 int definReader::componentMaskShiftCallback(
     defrCallbackType_e /* unused: type */,
     defiComponentMaskShiftLayer* shiftLayers,
@@ -714,7 +779,6 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
 {
   definReader* reader = (definReader*) data;
   CHECKBLOCK
-  definNet* netR = reader->_netR;
   if (reader->_mode == defin::FLOORPLAN
       && reader->_block->findNet(net->name()) == nullptr) {
     reader->_logger->warn(
@@ -756,26 +820,28 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
     UNSUPPORTED("ESTCAP on net is unsupported");
   }
 
-  netR->begin(net->name());
+  definCommitQueue& queue = reader->_commit_queue;
+  queue.add(definCommitQueue::NET_BEGIN, {}, net->name());
 
   if (net->hasUse()) {
-    netR->use(net->use());
+    queue.add(definCommitQueue::NET_USE, {dbSigType(net->use()).getValue()});
   }
 
   if (net->hasSource()) {
-    netR->source(net->source());
+    queue.add(definCommitQueue::NET_SOURCE,
+              {dbSourceType(net->source()).getValue()});
   }
 
   if (net->hasFixedbump()) {
-    netR->fixedbump();
+    queue.add(definCommitQueue::NET_FIXEDBUMP);
   }
 
   if (net->hasWeight()) {
-    netR->weight(net->weight());
+    queue.add(definCommitQueue::NET_WEIGHT, {net->weight()});
   }
 
   if (net->hasNonDefaultRule()) {
-    netR->nonDefaultRule(net->nonDefaultRule());
+    queue.add(definCommitQueue::NET_NON_DEFAULT_RULE, {}, net->nonDefaultRule());
   }
 
   for (int i = 0; i < net->numConnections(); ++i) {
@@ -784,15 +850,18 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
     }
 
     if (net->pinIsMustJoin(i)) {
-      netR->beginMustjoin(net->instance(i), net->pin(i));
+      queue.add(
+          definCommitQueue::NET_MUSTJOIN, {}, net->instance(i), net->pin(i));
     } else {
-      netR->connection(net->instance(i), net->pin(i));
+      queue.add(
+          definCommitQueue::NET_CONNECTION, {}, net->instance(i), net->pin(i));
     }
   }
 
   for (int i = 0; i < net->numWires(); ++i) {
     defiWire* wire = net->wire(i);
-    netR->wire(wire->wireType());
+    queue.add(definCommitQueue::NET_WIRE,
+              {dbWireType(wire->wireType()).getValue()});
 
     for (int j = 0; j < wire->numPaths(); ++j) {
       defiPath* path = wire->path(j);
@@ -807,11 +876,14 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             const char* layer = path->getLayer();
             int nextId = path->next();
             if (nextId == DEFIPATH_TAPER) {
-              netR->pathTaper(layer);
+              queue.add(definCommitQueue::NET_PATH_TAPER, {}, layer);
             } else if (nextId == DEFIPATH_TAPERRULE) {
-              netR->pathTaperRule(layer, path->getTaperRule());
+              queue.add(definCommitQueue::NET_PATH_TAPER_RULE,
+                        {},
+                        layer,
+                        path->getTaperRule());
             } else {
-              netR->path(layer);
+              queue.add(definCommitQueue::NET_PATH, {}, layer);
               path->prev();  // put back the token
             }
             break;
@@ -822,10 +894,13 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             const char* viaName = path->getVia();
             int nextId = path->next();
             if (nextId == DEFIPATH_VIAROTATION) {
-              netR->pathVia(viaName,
-                            translate_orientation(path->getViaRotation()));
+              const dbOrientType orient
+                  = translate_orientation(path->getViaRotation());
+              queue.add(definCommitQueue::NET_PATH_VIA_ROTATED,
+                        {orient.getValue()},
+                        viaName);
             } else {
-              netR->pathVia(viaName);
+              queue.add(definCommitQueue::NET_PATH_VIA, {}, viaName);
               path->prev();  // put back the token
             }
             break;
@@ -835,7 +910,7 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             int x;
             int y;
             path->getPoint(&x, &y);
-            netR->pathPoint(x, y);
+            queue.add(definCommitQueue::NET_PATH_POINT, {x, y});
             break;
           }
 
@@ -844,7 +919,7 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             int y;
             int ext;
             path->getFlushPoint(&x, &y, &ext);
-            netR->pathPoint(x, y, ext);
+            queue.add(definCommitQueue::NET_PATH_POINT_EXT, {x, y, ext});
             break;
           }
 
@@ -858,7 +933,8 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             int deltaX2;
             int deltaY2;
             path->getViaRect(&deltaX1, &deltaY1, &deltaX2, &deltaY2);
-            netR->pathRect(deltaX1, deltaY1, deltaX2, deltaY2);
+            queue.add(definCommitQueue::NET_PATH_RECT,
+                      {deltaX1, deltaY1, deltaX2, deltaY2});
             break;
           }
 
@@ -867,13 +943,14 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             break;
 
           case DEFIPATH_MASK:
-            netR->pathColor(path->getMask());
+            queue.add(definCommitQueue::NET_PATH_COLOR, {path->getMask()});
             break;
 
           case DEFIPATH_VIAMASK:
-            netR->pathViaColor(path->getViaBottomMask(),
-                               path->getViaCutMask(),
-                               path->getViaTopMask());
+            queue.add(definCommitQueue::NET_PATH_VIA_COLOR,
+                      {path->getViaBottomMask(),
+                       path->getViaCutMask(),
+                       path->getViaTopMask()});
             break;
 
           default:
@@ -881,16 +958,38 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             break;
         }
       }
-      netR->pathEnd();
+      queue.add(definCommitQueue::NET_PATH_END);
     }
 
-    netR->wireEnd();
+    queue.add(definCommitQueue::NET_WIRE_END);
   }
 
-  handle_props(net, netR);
+  commit_props(queue,
+               net,
+               definCommitQueue::NET_PROPERTY_INT,
+               definCommitQueue::NET_PROPERTY_REAL,
+               definCommitQueue::NET_PROPERTY_STRING);
+
+  queue.add(definCommitQueue::NET_END);
+
+  return PARSE_OK;
+}
 
-  netR->end();
+int definReader::netsStartCallback(defrCallbackType_e /* unused: type */,
+                                   int /* unused: number */,
+                                   defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  reader->startCommitQueue();
+  return PARSE_OK;
+}
 
+int definReader::netsEndCallback(defrCallbackType_e /* unused: type */,
+                                 void* /* unused: v */,
+                                 defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  reader->_commit_queue.finish();
   return PARSE_OK;
 }
 
@@ -1680,6 +1779,17 @@ void definReader::line(int line_num)
 }
 
 void definReader::error(const char* msg)
+{
+  // Report it after the statements that are still queued, as a serial read
+  // would.
+  if (_commit_queue.isStarted()) {
+    _commit_queue.add(definCommitQueue::ERROR, {}, msg);
+    return;
+  }
+  reportError(msg);
+}
+
+void definReader::reportError(const char* msg)
 {
   _logger->warn(utl::ODB, 126, "error: {}", msg);
   ++_errors;
@@ -1863,7 +1973,9 @@ bool definReader::createBlock(const char* file)
   defrSetDividerCbk(divideCharCallback);
   defrSetDesignCbk(designCallback);
   defrSetUnitsCbk(unitsCallback);
+  defrSetComponentStartCbk(componentsStartCallback);
   defrSetComponentCbk(componentsCallback);
+  defrSetComponentEndCbk(componentsEndCallback);
   defrSetComponentMaskShiftLayerCbk(componentMaskShiftCallback);
   defrSetPinCbk(pinCallback);
   defrSetPinEndCbk(pinsEndCallback);
@@ -1873,7 +1985,9 @@ bool definReader::createBlock(const char* file)
     defrSetDieAreaCbk(dieAreaCallback);
     defrSetTrackCbk(trackCallback);
     defrSetRowCbk(rowCallback);
+    defrSetNetStartCbk(netsStartCallback);
     defrSetNetCbk(netCallback);
+    defrSetNetEndCbk(netsEndCallback);
     defrSetSNetCbk(specialNetCallback);
     defrSetViaCbk(viaCallback);
     defrSetBlockageCbk(blockageCallback);
@@ -1927,6 +2041,8 @@ bool definReader::createBlock(const char* file)
     res = defrReadGZip(f, file, (defiUserData) this);
     defGZipClose(f);
   }
+  // A parse error can end a section before its end callback.
+  _commit_queue.finish();
 
   if (res != 0 || errors() != 0) {
     if (!_continue_on_errors) {
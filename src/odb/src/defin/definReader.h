@@ -33,6 +33,7 @@
 #pragma once
 
 #include "definBase.h"
+#include "definCommitQueue.h"
 #include "defrReader.hpp"
 #include "odb/odb.h"
 
@@ -82,21 +83,27 @@ class definReader : public definBase
   std::vector<definBase*> _interfaces;
   bool _update;
   bool _continue_on_errors;
+  int _thread_count;
+  definCommitQueue _commit_queue;
   const char* _block_name;
   const char* version_;
   char hier_delimeter_;
   char left_bus_delimeter_;
   char right_bus_delimeter_;
 
+  friend class definCommitQueue;
+
   void init();
   void setLibs(std::vector<dbLib*>& lib_names);
 
   virtual void error(const char* msg);
+  void reportError(const char* msg);
   virtual void line(int line_num);
 
   void setTech(dbTech* tech);
   void setBlock(dbBlock* block);
   void setLogger(utl::Logger* logger);
+  void startCommitQueue();
 
   bool createBlock(const char* file);
   bool replaceWires(const char* file);
@@ -112,6 +119,14 @@ class definReader : public definBase
                                 defiComponent* comp,
                                 defiUserData data);
 
+  static int componentsStartCallback(defrCallbackType_e type,
+                                     int number,
+                                     defiUserData data);
+
+  static int componentsEndCallback(defrCallbackType_e type,
+                                   void* v,
+                                   defiUserData data);
+
   static int componentMaskShiftCallback(
       defrCallbackType_e type,
       defiComponentMaskShiftLayer* shiftLayers,
@@ -156,6 +171,14 @@ class definReader : public definBase
                          defiNet* net,
                          defiUserData data);
 
+  static int netsStartCallback(defrCallbackType_e type,
+                               int number,
+                               defiUserData data);
+
+  static int netsEndCallback(defrCallbackType_e type,
+                             void* v,
+                             defiUserData data);
+
   static int nonDefaultRuleCallback(defrCallbackType_e type,
                                     defiNonDefault* rule,
                                     defiUserData data);
@@ -255,6 +278,7 @@ class definReader : public definBase
   void skipBlockWires();
   void skipFillWires();
   void continueOnErrors();
+  void setThreadCount(int threads);
   void useBlockName(const char* name);
   void namesAreDBIDs();
   void setAssemblyMode();
@@ -32,33 +32,62 @@
 
 #include "defout_impl.h"
 
-#include <stdio.h>
-#include <sys/stat.h>
+#include <zlib.h>
 
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
 #include <cstdint>
 #include <limits>
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
 #include "odb/dbWireCodec.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
+#include "utl/timer.h"
 namespace odb {
 
 static const int max_name_length = 256;
 
+// Bounds on the number of objects formatted per chunk by writeChunks.
+static const int min_chunk_size = 64;
+static const int max_chunk_size = 1024;
+
+// Size of the text buffered by print before it is written to the file.
+static const size_t flush_size = 1 << 20;
+
 template <typename T>
 static std::vector<T*> sortedSet(dbSet<T>& to_sort)
 {
-  std::vector<T*> sorted(to_sort.begin(), to_sort.end());
-  std::sort(sorted.begin(), sorted.end(), [](T* a, T* b) {
-    return a->getName() < b->getName();
+  // Fetch each name once instead of twice per comparison.
+  std::vector<std::pair<std::string, T*>> named;
+  named.reserve(to_sort.size());
+  for (T* object : to_sort) {
+    named.emplace_back(object->getName(), object);
+  }
+  std::sort(named.begin(), named.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
   });
+
+  std::vector<T*> sorted;
+  sorted.reserve(named.size());
+  for (const auto& [name, object] : named) {
+    sorted.push_back(object);
+  }
   return sorted;
 }
 
+static bool hasSuffix(const std::string& str, const std::string& suffix)
+{
+  return str.size() >= suffix.size()
+         && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
 static const char* defOrient(dbOrientType orient)
 {
   switch (orient.getValue()) {
@@ -152,40 +181,40 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
 
   _dist_factor
       = (double) block->getDefUnits() / (double) block->getDbUnitsPerMicron();
-  _out = fopen(def_file, "w");
 
-  if (_out == nullptr) {
+  utl::Timer timer;
+  // .def.gz files are compressed through zlib, as used to read them.
+  if (hasSuffix(def_file, ".gz")) {
+    _gz_file = gzopen(def_file, "wb");
+  } else {
+    _file = fopen(def_file, "w");
+  }
+
+  if (_file == nullptr && _gz_file == nullptr) {
     _logger->warn(
         utl::ODB, 172, "Cannot open DEF file ({}) for writing", def_file);
     return false;
   }
-
-  // By default C File*'s are line buffered which means they get dumped on every
-  // newline, which is nominally pretty expensive. This makes it so that the
-  // writes are buffered according to the block size which on modern systems can
-  // be as much as 16kb. DEF's have a lot of newlines, and are large in size
-  // which makes writing them really slow with line buffering.
-  //
-  // The following lines enable IO buffering based on disk block size.
-  struct stat stats;
-  fstat(fileno(_out), &stats);
-  setvbuf(_out, nullptr, _IOFBF, stats.st_blksize);
+  _out.clear();
+  _out.reserve(flush_size + 4096);
+  _bytes_written = 0;
+  _write_failed = false;
 
   if (_version == defout::DEF_5_3) {
-    fprintf(_out, "VERSION 5.3 ;\n");
+    print("VERSION 5.3 ;\n");
   } else if (_version == defout::DEF_5_4) {
-    fprintf(_out, "VERSION 5.4 ;\n");
+    print("VERSION 5.4 ;\n");
   } else if (_version == defout::DEF_5_5) {
-    fprintf(_out, "VERSION 5.5 ;\n");
+    print("VERSION 5.5 ;\n");
   } else if (_version == defout::DEF_5_6) {
-    fprintf(_out, "VERSION 5.6 ;\n");
+    print("VERSION 5.6 ;\n");
   } else if (_version == defout::DEF_5_7) {
-    fprintf(_out, "VERSION 5.7 ;\n");
+    print("VERSION 5.7 ;\n");
   } else if (_version == defout::DEF_5_8) {
-    fprintf(_out, "VERSION 5.8 ;\n");
+    print("VERSION 5.8 ;\n");
   }
   if (_version < defout::DEF_5_6) {
-    fprintf(_out, "NAMESCASESENSITIVE ON ;\n");
+    print("NAMESCASESENSITIVE ON ;\n");
   }
   char hd = block->getHierarchyDelimeter();
 
@@ -193,7 +222,7 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
     hd = '|';
   }
 
-  fprintf(_out, "DIVIDERCHAR \"%c\" ;\n", hd);
+  print("DIVIDERCHAR \"%c\" ;\n", hd);
 
   char left_bus, right_bus;
   block->getBusDelimeters(left_bus, right_bus);
@@ -203,12 +232,12 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
     right_bus = ']';
   }
 
-  fprintf(_out, "BUSBITCHARS \"%c%c\" ;\n", left_bus, right_bus);
+  print("BUSBITCHARS \"%c%c\" ;\n", left_bus, right_bus);
 
   std::string bname = block->getName();
-  fprintf(_out, "DESIGN %s ;\n", bname.c_str());
+  print("DESIGN %s ;\n", bname.c_str());
 
-  fprintf(_out, "UNITS DISTANCE MICRONS %d ;\n", block->getDefUnits());
+  print("UNITS DISTANCE MICRONS %d ;\n", block->getDefUnits());
 
   writePropertyDefinitions(block);
 
@@ -220,7 +249,7 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   int y2 = defdist(r.yMax());
 
   if ((x1 != 0) || (y1 != 0) || (x2 != 0) || (y2 != 0)) {
-    fprintf(_out, "DIEAREA ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
+    print("DIEAREA ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
   }
 
   writeRows(block);
@@ -240,17 +269,91 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   writeNets(block);
   writeGroups(block);
 
-  fprintf(_out, "END DESIGN\n");
-  fclose(_out);
+  print("END DESIGN\n");
+  flush();
+  if (_gz_file != nullptr) {
+    if (gzclose(_gz_file) != Z_OK) {
+      _write_failed = true;
+    }
+    _gz_file = nullptr;
+  } else {
+    if (fclose(_file) != 0) {
+      _write_failed = true;
+    }
+    _file = nullptr;
+  }
+  _out.clear();
+  _out.shrink_to_fit();
+
+  const double mbytes = _bytes_written / 1048576.0;
+  const double seconds = timer.elapsed();
+  debugPrint(_logger,
+             utl::ODB,
+             "defout",
+             1,
+             "Wrote {} ({:.1f} MB) in {:.2f} s, {:.1f} MB/s",
+             def_file,
+             mbytes,
+             seconds,
+             seconds > 0 ? mbytes / seconds : 0.0);
   {
     delete _select_net_map;
   }
   {
     delete _select_inst_map;
   }
+  if (_write_failed) {
+    _logger->warn(utl::ODB, 441, "Failed to write DEF file ({})", def_file);
+    return false;
+  }
   return true;
 }
 
+void defout_impl::print(const char* format, ...)
+{
+  // Format in place after the buffered text, growing the buffer and
+  // formatting again in the rare case the text does not fit.
+  const size_t offset = _out.size();
+  const size_t avail = 256;
+  _out.resize(offset + avail);
+  va_list args;
+  va_start(args, format);
+  va_list retry_args;
+  va_copy(retry_args, args);
+  const int size = vsnprintf(&_out[offset], avail, format, args);
+  if (size >= (int) avail) {
+    _out.resize(offset + size + 1);
+    vsnprintf(&_out[offset], size + 1, format, retry_args);
+  }
+  va_end(retry_args);
+  va_end(args);
+  _out.resize(offset + std::max(size, 0));
+
+  if (_out.size() >= flush_size && (_file != nullptr || _gz_file != nullptr)) {
+    flush();
+  }
+}
+
+void defout_impl::flush()
+{
+  writeOut(_out);
+  _out.clear();
+}
+
+void defout_impl::writeOut(const std::string& text)
+{
+  if (text.empty() || _write_failed) {
+    return;
+  }
+  if (_gz_file != nullptr) {
+    _write_failed
+        = gzwrite(_gz_file, text.data(), text.size()) != (int) text.size();
+  } else {
+    _write_failed = fwrite(text.data(), 1, text.size(), _file) != text.size();
+  }
+  _bytes_written += text.size();
+}
+
 void defout_impl::writeRows(dbBlock* block)
 {
   dbSet<dbRow> rows = block->getRows();
@@ -266,26 +369,25 @@ void defout_impl::writeRows(dbBlock* block)
     std::string sn = site->getName();
     const char* o = defOrient(row->getOrient());
 
-    fprintf(_out,
-            "ROW %s %s %d %d %s ",
-            n.c_str(),
-            sn.c_str(),
-            defdist(origin.x()),
-            defdist(origin.y()),
-            o);
+    print("ROW %s %s %d %d %s ",
+          n.c_str(),
+          sn.c_str(),
+          defdist(origin.x()),
+          defdist(origin.y()),
+          o);
 
     if (row->getDirection() == dbRowDir::VERTICAL) {
-      fprintf(_out, "DO 1 BY %d STEP 0 %d", c, defdist(s));
+      print("DO 1 BY %d STEP 0 %d", c, defdist(s));
     } else {
-      fprintf(_out, "DO %d BY 1 STEP %d 0", c, defdist(s));
+      print("DO %d BY 1 STEP %d 0", c, defdist(s));
     }
 
     if (hasProperties(row, ROW)) {
-      fprintf(_out, " + PROPERTY ");
+      print(" + PROPERTY ");
       writeProperties(row);
     }
 
-    fprintf(_out, " ;\n");
+    print(" ;\n");
   }
 }
 
@@ -308,23 +410,21 @@ void defout_impl::writeTracks(dbBlock* block)
     for (int i = 0; i < grid->getNumGridPatternsX(); ++i) {
       int orgX, count, step;
       grid->getGridPatternX(i, orgX, count, step);
-      fprintf(_out,
-              "TRACKS X %d DO %d STEP %d LAYER %s ;\n",
-              defdist(orgX),
-              count,
-              defdist(step),
-              lname.c_str());
+      print("TRACKS X %d DO %d STEP %d LAYER %s ;\n",
+            defdist(orgX),
+            count,
+            defdist(step),
+            lname.c_str());
     }
 
     for (int i = 0; i < grid->getNumGridPatternsY(); ++i) {
       int orgY, count, step;
       grid->getGridPatternY(i, orgY, count, step);
-      fprintf(_out,
-              "TRACKS Y %d DO %d STEP %d LAYER %s ;\n",
-              defdist(orgY),
-              count,
-              defdist(step),
-              lname.c_str());
+      print("TRACKS Y %d DO %d STEP %d LAYER %s ;\n",
+            defdist(orgY),
+            count,
+            defdist(step),
+            lname.c_str());
     }
   }
 }
@@ -342,21 +442,19 @@ void defout_impl::writeGCells(dbBlock* block)
   for (i = 0; i < grid->getNumGridPatternsX(); ++i) {
     int orgX, count, step;
     grid->getGridPatternX(i, orgX, count, step);
-    fprintf(_out,
-            "GCELLGRID X %d DO %d STEP %d ;\n",
-            defdist(orgX),
-            count,
-            defdist(step));
+    print("GCELLGRID X %d DO %d STEP %d ;\n",
+          defdist(orgX),
+          count,
+          defdist(step));
   }
 
   for (i = 0; i < grid->getNumGridPatternsY(); ++i) {
     int orgY, count, step;
     grid->getGridPatternY(i, orgY, count, step);
-    fprintf(_out,
-            "GCELLGRID Y %d DO %d STEP %d ;\n",
-            defdist(orgY),
-            count,
-            defdist(step));
+    print("GCELLGRID Y %d DO %d STEP %d ;\n",
+          defdist(orgY),
+          count,
+          defdist(step));
   }
 }
 
@@ -381,7 +479,7 @@ void defout_impl::writeVias(dbBlock* block)
     ++cnt;
   }
 
-  fprintf(_out, "VIAS %u ;\n", cnt);
+  print("VIAS %u ;\n", cnt);
 
   for (itr = vias.begin(); itr != vias.end(); ++itr) {
     dbVia* via = *itr;
@@ -393,69 +491,63 @@ void defout_impl::writeVias(dbBlock* block)
     writeVia(via);
   }
 
-  fprintf(_out, "END VIAS\n");
+  print("END VIAS\n");
 }
 
 void defout_impl::writeVia(dbVia* via)
 {
   std::string vname = via->getName();
-  fprintf(_out, "    - %s", vname.c_str());
+  print("    - %s", vname.c_str());
   dbTechViaGenerateRule* rule = via->getViaGenerateRule();
 
   if ((_version >= defout::DEF_5_6) && via->hasParams() && (rule != nullptr)) {
     std::string rname = rule->getName();
-    fprintf(_out, " + VIARULE %s", rname.c_str());
+    print(" + VIARULE %s", rname.c_str());
 
     const dbViaParams P = via->getViaParams();
 
-    fprintf(_out,
-            " + CUTSIZE %d %d ",
-            defdist(P.getXCutSize()),
-            defdist(P.getYCutSize()));
+    print(" + CUTSIZE %d %d ",
+          defdist(P.getXCutSize()),
+          defdist(P.getYCutSize()));
     std::string top = P.getTopLayer()->getName();
     std::string bot = P.getBottomLayer()->getName();
     std::string cut = P.getCutLayer()->getName();
-    fprintf(_out, " + LAYERS %s %s %s ", bot.c_str(), cut.c_str(), top.c_str());
-    fprintf(_out,
-            " + CUTSPACING %d %d ",
-            defdist(P.getXCutSpacing()),
-            defdist(P.getYCutSpacing()));
-    fprintf(_out,
-            " + ENCLOSURE %d %d %d %d ",
-            defdist(P.getXBottomEnclosure()),
-            defdist(P.getYBottomEnclosure()),
-            defdist(P.getXTopEnclosure()),
-            defdist(P.getYTopEnclosure()));
+    print(" + LAYERS %s %s %s ", bot.c_str(), cut.c_str(), top.c_str());
+    print(" + CUTSPACING %d %d ",
+          defdist(P.getXCutSpacing()),
+          defdist(P.getYCutSpacing()));
+    print(" + ENCLOSURE %d %d %d %d ",
+          defdist(P.getXBottomEnclosure()),
+          defdist(P.getYBottomEnclosure()),
+          defdist(P.getXTopEnclosure()),
+          defdist(P.getYTopEnclosure()));
 
     if ((P.getNumCutRows() != 1) || (P.getNumCutCols() != 1)) {
-      fprintf(_out, " + ROWCOL %d %d ", P.getNumCutRows(), P.getNumCutCols());
+      print(" + ROWCOL %d %d ", P.getNumCutRows(), P.getNumCutCols());
     }
 
     if ((P.getXOrigin() != 0) || (P.getYOrigin() != 0)) {
-      fprintf(_out,
-              " + ORIGIN %d %d ",
-              defdist(P.getXOrigin()),
-              defdist(P.getYOrigin()));
+      print(
+          " + ORIGIN %d %d ", defdist(P.getXOrigin()), defdist(P.getYOrigin()));
     }
 
     if ((P.getXTopOffset() != 0) || (P.getYTopOffset() != 0)
         || (P.getXBottomOffset() != 0) || (P.getYBottomOffset() != 0)) {
-      fprintf(_out,
-              " + OFFSET %d %d %d %d ",
-              defdist(P.getXBottomOffset()),
-              defdist(P.getYBottomOffset()),
-              defdist(P.getXTopOffset()),
-              defdist(P.getYTopOffset()));
+      print(" + OFFSET %d %d %d %d ",
+            defdist(P.getXBottomOffset()),
+            defdist(P.getYBottomOffset()),
+            defdist(P.getXTopOffset()),
+            defdist(P.getYTopOffset()));
     }
 
     std::string pname = via->getPattern();
     if (strcmp(pname.c_str(), "") != 0) {
-      fprintf(_out, " + PATTERNNAME %s", pname.c_str());
+      print(" + PATTERNNAME %s", pname.c_str());
     }
   } else {
     std::string pname = via->getPattern();
     if (strcmp(pname.c_str(), "") != 0) {
-      fprintf(_out, " + PATTERNNAME %s", pname.c_str());
+      print(" + PATTERNNAME %s", pname.c_str());
     }
 
     int i = 0;
@@ -477,20 +569,14 @@ void defout_impl::writeVia(dbVia* via)
       int y2 = defdist(box->yMax());
 
       if ((++i & 7) == 0) {
-        fprintf(_out, "\n      ");
+        print("\n      ");
       }
 
-      fprintf(_out,
-              " + RECT %s ( %d %d ) ( %d %d )",
-              lname.c_str(),
-              x1,
-              y1,
-              x2,
-              y2);
+      print(" + RECT %s ( %d %d ) ( %d %d )", lname.c_str(), x1, y1, x2, y2);
     }
   }
 
-  fprintf(_out, " ;\n");
+  print(" ;\n");
 }
 
 void defout_impl::writeComponentMaskShift(dbBlock* block)
@@ -501,28 +587,87 @@ void defout_impl::writeComponentMaskShift(dbBlock* block)
     return;
   }
 
-  fprintf(_out, "COMPONENTMASKSHIFT ");
+  print("COMPONENTMASKSHIFT ");
   for (dbTechLayer* layer : layers) {
-    fprintf(_out, "%s ", layer->getConstName());
+    print("%s ", layer->getConstName());
   }
-  fprintf(_out, ";\n");
+  print(";\n");
 }
 
 void defout_impl::writeInsts(dbBlock* block)
 {
   dbSet<dbInst> insts = block->getInsts();
 
-  fprintf(_out, "COMPONENTS %u ;\n", insts.size());
+  print("COMPONENTS %u ;\n", insts.size());
 
   // Sort the components for consistent output
+  std::vector<dbInst*> sorted_insts;
   for (dbInst* inst : sortedSet(insts)) {
     if (_select_inst_map && !(*_select_inst_map)[inst]) {
       continue;
     }
-    writeInst(inst);
+    sorted_insts.push_back(inst);
   }
+  writeChunks(sorted_insts, &defout_impl::writeInst);
 
-  fprintf(_out, "END COMPONENTS\n");
+  print("END COMPONENTS\n");
+}
+
+// Formats the objects in chunks on _thread_count threads, each chunk into its
+// own string, and writes the chunks to the file in order so the output is the
+// same as writing the objects one after the other.  Each thread formats
+// through its own copy of the writer as writeNet keeps per-net state in
+// members.  The chunks are sized so every thread gets several of them and are
+// written out in waves to bound the memory held.
+template <typename T>
+void defout_impl::writeChunks(const std::vector<T*>& objects,
+                              void (defout_impl::*write)(T*))
+{
+  const int wave_size = _thread_count * 4;
+  const size_t chunk_size = std::clamp(objects.size() / wave_size,
+                                       (size_t) min_chunk_size,
+                                       (size_t) max_chunk_size);
+  const int chunk_cnt = (objects.size() + chunk_size - 1) / chunk_size;
+  if (_thread_count <= 1 || chunk_cnt <= 1) {
+    for (T* object : objects) {
+      (this->*write)(object);
+    }
+    return;
+  }
+
+  flush();
+  std::vector<std::string> chunks(wave_size);
+  utl::ThreadException exception;
+#pragma omp parallel num_threads(_thread_count)
+  {
+    // The copy only buffers its chunk; it never writes to the file.
+    defout_impl writer(*this);
+    writer._file = nullptr;
+    writer._gz_file = nullptr;
+    for (int first = 0; first < chunk_cnt; first += wave_size) {
+      const int last = std::min(first + wave_size, chunk_cnt);
+#pragma omp for schedule(dynamic)
+      for (int i = first; i < last; i++) {
+        writer._out.clear();
+        try {
+          const size_t end = std::min(objects.size(), (i + 1) * chunk_size);
+          for (size_t j = i * chunk_size; j < end; j++) {
+            (writer.*write)(objects[j]);
+          }
+        } catch (...) {
+          exception.capture();
+        }
+        chunks[i - first].swap(writer._out);
+      }
+#pragma omp single
+      if (!exception.hasException()) {
+        for (int i = first; i < last; i++) {
+          writeOut(chunks[i - first]);
+        }
+      }
+    }
+  }
+  exception.rethrow();
 }
 
 void defout_impl::writeNonDefaultRules(dbBlock* block)
@@ -533,7 +678,7 @@ void defout_impl::writeNonDefaultRules(dbBlock* block)
     return;
   }
 
-  fprintf(_out, "NONDEFAULTRULES %u ;\n", rules.size());
+  print("NONDEFAULTRULES %u ;\n", rules.size());
 
   dbSet<dbTechNonDefaultRule>::iterator itr;
 
@@ -542,16 +687,16 @@ void defout_impl::writeNonDefaultRules(dbBlock* block)
     writeNonDefaultRule(rule);
   }
 
-  fprintf(_out, "END NONDEFAULTRULES\n");
+  print("END NONDEFAULTRULES\n");
 }
 
 void defout_impl::writeNonDefaultRule(dbTechNonDefaultRule* rule)
 {
   std::string name = rule->getName();
-  fprintf(_out, "    - %s\n", name.c_str());
+  print("    - %s\n", name.c_str());
 
   if (rule->getHardSpacing()) {
-    fprintf(_out, "      + HARDSPACING\n");
+    print("      + HARDSPACING\n");
   }
 
   std::vector<dbTechLayerRule*> layer_rules;
@@ -569,7 +714,7 @@ void defout_impl::writeNonDefaultRule(dbTechNonDefaultRule* rule)
   for (uvitr = use_vias.begin(); uvitr != use_vias.end(); ++uvitr) {
     dbTechVia* via = *uvitr;
     std::string vname = via->getName();
-    fprintf(_out, "      + VIA %s\n", vname.c_str());
+    print("      + VIA %s\n", vname.c_str());
   }
 
   std::vector<dbTechViaGenerateRule*> use_rules;
@@ -579,7 +724,7 @@ void defout_impl::writeNonDefaultRule(dbTechNonDefaultRule* rule)
   for (uvritr = use_rules.begin(); uvritr != use_rules.end(); ++uvritr) {
     dbTechViaGenerateRule* rule = *uvritr;
     std::string rname = rule->getName();
-    fprintf(_out, "      + VIARULE %s\n", rname.c_str());
+    print("      + VIARULE %s\n", rname.c_str());
   }
 
   dbTech* tech = rule->getDb()->getTech();
@@ -592,16 +737,16 @@ void defout_impl::writeNonDefaultRule(dbTechNonDefaultRule* rule)
 
     if (rule->getMinCuts(layer, count)) {
       std::string lname = layer->getName();
-      fprintf(_out, "      + MINCUTS %s %d\n", lname.c_str(), count);
+      print("      + MINCUTS %s %d\n", lname.c_str(), count);
     }
   }
 
   if (hasProperties(rule, NONDEFAULTRULE)) {
-    fprintf(_out, "    + PROPERTY ");
+    print("    + PROPERTY ");
     writeProperties(rule);
   }
 
-  fprintf(_out, "    ;\n");
+  print("    ;\n");
 }
 
 void defout_impl::writeLayerRule(dbTechLayerRule* rule)
@@ -609,19 +754,19 @@ void defout_impl::writeLayerRule(dbTechLayerRule* rule)
   dbTechLayer* layer = rule->getLayer();
   std::string name = layer->getName();
 
-  fprintf(_out, "      + LAYER %s", name.c_str());
+  print("      + LAYER %s", name.c_str());
 
-  fprintf(_out, " WIDTH %d", defdist(rule->getWidth()));
+  print(" WIDTH %d", defdist(rule->getWidth()));
 
   if (rule->getSpacing()) {
-    fprintf(_out, " SPACING %d", defdist(rule->getSpacing()));
+    print(" SPACING %d", defdist(rule->getSpacing()));
   }
 
   if (rule->getWireExtension() != 0.0) {
-    fprintf(_out, " WIREEXTENSION %d", defdist(rule->getWireExtension()));
+    print(" WIREEXTENSION %d", defdist(rule->getWireExtension()));
   }
 
-  fprintf(_out, "\n");
+  print("\n");
 }
 
 void defout_impl::writeInst(dbInst* inst)
@@ -631,16 +776,16 @@ void defout_impl::writeInst(dbInst* inst)
 
   if (_use_net_inst_ids) {
     if (_use_master_ids) {
-      fprintf(_out, "    - I%u M%u", inst->getId(), master->getMasterId());
+      print("    - I%u M%u", inst->getId(), master->getMasterId());
     } else {
-      fprintf(_out, "    - I%u %s", inst->getId(), mname.c_str());
+      print("    - I%u %s", inst->getId(), mname.c_str());
     }
   } else {
     std::string iname = inst->getName();
     if (_use_master_ids) {
-      fprintf(_out, "    - %s M%u", iname.c_str(), master->getMasterId());
+      print("    - %s M%u", iname.c_str(), master->getMasterId());
     } else {
-      fprintf(_out, "    - %s %s", iname.c_str(), mname.c_str());
+      print("    - %s %s", iname.c_str(), mname.c_str());
     }
   }
 
@@ -651,19 +796,19 @@ void defout_impl::writeInst(dbInst* inst)
       break;
 
     case dbSourceType::NETLIST:
-      fprintf(_out, " + SOURCE NETLIST");
+      print(" + SOURCE NETLIST");
       break;
 
     case dbSourceType::DIST:
-      fprintf(_out, " + SOURCE DIST");
+      print(" + SOURCE DIST");
       break;
 
     case dbSourceType::USER:
-      fprintf(_out, " + SOURCE USER");
+      print(" + SOURCE USER");
       break;
 
     case dbSourceType::TIMING:
-      fprintf(_out, " + SOURCE TIMING");
+      print(" + SOURCE TIMING");
       break;
 
     case dbSourceType::TEST:
@@ -683,30 +828,30 @@ void defout_impl::writeInst(dbInst* inst)
       break;
 
     case dbPlacementStatus::UNPLACED: {
-      fprintf(_out, " + UNPLACED");
+      print(" + UNPLACED");
       break;
     }
 
     case dbPlacementStatus::SUGGESTED:
     case dbPlacementStatus::PLACED: {
-      fprintf(_out, " + PLACED ( %d %d ) %s", x, y, orient);
+      print(" + PLACED ( %d %d ) %s", x, y, orient);
       break;
     }
 
     case dbPlacementStatus::LOCKED:
     case dbPlacementStatus::FIRM: {
-      fprintf(_out, " + FIXED ( %d %d ) %s", x, y, orient);
+      print(" + FIXED ( %d %d ) %s", x, y, orient);
       break;
     }
 
     case dbPlacementStatus::COVER: {
-      fprintf(_out, " + COVER ( %d %d ) %s", x, y, orient);
+      print(" + COVER ( %d %d ) %s", x, y, orient);
       break;
     }
   }
 
   if (inst->getWeight() != 0) {
-    fprintf(_out, " + WEIGHT %d", inst->getWeight());
+    print(" + WEIGHT %d", inst->getWeight());
   }
 
   dbRegion* region = inst->getRegion();
@@ -714,12 +859,12 @@ void defout_impl::writeInst(dbInst* inst)
   if (region) {
     if (!region->getBoundaries().empty()) {
       std::string rname = region->getName();
-      fprintf(_out, " + REGION %s", rname.c_str());
+      print(" + REGION %s", rname.c_str());
     }
   }
 
   if (hasProperties(inst, COMPONENT)) {
-    fprintf(_out, " + PROPERTY ");
+    print(" + PROPERTY ");
     writeProperties(inst);
   }
 
@@ -732,11 +877,11 @@ void defout_impl::writeInst(dbInst* inst)
       int right = defdist(box->xMax());
       int top = defdist(box->yMax());
 
-      fprintf(_out, " + HALO %d %d %d %d", left, bottom, right, top);
+      print(" + HALO %d %d %d %d", left, bottom, right, top);
     }
   }
 
-  fprintf(_out, " ;\n");
+  print(" ;\n");
 }
 
 void defout_impl::writeBTerms(dbBlock* block)
@@ -762,7 +907,7 @@ void defout_impl::writeBTerms(dbBlock* block)
     ++n;
   }
 
-  fprintf(_out, "PINS %u ;\n", n);
+  print("PINS %u ;\n", n);
 
   for (dbBTerm* bterm : sortedSet(bterms)) {
     dbNet* net = bterm->getNet();
@@ -772,7 +917,7 @@ void defout_impl::writeBTerms(dbBlock* block)
     writeBTerm(bterm);
   }
 
-  fprintf(_out, "END PINS\n");
+  print("END PINS\n");
 }
 
 void defout_impl::writeRegions(dbBlock* block)
@@ -796,7 +941,7 @@ void defout_impl::writeRegions(dbBlock* block)
     return;
   }
 
-  fprintf(_out, "REGIONS %u ;\n", cnt);
+  print("REGIONS %u ;\n", cnt);
 
   for (itr = regions.begin(); itr != regions.end(); ++itr) {
     dbRegion* region = *itr;
@@ -808,7 +953,7 @@ void defout_impl::writeRegions(dbBlock* block)
     }
 
     std::string name = region->getName();
-    fprintf(_out, "    - %s", name.c_str());
+    print("    - %s", name.c_str());
 
     dbSet<dbBox>::iterator bitr;
     int cnt = 0;
@@ -817,15 +962,14 @@ void defout_impl::writeRegions(dbBlock* block)
       dbBox* box = *bitr;
 
       if ((cnt & 0x3) == 0x3) {
-        fprintf(_out, "\n        ");
+        print("\n        ");
       }
 
-      fprintf(_out,
-              " ( %d %d ) ( %d %d )",
-              defdist(box->xMin()),
-              defdist(box->yMin()),
-              defdist(box->xMax()),
-              defdist(box->yMax()));
+      print(" ( %d %d ) ( %d %d )",
+            defdist(box->xMin()),
+            defdist(box->yMin()),
+            defdist(box->xMax()),
+            defdist(box->yMax()));
     }
 
     switch ((dbRegionType::Value) region->getRegionType()) {
@@ -833,23 +977,23 @@ void defout_impl::writeRegions(dbBlock* block)
         break;
 
       case dbRegionType::EXCLUSIVE:
-        fprintf(_out, " + TYPE FENCE");
+        print(" + TYPE FENCE");
         break;
 
       case dbRegionType::SUGGESTED:
-        fprintf(_out, " + TYPE GUIDE");
+        print(" + TYPE GUIDE");
         break;
     }
 
     if (hasProperties(region, REGION)) {
-      fprintf(_out, " + PROPERTY ");
+      print(" + PROPERTY ");
       writeProperties(region);
     }
 
-    fprintf(_out, " ;\n");
+    print(" ;\n");
   }
 
-  fprintf(_out, "END REGIONS\n");
+  print("END REGIONS\n");
 }
 
 void defout_impl::writeGroups(dbBlock* block)
@@ -864,14 +1008,14 @@ void defout_impl::writeGroups(dbBlock* block)
   if (cnt == 0) {
     return;
   }
-  fprintf(_out, "GROUPS %u ;\n", cnt);
+  print("GROUPS %u ;\n", cnt);
 
   for (auto group : groups) {
     if (group->getInsts().empty()) {
       continue;
     }
     std::string name = group->getName();
-    fprintf(_out, "    - %s", name.c_str());
+    print("    - %s", name.c_str());
 
     dbSet<dbInst> insts = group->getInsts();
     dbSet<dbInst>::iterator iitr;
@@ -881,12 +1025,12 @@ void defout_impl::writeGroups(dbBlock* block)
       dbInst* inst = *iitr;
 
       if ((cnt & 0x3) == 0x3) {
-        fprintf(_out, "\n        ");
+        print("\n        ");
       }
 
       std::string name = inst->getName();
 
-      fprintf(_out, " %s", name.c_str());
+      print(" %s", name.c_str());
     }
 
     dbRegion* parent = group->getRegion();
@@ -898,19 +1042,19 @@ void defout_impl::writeGroups(dbBlock* block)
 
       if (!rboxes.empty()) {
         std::string rname = parent->getName();
-        fprintf(_out, " + REGION %s", rname.c_str());
+        print(" + REGION %s", rname.c_str());
       }
     }
 
     if (hasProperties(group, GROUP)) {
-      fprintf(_out, " + PROPERTY ");
+      print(" + PROPERTY ");
       writeProperties(group);
     }
 
-    fprintf(_out, " ;\n");
+    print(" ;\n");
   }
 
-  fprintf(_out, "END GROUPS\n");
+  print("END GROUPS\n");
 }
 
 void defout_impl::writeBTerm(dbBTerm* bterm)
@@ -928,7 +1072,7 @@ void defout_impl::writeBTerm(dbBTerm* bterm)
         writeBPin(*itr, cnt++);
       }
 
-      fprintf(_out, " ;\n");
+      print(" ;\n");
 
       return;
     }
@@ -936,38 +1080,38 @@ void defout_impl::writeBTerm(dbBTerm* bterm)
     std::string bname = bterm->getName();
 
     if (_use_net_inst_ids) {
-      fprintf(_out, "    - %s + NET N%u", bname.c_str(), net->getId());
+      print("    - %s + NET N%u", bname.c_str(), net->getId());
     } else {
       std::string nname = net->getName();
-      fprintf(_out, "    - %s + NET %s", bname.c_str(), nname.c_str());
+      print("    - %s + NET %s", bname.c_str(), nname.c_str());
     }
 
     if (bterm->isSpecial()) {
-      fprintf(_out, " + SPECIAL");
+      print(" + SPECIAL");
     }
 
-    fprintf(_out, " + DIRECTION %s", defIoType(bterm->getIoType()));
+    print(" + DIRECTION %s", defIoType(bterm->getIoType()));
 
     if (_version >= defout::DEF_5_6) {
       dbBTerm* supply = bterm->getSupplyPin();
 
       if (supply) {
         std::string pname = supply->getName();
-        fprintf(_out, " + SUPPLYSENSITIVITY %s", pname.c_str());
+        print(" + SUPPLYSENSITIVITY %s", pname.c_str());
       }
 
       dbBTerm* ground = bterm->getGroundPin();
 
       if (ground) {
         std::string pname = ground->getName();
-        fprintf(_out, " + GROUNDSENSITIVITY %s", pname.c_str());
+        print(" + GROUNDSENSITIVITY %s", pname.c_str());
       }
     }
 
     const char* sig_type = defSigType(bterm->getSigType());
-    fprintf(_out, " + USE %s", sig_type);
+    print(" + USE %s", sig_type);
 
-    fprintf(_out, " ;\n");
+    print(" ;\n");
   } else {
     _logger->warn(utl::ODB,
                   173,
@@ -985,56 +1129,48 @@ void defout_impl::writeBPin(dbBPin* bpin, int cnt)
   if (cnt == 0 || _version <= defout::DEF_5_6) {
     if (_use_net_inst_ids) {
       if (cnt == 0) {
-        fprintf(_out, "    - %s + NET N%u", bname.c_str(), net->getId());
+        print("    - %s + NET N%u", bname.c_str(), net->getId());
       } else {
-        fprintf(_out,
-                "    - %s.extra%d + NET N%u",
-                bname.c_str(),
-                cnt,
-                net->getId());
+        print("    - %s.extra%d + NET N%u", bname.c_str(), cnt, net->getId());
       }
     } else {
       std::string nname = net->getName();
       if (cnt == 0) {
-        fprintf(_out, "    - %s + NET %s", bname.c_str(), nname.c_str());
+        print("    - %s + NET %s", bname.c_str(), nname.c_str());
       } else {
-        fprintf(_out,
-                "    - %s.extra%d + NET %s",
-                bname.c_str(),
-                cnt,
-                nname.c_str());
+        print("    - %s.extra%d + NET %s", bname.c_str(), cnt, nname.c_str());
       }
     }
 
     if (bterm->isSpecial()) {
-      fprintf(_out, " + SPECIAL");
+      print(" + SPECIAL");
     }
 
-    fprintf(_out, " + DIRECTION %s", defIoType(bterm->getIoType()));
+    print(" + DIRECTION %s", defIoType(bterm->getIoType()));
 
     if (_version >= defout::DEF_5_6) {
       dbBTerm* supply = bterm->getSupplyPin();
 
       if (supply) {
         std::string pname = supply->getName();
-        fprintf(_out, " + SUPPLYSENSITIVITY %s", pname.c_str());
+        print(" + SUPPLYSENSITIVITY %s", pname.c_str());
       }
 
       dbBTerm* ground = bterm->getGroundPin();
 
       if (ground) {
         std::string pname = ground->getName();
-        fprintf(_out, " + GROUNDSENSITIVITY %s", pname.c_str());
+        print(" + GROUNDSENSITIVITY %s", pname.c_str());
       }
     }
 
-    fprintf(_out, " + USE %s", defSigType(bterm->getSigType()));
+    print(" + USE %s", defSigType(bterm->getSigType()));
   }
 
-  fprintf(_out, "\n      ");
+  print("\n      ");
 
   if (_version > defout::DEF_5_6) {
-    fprintf(_out, "+ PORT");
+    print("+ PORT");
   }
 
   bool isFirst = 1;
@@ -1064,15 +1200,14 @@ void defout_impl::writeBPin(dbBPin* bpin, int cnt)
       lname = layer->getName();
     }
 
-    fprintf(_out, "\n       ");
+    print("\n       ");
     if (_version == defout::DEF_5_5) {
-      fprintf(_out,
-              " + LAYER %s ( %d %d ) ( %d %d )",
-              lname.c_str(),
-              xMin,
-              yMin,
-              xMax,
-              yMax);
+      print(" + LAYER %s ( %d %d ) ( %d %d )",
+            lname.c_str(),
+            xMin,
+            yMin,
+            xMax,
+            yMax);
     } else {
       std::string layer_name = lname;
       if (_version == defout::DEF_5_8) {
@@ -1084,32 +1219,29 @@ void defout_impl::writeBPin(dbBPin* bpin, int cnt)
       }
       if (bpin->hasEffectiveWidth()) {
         int w = defdist(bpin->getEffectiveWidth());
-        fprintf(_out,
-                " + LAYER %s DESIGNRULEWIDTH %d ( %d %d ) ( %d %d )",
-                layer_name.c_str(),
-                w,
-                xMin,
-                yMin,
-                xMax,
-                yMax);
+        print(" + LAYER %s DESIGNRULEWIDTH %d ( %d %d ) ( %d %d )",
+              layer_name.c_str(),
+              w,
+              xMin,
+              yMin,
+              xMax,
+              yMax);
       } else if (bpin->hasMinSpacing()) {
         int s = defdist(bpin->getMinSpacing());
-        fprintf(_out,
-                " + LAYER %s SPACING %d ( %d %d ) ( %d %d )",
-                layer_name.c_str(),
-                s,
-                xMin,
-                yMin,
-                xMax,
-                yMax);
+        print(" + LAYER %s SPACING %d ( %d %d ) ( %d %d )",
+              layer_name.c_str(),
+              s,
+              xMin,
+              yMin,
+              xMax,
+              yMax);
       } else {
-        fprintf(_out,
-                " + LAYER %s ( %d %d ) ( %d %d )",
-                layer_name.c_str(),
-                xMin,
-                yMin,
-                xMax,
-                yMax);
+        print(" + LAYER %s ( %d %d ) ( %d %d )",
+              layer_name.c_str(),
+              xMin,
+              yMin,
+              xMax,
+              yMax);
       }
     }
   }
@@ -1123,18 +1255,18 @@ void defout_impl::writeBPin(dbBPin* bpin, int cnt)
 
     case dbPlacementStatus::SUGGESTED:
     case dbPlacementStatus::PLACED: {
-      fprintf(_out, "\n        + PLACED ( %d %d ) N", x, y);
+      print("\n        + PLACED ( %d %d ) N", x, y);
       break;
     }
 
     case dbPlacementStatus::LOCKED:
     case dbPlacementStatus::FIRM: {
-      fprintf(_out, "\n        + FIXED ( %d %d ) N", x, y);
+      print("\n        + FIXED ( %d %d ) N", x, y);
       break;
     }
 
     case dbPlacementStatus::COVER: {
-      fprintf(_out, "\n        + COVER ( %d %d ) N", x, y);
+      print("\n        + COVER ( %d %d ) N", x, y);
       break;
     }
   }
@@ -1179,7 +1311,7 @@ void defout_impl::writeBlockages(dbBlock* block)
 
     if (first) {
       first = false;
-      fprintf(_out, "BLOCKAGES %d ;\n", bcnt);
+      print("BLOCKAGES %d ;\n", bcnt);
     }
 
     dbBox* bbox = obs->getBBox();
@@ -1191,36 +1323,36 @@ void defout_impl::writeBlockages(dbBlock* block)
       lname = layer->getName();
     }
 
-    fprintf(_out, "    - LAYER %s", lname.c_str());
+    print("    - LAYER %s", lname.c_str());
 
     if (inst) {
       if (_use_net_inst_ids) {
-        fprintf(_out, " + COMPONENT I%u", inst->getId());
+        print(" + COMPONENT I%u", inst->getId());
       } else {
         std::string iname = inst->getName();
-        fprintf(_out, " + COMPONENT %s", iname.c_str());
+        print(" + COMPONENT %s", iname.c_str());
       }
     }
 
     if (obs->isSlotObstruction()) {
-      fprintf(_out, " + SLOTS");
+      print(" + SLOTS");
     }
 
     if (obs->isFillObstruction()) {
-      fprintf(_out, " + FILLS");
+      print(" + FILLS");
     }
 
     if (obs->isPushedDown()) {
-      fprintf(_out, " + PUSHDOWN");
+      print(" + PUSHDOWN");
     }
 
     if (_version >= defout::DEF_5_6) {
       if (obs->hasEffectiveWidth()) {
         int w = defdist(obs->getEffectiveWidth());
-        fprintf(_out, " + DESIGNRULEWIDTH %d", w);
+        print(" + DESIGNRULEWIDTH %d", w);
       } else if (obs->hasMinSpacing()) {
         int s = defdist(obs->getMinSpacing());
-        fprintf(_out, " + SPACING %d", s);
+        print(" + SPACING %d", s);
       }
     }
 
@@ -1229,7 +1361,7 @@ void defout_impl::writeBlockages(dbBlock* block)
     int x2 = defdist(bbox->xMax());
     int y2 = defdist(bbox->yMax());
 
-    fprintf(_out, " RECT ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
+    print(" RECT ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
   }
 
   std::vector<dbBlockage*> sorted_blockages(blockages.begin(), blockages.end());
@@ -1251,30 +1383,30 @@ void defout_impl::writeBlockages(dbBlock* block)
 
     if (first) {
       first = false;
-      fprintf(_out, "BLOCKAGES %d ;\n", bcnt);
+      print("BLOCKAGES %d ;\n", bcnt);
     }
 
-    fprintf(_out, "    - PLACEMENT");
+    print("    - PLACEMENT");
 
     if (blk->isSoft()) {
-      fprintf(_out, " + SOFT");
+      print(" + SOFT");
     }
 
     if (blk->getMaxDensity() > 0) {
-      fprintf(_out, " + PARTIAL %f", blk->getMaxDensity());
+      print(" + PARTIAL %f", blk->getMaxDensity());
     }
 
     if (inst) {
       if (_use_net_inst_ids) {
-        fprintf(_out, " + COMPONENT I%u", inst->getId());
+        print(" + COMPONENT I%u", inst->getId());
       } else {
         std::string iname = inst->getName();
-        fprintf(_out, " + COMPONENT %s", iname.c_str());
+        print(" + COMPONENT %s", iname.c_str());
       }
     }
 
     if (blk->isPushedDown()) {
-      fprintf(_out, " + PUSHDOWN");
+      print(" + PUSHDOWN");
     }
 
     dbBox* bbox = blk->getBBox();
@@ -1283,11 +1415,11 @@ void defout_impl::writeBlockages(dbBlock* block)
     int x2 = defdist(bbox->xMax());
     int y2 = defdist(bbox->yMax());
 
-    fprintf(_out, " RECT ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
+    print(" RECT ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
   }
 
   if (!first) {
-    fprintf(_out, "END BLOCKAGES\n");
+    print("END BLOCKAGES\n");
   }
 }
 
@@ -1300,18 +1432,18 @@ void defout_impl::writeFills(dbBlock* block)
     return;
   }
 
-  fprintf(_out, "FILLS %d ;\n", num_fills);
+  print("FILLS %d ;\n", num_fills);
 
   for (dbFill* fill : fills) {
-    fprintf(_out, "    - LAYER %s", fill->getTechLayer()->getName().c_str());
+    print("    - LAYER %s", fill->getTechLayer()->getName().c_str());
 
     uint mask = fill->maskNumber();
     if (mask != 0) {
-      fprintf(_out, " + MASK %u", mask);
+      print(" + MASK %u", mask);
     }
 
     if (fill->needsOPC()) {
-      fprintf(_out, " + OPC");
+      print(" + OPC");
     }
 
     Rect r;
@@ -1322,10 +1454,10 @@ void defout_impl::writeFills(dbBlock* block)
     int x2 = defdist(r.xMax());
     int y2 = defdist(r.yMax());
 
-    fprintf(_out, " RECT ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
+    print(" RECT ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
   }
 
-  fprintf(_out, "END FILLS\n");
+  print("END FILLS\n");
 }
 
 void defout_impl::writeNets(dbBlock* block)
@@ -1366,7 +1498,7 @@ void defout_impl::writeNets(dbBlock* block)
   }
 
   if (snet_cnt > 0) {
-    fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
+    print("SPECIALNETS %d ;\n", snet_cnt);
 
     for (dbNet* net : sorted_nets) {
       if (_select_net_map && !(*_select_net_map)[net]) {
@@ -1377,22 +1509,25 @@ void defout_impl::writeNets(dbBlock* block)
       }
     }
 
-    fprintf(_out, "END SPECIALNETS\n");
+    print("END SPECIALNETS\n");
   }
 
-  fprintf(_out, "NETS %d ;\n", net_cnt);
+  print("NETS %d ;\n", net_cnt);
 
+  std::vector<dbNet*> regular_nets;
+  regular_nets.reserve(net_cnt);
   for (dbNet* net : sorted_nets) {
     if (_select_net_map && !(*_select_net_map)[net]) {
       continue;
     }
 
     if (regular_net[net] == 1) {
-      writeNet(net);
+      regular_nets.push_back(net);
     }
   }
+  writeChunks(regular_nets, &defout_impl::writeNet);
 
-  fprintf(_out, "END NETS\n");
+  print("END NETS\n");
 }
 
 void defout_impl::writeSNet(dbNet* net)
@@ -1400,19 +1535,19 @@ void defout_impl::writeSNet(dbNet* net)
   dbSet<dbITerm> iterms = net->getITerms();
 
   if (_use_net_inst_ids) {
-    fprintf(_out, "    - N%u", net->getId());
+    print("    - N%u", net->getId());
   } else {
     std::string nname = net->getName();
-    fprintf(_out, "    - %s", nname.c_str());
+    print("    - %s", nname.c_str());
   }
 
   int i = 0;
 
   for (dbBTerm* bterm : net->getBTerms()) {
     if ((++i & 7) == 0) {
-      fprintf(_out, "\n    ");
+      print("\n    ");
     }
-    fprintf(_out, " ( PIN %s )", bterm->getName().c_str());
+    print(" ( PIN %s )", bterm->getName().c_str());
   }
 
   char ttname[max_name_length];
@@ -1430,31 +1565,31 @@ void defout_impl::writeSNet(dbNet* net)
     char* mtname = mterm->getName(inst, &ttname[0]);
     if (net->isWildConnected()) {
       if (wild_names.find(mtname) == wild_names.end()) {
-        fprintf(_out, " ( * %s )", mtname);
+        print(" ( * %s )", mtname);
         ++i;
         wild_names.insert(mtname);
       }
     } else {
       if ((++i & 7) == 0) {
         if (_use_net_inst_ids) {
-          fprintf(_out, "\n      ( I%u %s )", inst->getId(), mtname);
+          print("\n      ( I%u %s )", inst->getId(), mtname);
         } else {
           std::string iname = inst->getName();
-          fprintf(_out, "\n      ( %s %s )", iname.c_str(), mtname);
+          print("\n      ( %s %s )", iname.c_str(), mtname);
         }
       } else {
         if (_use_net_inst_ids) {
-          fprintf(_out, " ( I%u %s )", inst->getId(), mtname);
+          print(" ( I%u %s )", inst->getId(), mtname);
         } else {
           std::string iname = inst->getName();
-          fprintf(_out, " ( %s %s )", iname.c_str(), mtname);
+          print(" ( %s %s )", iname.c_str(), mtname);
         }
       }
     }
   }
 
   const char* sig_type = defSigType(net->getSigType());
-  fprintf(_out, " + USE %s", sig_type);
+  print(" + USE %s", sig_type);
 
   _non_default_rule = nullptr;
   dbSet<dbSWire> swires = net->getSWires();
@@ -1471,19 +1606,19 @@ void defout_impl::writeSNet(dbNet* net)
       break;
 
     case dbSourceType::NETLIST:
-      fprintf(_out, " + SOURCE NETLIST");
+      print(" + SOURCE NETLIST");
       break;
 
     case dbSourceType::DIST:
-      fprintf(_out, " + SOURCE DIST");
+      print(" + SOURCE DIST");
       break;
 
     case dbSourceType::USER:
-      fprintf(_out, " + SOURCE USER");
+      print(" + SOURCE USER");
       break;
 
     case dbSourceType::TIMING:
-      fprintf(_out, " + SOURCE TIMING");
+      print(" + SOURCE TIMING");
       break;
 
     case dbSourceType::TEST:
@@ -1491,19 +1626,19 @@ void defout_impl::writeSNet(dbNet* net)
   }
 
   if (net->hasFixedBump()) {
-    fprintf(_out, " + FIXEDBUMP");
+    print(" + FIXEDBUMP");
   }
 
   if (net->getWeight() != 1) {
-    fprintf(_out, " + WEIGHT %d", net->getWeight());
+    print(" + WEIGHT %d", net->getWeight());
   }
 
   if (hasProperties(net, SPECIALNET)) {
-    fprintf(_out, " + PROPERTY ");
+    print(" + PROPERTY ");
     writeProperties(net);
   }
 
-  fprintf(_out, " ;\n");
+  print(" ;\n");
 }
 
 void defout_impl::writeWire(dbWire* wire)
@@ -1539,14 +1674,13 @@ void defout_impl::writeWire(dbWire* wire)
         }
 
         if ((path_cnt == 0) || (wire_type != prev_wire_type)) {
-          fprintf(
-              _out, "\n      + %s %s", wire_type.getString(), lname.c_str());
+          print("\n      + %s %s", wire_type.getString(), lname.c_str());
         } else {
-          fprintf(_out, "\n      NEW %s", lname.c_str());
+          print("\n      NEW %s", lname.c_str());
         }
 
         if (_non_default_rule && (decode.peek() != dbWireDecoder::RULE)) {
-          fprintf(_out, " TAPER");
+          print(" TAPER");
         }
 
         prev_wire_type = wire_type;
@@ -1562,7 +1696,7 @@ void defout_impl::writeWire(dbWire* wire)
         y = defdist(y);
 
         if ((++point_cnt & 7) == 0) {
-          fprintf(_out, "\n    ");
+          print("\n    ");
         }
 
         std::string mask_statement;
@@ -1571,11 +1705,11 @@ void defout_impl::writeWire(dbWire* wire)
         }
 
         if (point_cnt == 1) {
-          fprintf(_out, " ( %d %d )", x, y);
+          print(" ( %d %d )", x, y);
         } else if (x == prev_x) {
-          fprintf(_out, "%s ( * %d )", mask_statement.c_str(), y);
+          print("%s ( * %d )", mask_statement.c_str(), y);
         } else if (y == prev_y) {
-          fprintf(_out, "%s ( %d * )", mask_statement.c_str(), x);
+          print("%s ( %d * )", mask_statement.c_str(), x);
         }
 
         prev_x = x;
@@ -1591,17 +1725,17 @@ void defout_impl::writeWire(dbWire* wire)
         ext = defdist(ext);
 
         if ((++point_cnt & 7) == 0) {
-          fprintf(_out, "\n    ");
+          print("\n    ");
         }
 
         if (point_cnt == 1) {
-          fprintf(_out, " ( %d %d %d )", x, y, ext);
+          print(" ( %d %d %d )", x, y, ext);
         } else if ((x == prev_x) && (y == prev_y)) {
-          fprintf(_out, " ( * * %d )", ext);
+          print(" ( * * %d )", ext);
         } else if (x == prev_x) {
-          fprintf(_out, " ( * %d %d )", y, ext);
+          print(" ( * %d %d )", y, ext);
         } else if (y == prev_y) {
-          fprintf(_out, " ( %d * %d )", x, ext);
+          print(" ( %d * %d )", x, ext);
         }
 
         prev_x = x;
@@ -1611,7 +1745,7 @@ void defout_impl::writeWire(dbWire* wire)
 
       case dbWireDecoder::VIA: {
         if ((++point_cnt & 7) == 0) {
-          fprintf(_out, "\n    ");
+          print("\n    ");
         }
 
         dbVia* via = decode.getVia();
@@ -1633,21 +1767,20 @@ void defout_impl::writeWire(dbWire* wire)
             vname = via->getBlockVia()->getName();
           }
 
-          fprintf(_out,
-                  " %s%s %s",
-                  via_mask_statement.c_str(),
-                  vname.c_str(),
-                  defOrient(via->getOrient()));
+          print(" %s%s %s",
+                via_mask_statement.c_str(),
+                vname.c_str(),
+                defOrient(via->getOrient()));
         } else {
           std::string vname = via->getName();
-          fprintf(_out, " %s%s", via_mask_statement.c_str(), vname.c_str());
+          print(" %s%s", via_mask_statement.c_str(), vname.c_str());
         }
         break;
       }
 
       case dbWireDecoder::TECH_VIA: {
         if ((++point_cnt & 7) == 0) {
-          fprintf(_out, "\n    ");
+          print("\n    ");
         }
 
         std::string via_mask_statement;
@@ -1660,7 +1793,7 @@ void defout_impl::writeWire(dbWire* wire)
 
         dbTechVia* via = decode.getTechVia();
         std::string vname = via->getName();
-        fprintf(_out, " %s%s", via_mask_statement.c_str(), vname.c_str());
+        print(" %s%s", via_mask_statement.c_str(), vname.c_str());
         break;
       }
 
@@ -1675,10 +1808,10 @@ void defout_impl::writeWire(dbWire* wire)
 
           if (_non_default_rule == nullptr) {
             std::string name = taper_rule->getName();
-            fprintf(_out, " TAPERRULE %s ", name.c_str());
+            print(" TAPERRULE %s ", name.c_str());
           } else if (_non_default_rule != taper_rule) {
             std::string name = taper_rule->getName();
-            fprintf(_out, " TAPERRULE %s ", name.c_str());
+            print(" TAPERRULE %s ", name.c_str());
           }
         }
         break;
@@ -1686,7 +1819,7 @@ void defout_impl::writeWire(dbWire* wire)
 
       case dbWireDecoder::RECT: {
         if ((++point_cnt & 7) == 0) {
-          fprintf(_out, "\n    ");
+          print("\n    ");
         }
 
         int deltaX1;
@@ -1699,21 +1832,15 @@ void defout_impl::writeWire(dbWire* wire)
         deltaX2 = defdist(deltaX2);
         deltaY2 = defdist(deltaY2);
         if (color.has_value()) {
-          fprintf(_out,
-                  " RECT MASK %d ( %d %d %d %d ) ",
-                  color.value(),
-                  deltaX1,
-                  deltaY1,
-                  deltaX2,
-                  deltaY2);
+          print(" RECT MASK %d ( %d %d %d %d ) ",
+                color.value(),
+                deltaX1,
+                deltaY1,
+                deltaX2,
+                deltaY2);
 
         } else {
-          fprintf(_out,
-                  " RECT ( %d %d %d %d ) ",
-                  deltaX1,
-                  deltaY1,
-                  deltaX2,
-                  deltaY2);
+          print(" RECT ( %d %d %d %d ) ", deltaX1, deltaY1, deltaX2, deltaY2);
         }
         break;
       }
@@ -1728,31 +1855,31 @@ void defout_impl::writeSWire(dbSWire* wire)
 {
   switch (wire->getWireType().getValue()) {
     case dbWireType::COVER:
-      fprintf(_out, "\n      + COVER");
+      print("\n      + COVER");
       break;
 
     case dbWireType::FIXED:
-      fprintf(_out, "\n      + FIXED");
+      print("\n      + FIXED");
       break;
 
     case dbWireType::ROUTED:
-      fprintf(_out, "\n      + ROUTED");
+      print("\n      + ROUTED");
       break;
 
     case dbWireType::SHIELD: {
       dbNet* s = wire->getShield();
       if (s) {
         std::string n = s->getName();
-        fprintf(_out, "\n      + SHIELD %s", n.c_str());
+        print("\n      + SHIELD %s", n.c_str());
       } else {
         _logger->warn(utl::ODB, 174, "warning: missing shield net");
-        fprintf(_out, "\n      + ROUTED");
+        print("\n      + ROUTED");
       }
       break;
     }
 
     default:
-      fprintf(_out, "\n      + ROUTED");
+      print("\n      + ROUTED");
       break;
   }
 
@@ -1764,7 +1891,7 @@ void defout_impl::writeSWire(dbSWire* wire)
     dbSBox* box = *itr;
 
     if (i++ > 0) {
-      fprintf(_out, "\n      NEW");
+      print("\n      NEW");
     }
 
     if (!box->isVia()) {
@@ -1794,20 +1921,18 @@ void defout_impl::writeSWire(dbSWire* wire)
       }
 
       if (type.getValue() == dbWireShapeType::NONE) {
-        fprintf(_out,
-                " %s 0 ( %d %d ) %s",
-                ln.c_str(),
-                defdist(x),
-                defdist(y),
-                vn.c_str());
+        print(" %s 0 ( %d %d ) %s",
+              ln.c_str(),
+              defdist(x),
+              defdist(y),
+              vn.c_str());
       } else {
-        fprintf(_out,
-                " %s 0 + SHAPE %s ( %d %d ) %s",
-                ln.c_str(),
-                type.getString(),
-                defdist(x),
-                defdist(y),
-                vn.c_str());
+        print(" %s 0 + SHAPE %s ( %d %d ) %s",
+              ln.c_str(),
+              type.getString(),
+              defdist(x),
+              defdist(y),
+              vn.c_str());
       }
     } else if (box->getBlockVia()) {
       dbWireShapeType type = box->getWireShapeType();
@@ -1833,20 +1958,18 @@ void defout_impl::writeSWire(dbSWire* wire)
       }
 
       if (type.getValue() == dbWireShapeType::NONE) {
-        fprintf(_out,
-                " %s 0 ( %d %d ) %s",
-                ln.c_str(),
-                defdist(x),
-                defdist(y),
-                vn.c_str());
+        print(" %s 0 ( %d %d ) %s",
+              ln.c_str(),
+              defdist(x),
+              defdist(y),
+              vn.c_str());
       } else {
-        fprintf(_out,
-                " %s 0 + SHAPE %s ( %d %d ) %s",
-                ln.c_str(),
-                type.getString(),
-                defdist(x),
-                defdist(y),
-                vn.c_str());
+        print(" %s 0 + SHAPE %s ( %d %d ) %s",
+              ln.c_str(),
+              type.getString(),
+              defdist(x),
+              defdist(y),
+              vn.c_str());
       }
     }
   }
@@ -1945,47 +2068,43 @@ void defout_impl::writeSpecialPath(dbSBox* box)
 
   if (mask != 0) {
     if (type.getValue() == dbWireShapeType::NONE) {
-      fprintf(_out,
-              " %s %d ( %d %d ) MASK %d ( %d %d )",
-              ln.c_str(),
-              defdist(w),
-              defdist(x1),
-              defdist(y1),
-              mask,
-              defdist(x2),
-              defdist(y2));
+      print(" %s %d ( %d %d ) MASK %d ( %d %d )",
+            ln.c_str(),
+            defdist(w),
+            defdist(x1),
+            defdist(y1),
+            mask,
+            defdist(x2),
+            defdist(y2));
     } else {
-      fprintf(_out,
-              " %s %d + SHAPE %s + MASK %d + ( %d %d ) ( %d %d )",
-              ln.c_str(),
-              defdist(w),
-              type.getString(),
-              mask,
-              defdist(x1),
-              defdist(y1),
-              defdist(x2),
-              defdist(y2));
+      print(" %s %d + SHAPE %s + MASK %d + ( %d %d ) ( %d %d )",
+            ln.c_str(),
+            defdist(w),
+            type.getString(),
+            mask,
+            defdist(x1),
+            defdist(y1),
+            defdist(x2),
+            defdist(y2));
     }
   } else {
     if (type.getValue() == dbWireShapeType::NONE) {
-      fprintf(_out,
-              " %s %d ( %d %d ) ( %d %d )",
-              ln.c_str(),
-              defdist(w),
-              defdist(x1),
-              defdist(y1),
-              defdist(x2),
-              defdist(y2));
+      print(" %s %d ( %d %d ) ( %d %d )",
+            ln.c_str(),
+            defdist(w),
+            defdist(x1),
+            defdist(y1),
+            defdist(x2),
+            defdist(y2));
     } else {
-      fprintf(_out,
-              " %s %d + SHAPE %s ( %d %d ) ( %d %d )",
-              ln.c_str(),
-              defdist(w),
-              type.getString(),
-              defdist(x1),
-              defdist(y1),
-              defdist(x2),
-              defdist(y2));
+      print(" %s %d + SHAPE %s ( %d %d ) ( %d %d )",
+            ln.c_str(),
+            defdist(w),
+            type.getString(),
+            defdist(x1),
+            defdist(y1),
+            defdist(x2),
+            defdist(y2));
     }
   }
 }
@@ -1993,10 +2112,10 @@ void defout_impl::writeSpecialPath(dbSBox* box)
 void defout_impl::writeNet(dbNet* net)
 {
   if (_use_net_inst_ids) {
-    fprintf(_out, "    - N%u", net->getId());
+    print("    - N%u", net->getId());
   } else {
     std::string nname = net->getName();
-    fprintf(_out, "    - %s", nname.c_str());
+    print("    - %s", nname.c_str());
   }
 
   char ttname[max_name_length];
@@ -2005,9 +2124,9 @@ void defout_impl::writeNet(dbNet* net)
   for (dbBTerm* bterm : net->getBTerms()) {
     const char* pin_name = bterm->getConstName();
     if ((++i & 7) == 0) {
-      fprintf(_out, "\n     ");
+      print("\n     ");
     }
-    fprintf(_out, " ( PIN %s )", pin_name);
+    print(" ( PIN %s )", pin_name);
   }
 
   for (dbITerm* iterm : net->getITerms()) {
@@ -2024,29 +2143,29 @@ void defout_impl::writeNet(dbNet* net)
     char* mtname = mterm->getName(inst, &ttname[0]);
 
     if ((++i & 7) == 0) {
-      fprintf(_out, "\n     ");
+      print("\n     ");
     }
 
     if (_use_net_inst_ids) {
-      fprintf(_out, " ( I%u %s )", inst->getId(), mtname);
+      print(" ( I%u %s )", inst->getId(), mtname);
     } else {
       std::string iname = inst->getName();
-      fprintf(_out, " ( %s %s )", iname.c_str(), mtname);
+      print(" ( %s %s )", iname.c_str(), mtname);
     }
   }
 
   if (net->getXTalkClass() != 0) {
-    fprintf(_out, " + XTALK %d", net->getXTalkClass());
+    print(" + XTALK %d", net->getXTalkClass());
   }
 
   const char* sig_type = defSigType(net->getSigType());
-  fprintf(_out, " + USE %s", sig_type);
+  print(" + USE %s", sig_type);
 
   _non_default_rule = net->getNonDefaultRule();
 
   if (_non_default_rule) {
     std::string n = _non_default_rule->getName();
-    fprintf(_out, " + NONDEFAULTRULE %s", n.c_str());
+    print(" + NONDEFAULTRULE %s", n.c_str());
   }
 
   dbWire* wire = net->getWire();
@@ -2062,40 +2181,40 @@ void defout_impl::writeNet(dbNet* net)
       break;
 
     case dbSourceType::NETLIST:
-      fprintf(_out, " + SOURCE NETLIST");
+      print(" + SOURCE NETLIST");
       break;
 
     case dbSourceType::DIST:
-      fprintf(_out, " + SOURCE DIST");
+      print(" + SOURCE DIST");
       break;
 
     case dbSourceType::USER:
-      fprintf(_out, " + SOURCE USER");
+      print(" + SOURCE USER");
       break;
 
     case dbSourceType::TIMING:
-      fprintf(_out, " + SOURCE TIMING");
+      print(" + SOURCE TIMING");
       break;
 
     case dbSourceType::TEST:
-      fprintf(_out, " + SOURCE TEST");
+      print(" + SOURCE TEST");
       break;
   }
 
   if (net->hasFixedBump()) {
-    fprintf(_out, " + FIXEDBUMP");
+    print(" + FIXEDBUMP");
   }
 
   if (net->getWeight() != 1) {
-    fprintf(_out, " + WEIGHT %d", net->getWeight());
+    print(" + WEIGHT %d", net->getWeight());
   }
 
   if (hasProperties(net, NET)) {
-    fprintf(_out, " + PROPERTY ");
+    print(" + PROPERTY ");
     writeProperties(net);
   }
 
-  fprintf(_out, " ;\n");
+  print(" ;\n");
 }
 
 //
@@ -2110,7 +2229,7 @@ void defout_impl::writePropertyDefinitions(dbBlock* block)
     return;
   }
 
-  fprintf(_out, "PROPERTYDEFINITIONS\n");
+  print("PROPERTYDEFINITIONS\n");
 
   dbSet<dbProperty> obj_types = dbProperty::getProperties(defs);
   dbSet<dbProperty>::iterator objitr;
@@ -2153,15 +2272,15 @@ void defout_impl::writePropertyDefinitions(dbBlock* block)
       defs_map[std::string(name)] = true;
       switch (prop->getType()) {
         case dbProperty::STRING_PROP:
-          fprintf(_out, "%s %s STRING ", objType.c_str(), name.c_str());
+          print("%s %s STRING ", objType.c_str(), name.c_str());
           break;
 
         case dbProperty::INT_PROP:
-          fprintf(_out, "%s %s INTEGER ", objType.c_str(), name.c_str());
+          print("%s %s INTEGER ", objType.c_str(), name.c_str());
           break;
 
         case dbProperty::DOUBLE_PROP:
-          fprintf(_out, "%s %s REAL ", objType.c_str(), name.c_str());
+          print("%s %s REAL ", objType.c_str(), name.c_str());
           break;
 
         default:
@@ -2172,7 +2291,7 @@ void defout_impl::writePropertyDefinitions(dbBlock* block)
       dbProperty* maxV = dbProperty::find(prop, "MAX");
 
       if (minV && maxV) {
-        fprintf(_out, "RANGE ");
+        print("RANGE ");
         writePropValue(minV);
         writePropValue(maxV);
       }
@@ -2183,11 +2302,11 @@ void defout_impl::writePropertyDefinitions(dbBlock* block)
         writePropValue(value);
       }
 
-      fprintf(_out, ";\n");
+      print(";\n");
     }
   }
 
-  fprintf(_out, "END PROPERTYDEFINITIONS\n");
+  print("END PROPERTYDEFINITIONS\n");
 }
 
 void defout_impl::writePropValue(dbProperty* prop)
@@ -2196,21 +2315,21 @@ void defout_impl::writePropValue(dbProperty* prop)
     case dbProperty::STRING_PROP: {
       dbStringProperty* p = (dbStringProperty*) prop;
       std::string v = p->getValue();
-      fprintf(_out, "\"%s\" ", v.c_str());
+      print("\"%s\" ", v.c_str());
       break;
     }
 
     case dbProperty::INT_PROP: {
       dbIntProperty* p = (dbIntProperty*) prop;
       int v = p->getValue();
-      fprintf(_out, "%d ", v);
+      print("%d ", v);
       break;
     }
 
     case dbProperty::DOUBLE_PROP: {
       dbDoubleProperty* p = (dbDoubleProperty*) prop;
       double v = p->getValue();
-      fprintf(_out, "%G ", v);
+      print("%G ", v);
     }
 
     default:
@@ -2226,12 +2345,12 @@ void defout_impl::writeProperties(dbObject* object)
 
   for (itr = props.begin(); itr != props.end(); ++itr) {
     if (cnt && ((cnt & 3) == 0)) {
-      fprintf(_out, "\n    ");
+      print("\n    ");
     }
 
     dbProperty* prop = *itr;
     std::string name = prop->getName();
-    fprintf(_out, "%s ", name.c_str());
+    print("%s ", name.c_str());
     writePropValue(prop);
   }
 }
@@ -2279,16 +2398,16 @@ void defout_impl::writePinProperties(dbBlock* block)
     return;
   }
 
-  fprintf(_out, "PINPROPERTIES %u ;\n", cnt);
+  print("PINPROPERTIES %u ;\n", cnt);
 
   for (bitr = bterms.begin(); bitr != bterms.end(); ++bitr) {
     dbBTerm* bterm = *bitr;
 
     if (hasProperties(bterm, COMPONENTPIN)) {
       std::string name = bterm->getName();
-      fprintf(_out, "  - PIN %s + PROPERTY ", name.c_str());
+      print("  - PIN %s + PROPERTY ", name.c_str());
       writeProperties(bterm);
-      fprintf(_out, " ;\n");
+      print(" ;\n");
     }
   }
 
@@ -2302,13 +2421,13 @@ void defout_impl::writePinProperties(dbBlock* block)
       std::string iname = inst->getName();
       // std::string mtname = mterm->getName();
       char* mtname = mterm->getName(inst, &ttname[0]);
-      fprintf(_out, "  - %s %s + PROPERTY ", iname.c_str(), mtname);
+      print("  - %s %s + PROPERTY ", iname.c_str(), mtname);
       writeProperties(iterm);
-      fprintf(_out, " ;\n");
+      print(" ;\n");
     }
   }
 
-  fprintf(_out, "END PINPROPERTIES\n");
+  print("END PINPROPERTIES\n");
 }
 
 }  // namespace odb
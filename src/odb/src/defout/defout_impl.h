@@ -32,13 +32,18 @@
 
 #pragma once
 
+#include <zlib.h>
+
+#include <cstdio>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
 #include "odb/defout.h"
+#include "odb/ZException.h"
 #include "odb/odb.h"
 namespace utl {
 class Logger;
@@ -68,7 +73,12 @@ class defout_impl
   };
 
   double _dist_factor;
-  FILE* _out;
+  // Text formatted by print that is not yet written to _file or _gz_file.
+  std::string _out;
+  FILE* _file;
+  gzFile _gz_file;
+  size_t _bytes_written;
+  bool _write_failed;
   bool _use_net_inst_ids;
   bool _use_master_ids;
   bool _use_alias;
@@ -78,6 +88,7 @@ class defout_impl
   dbMap<dbInst, char>* _select_inst_map;
   dbTechNonDefaultRule* _non_default_rule;
   int _version;
+  int _thread_count;
   std::map<std::string, bool> _prop_defs[9];
   utl::Logger* _logger;
 
@@ -115,6 +126,14 @@ class defout_impl
   void writePinProperties(dbBlock* block);
   bool hasProperties(dbObject* object, ObjType type);
 
+  void print(const char* format, ...) ADS_FORMAT_PRINTF(2, 3);
+  void flush();
+  void writeOut(const std::string& text);
+
+  template <typename T>
+  void writeChunks(const std::vector<T*>& objects,
+                   void (defout_impl::*write)(T*));
+
  public:
   defout_impl(utl::Logger* logger)
   {
@@ -124,7 +143,12 @@ class defout_impl
     _select_net_map = nullptr;
     _select_inst_map = nullptr;
     _version = defout::DEF_5_8;
+    _thread_count = 1;
     _logger = logger;
+    _file = nullptr;
+    _gz_file = nullptr;
+    _bytes_written = 0;
+    _write_failed = false;
   }
 
   ~defout_impl() {}
@@ -139,6 +163,7 @@ class defout_impl
 
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
+  void setThreadCount(int threads) { _thread_count = threads; }
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
@@ -0,0 +1,22 @@
+source "helpers.tcl"
+
+# With several threads read_def builds the components and nets on a separate
+# thread; the block must match the one of a serial read.
+set db [ord::get_db]
+odb::read_lef $db "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+set_thread_count 4
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set serial_db [odb::dbDatabase_create]
+odb::read_lef $serial_db "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+odb::read_def [$serial_db getTech] "data/gcd/gcd_nangate45_route.def"
+
+if { [odb::db_diff $db $serial_db] } {
+  puts "FAIL: Differences found between threaded and serial reads"
+  exit 1
+}
+
+file delete diffs.rpt
+
+puts "pass"
+exit 0
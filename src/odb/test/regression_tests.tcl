@@ -13,8 +13,10 @@ record_tests {
   dump_via_rules
   dump_vias
   read_def
+  read_def_threads
   read_def58
   write_def58
+  write_def_threads
   dump_nets
   lef_mask
   write_lef_and_def
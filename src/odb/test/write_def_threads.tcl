@@ -0,0 +1,30 @@
+source "helpers.tcl"
+
+# write_def formats COMPONENTS and NETS in parallel chunks; the output must be
+# the same as the serial writer's, also when compressed.  With 4 threads the
+# 1877 components and 439 nets of gcd are both split into several chunks.
+set db [ord::get_db]
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set serial_def [make_result_file "write_def_threads_serial.def"]
+write_def $serial_def
+
+set_thread_count 4
+set threads_def [make_result_file "write_def_threads.def"]
+write_def $threads_def
+diff_files $serial_def $threads_def
+
+set threads_gz [make_result_file "write_def_threads.def.gz"]
+write_def $threads_gz
+set stream [open $threads_gz rb]
+set unzipped [zlib gunzip [read $stream]]
+close $stream
+set unzipped_def [make_result_file "write_def_threads_gz.def"]
+set stream [open $unzipped_def wb]
+puts -nonewline $stream $unzipped
+close $stream
+diff_files $serial_def $unzipped_def
+
+puts "pass"
+exit 0
@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cstddef>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -69,6 +71,12 @@ enum class GeneratedSourceType
   BUMPS
 };
 
+enum class SolverType
+{
+  LU,  // direct sparse LU factorization
+  CG   // conjugate gradient with incomplete Cholesky preconditioning
+};
+
 class PDNSim : public odb::dbBlockCallBackObj
 {
  public:
@@ -103,7 +111,9 @@ class PDNSim : public odb::dbBlockCallBackObj
                         bool enable_em,
                         const std::string& em_file,
                         const std::string& error_file,
-                        const std::string& voltage_source_file);
+                        const std::string& voltage_source_file,
+                        SolverType solver_type = SolverType::LU,
+                        int threads = 1);
   void writeSpiceNetwork(odb::dbNet* net,
                          sta::Corner* corner,
                          GeneratedSourceType source_type,
@@ -134,6 +144,8 @@ class PDNSim : public odb::dbBlockCallBackObj
 
  private:
   IRSolver* getIRSolver(odb::dbNet* net, bool floorplanning);
+  void clearSolver(odb::dbNet* net);
+  void trimSolverCaches(odb::dbNet* net, sta::Corner* corner);
 
   odb::dbDatabase* db_ = nullptr;
   sta::dbSta* sta_ = nullptr;
@@ -147,6 +159,11 @@ class PDNSim : public odb::dbBlockCallBackObj
   GeneratedSourceSettings generated_source_settings_;
 
   std::map<odb::dbNet*, std::unique_ptr<IRSolver>> solvers_;
+  // nets and corners with a factorized G matrix, most recently solved first
+  std::list<std::pair<odb::dbNet*, sta::Corner*>> solver_caches_;
+  // memory the factorized G matrices of all nets may hold before the least
+  // recently solved ones are dropped
+  static constexpr std::size_t max_solver_cache_bytes_ = std::size_t(2) << 30;
   std::map<odb::dbNet*, std::map<sta::Corner*, double>> user_voltages_;
 };
 }  // namespace psm
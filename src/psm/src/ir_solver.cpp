@@ -32,6 +32,7 @@
 
 #include "ir_solver.h"
 
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 #include <fstream>
 #include <list>
@@ -366,8 +367,12 @@ std::map<Connection*, Connection::Conductance> IRSolver::generateConductanceMap(
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Generate conductance map: {}");
 
-  const Connection::ResistanceMap resistance = getResistanceMap(corner);
+  return generateConductanceMap(getResistanceMap(corner));
+}
 
+std::map<Connection*, Connection::Conductance> IRSolver::generateConductanceMap(
+    const Connection::ResistanceMap& resistance) const
+{
   std::map<Connection*, Connection::Conductance> conductance;
   for (const auto& conn : network_->getConnections()) {
     const auto res = conn->getResistance(resistance);
@@ -867,52 +872,254 @@ void IRSolver::addSourcesToMatrixAndVoltages(
 
 void IRSolver::solve(sta::Corner* corner,
                      GeneratedSourceType source_type,
-                     const std::string& source_file)
+                     const std::string& source_file,
+                     SolverType solver_type,
+                     int threads)
 {
   const utl::DebugScopedTimer timer(logger_, utl::PSM, "timer", 1, "Solve: {}");
 
   if (network_->isFloorplanningOnly()) {
     network_->setFloorplanning(false);
     network_->construct();
+    solver_cache_.clear();
   }
 
   // Reset
   auto& voltages = voltages_[corner];
   auto& currents = currents_[corner];
 
+  // Previous solution, used as the starting point of the iterative solver
+  ValueNodeMap<Voltage> initial_voltages;
+  if (solver_type == SolverType::CG) {
+    if (!voltages.empty()) {
+      initial_voltages = voltages;
+    } else if (last_solved_corner_ != nullptr) {
+      initial_voltages = voltages_[last_solved_corner_];
+    }
+  }
+
   voltages.clear();
   currents.clear();
 
-  const auto conductance = generateConductanceMap(corner);
+  buildNodeCurrentMap(corner, currents);
+
+  // Build source map
+  std::vector<std::unique_ptr<SourceNode>> src_nodes;
+  Voltage src_voltage
+      = generateSourceNodes(source_type, source_file, corner, src_nodes);
+
+  // Factorize G unless the layer resistances and sources are those of the
+  // last solve of this corner, in which case only J changes
+  const Connection::ResistanceMap resistance = getResistanceMap(corner);
+  SolverCache& cache = solver_cache_[corner];
+  if (isSolverCacheValid(
+          cache, solver_type, resistance, src_nodes, src_voltage)) {
+    debugPrint(
+        logger_, utl::PSM, "cache", 1, "Reusing the factorized G matrix.");
+  } else {
+    const auto conductance = generateConductanceMap(resistance);
+    debugPrint(logger_,
+               utl::PSM,
+               "stats",
+               1,
+               "Connections in conductance map: {}",
+               conductance.size());
+
+    if (logger_->debugCheck(utl::PSM, "dump", 2)) {
+      dumpConductance(conductance, "cond");
+    }
+
+    const auto node_connections = getNodeConnectionMap(conductance);
+
+    // the entry is only replaced once the factorization succeeded
+    SolverCache new_cache;
+    new_cache.solver_type = solver_type;
+    new_cache.src_voltage = src_voltage;
+    new_cache.resistance = resistance;
+    for (const auto& src_node : src_nodes) {
+      new_cache.source_nodes.push_back(src_node->getSource());
+    }
+    if (solver_type == SolverType::CG) {
+      factorizeCG(
+          node_connections, conductance, src_nodes, src_voltage, new_cache);
+    } else {
+      factorizeLU(
+          node_connections, conductance, src_nodes, src_voltage, new_cache);
+    }
+    new_cache.bytes = getSolverCacheBytes(new_cache);
+    debugPrint(logger_,
+               utl::PSM,
+               "stats",
+               1,
+               "Factorized G matrix: {} bytes",
+               new_cache.bytes);
+    cache = std::move(new_cache);
+  }
+
+  // Build J
+  const bool is_ground = src_voltage == 0.0;
+  Eigen::VectorXd J = cache.source_currents;
+  for (const auto& [node, node_idx] : cache.solution_index) {
+    auto find_current = currents.find(node);
+    if (find_current != currents.end()) {
+      J[node_idx] += is_ground ? find_current->second : -find_current->second;
+    }
+  }
+
+  // Solve
+  debugPrint(logger_, utl::PSM, "solve", 1, "Solving system of equations GV=J");
+  Eigen::VectorXd V;
+  if (cache.lu_solver != nullptr) {
+    V = cache.lu_solver->solve(J);
+    if (cache.lu_solver->info() != Eigen::ComputationInfo::Success) {
+      // solving failed
+      if (logger_->debugCheck(utl::PSM, "dump", 1)) {
+        network_->dumpNodes(cache.solution_index);
+        dumpVector(J, "J");
+      }
+      logger_->error(utl::PSM, 12, "Solving V = inv(G)*J failed.");
+    }
+  } else {
+    Eigen::VectorXd V0(J.size());
+    V0.setConstant(src_voltage);
+    for (const auto& [node, node_idx] : cache.solution_index) {
+      auto find_initial = initial_voltages.find(node);
+      if (find_initial != initial_voltages.end()) {
+        V0[node_idx] = find_initial->second;
+      }
+    }
+
+    // Lower|Upper lets Eigen run the matrix-vector products in parallel.
+    // The Eigen thread count is global, so it is restored after the solve.
+    const int eigen_threads = Eigen::nbThreads();
+    Eigen::setNbThreads(threads);
+    V = cache.cg_solver->solveWithGuess(J, V0);
+    Eigen::setNbThreads(eigen_threads);
+    if (cache.cg_solver->info() != Eigen::ComputationInfo::Success) {
+      if (logger_->debugCheck(utl::PSM, "dump", 1)) {
+        network_->dumpNodes(cache.solution_index);
+        dumpVector(J, "J");
+      }
+      logger_->error(utl::PSM,
+                     94,
+                     "Conjugate gradient did not converge after {} iterations "
+                     "(error: {:.3e}).",
+                     cache.cg_solver->iterations(),
+                     cache.cg_solver->error());
+    }
+    debugPrint(logger_,
+               utl::PSM,
+               "solve",
+               1,
+               "Conjugate gradient converged after {} iterations (error: "
+               "{:.3e})",
+               cache.cg_solver->iterations(),
+               cache.cg_solver->error());
+  }
   debugPrint(logger_,
              utl::PSM,
-             "stats",
+             "solve",
              1,
-             "Connections in conductance map: {}",
-             conductance.size());
+             "Solving system of equations GV=J complete");
 
   if (logger_->debugCheck(utl::PSM, "dump", 2)) {
-    dumpConductance(conductance, "cond");
+    network_->dumpNodes(cache.solution_index);
+    dumpVector(J, "J");
+    dumpVector(V, "V");
   }
+  for (const auto& [node, node_idx] : cache.solution_index) {
+    voltages[node] = V[node_idx];
+  }
+  for (const Node* node : cache.fixed_nodes) {
+    voltages[node] = src_voltage;
+  }
+  solution_voltages_[corner] = src_voltage;
+  last_solved_corner_ = corner;
+}
+
+bool IRSolver::isSolverCacheValid(
+    const SolverCache& cache,
+    SolverType solver_type,
+    const Connection::ResistanceMap& resistance,
+    const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+    Voltage src_voltage) const
+{
+  if (cache.lu_solver == nullptr && cache.cg_solver == nullptr) {
+    return false;
+  }
+  if (cache.solver_type != solver_type || cache.src_voltage != src_voltage) {
+    return false;
+  }
+  if (cache.source_nodes.size() != sources.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    if (cache.source_nodes[i] != sources[i]->getSource()) {
+      return false;
+    }
+  }
+  return cache.resistance == resistance;
+}
 
-  const auto node_connections = getNodeConnectionMap(conductance);
+std::size_t IRSolver::getSolverCacheBytes(const SolverCache& cache) const
+{
+  constexpr std::size_t entry_bytes
+      = sizeof(Connection::Conductance) + sizeof(int);
+  // red-black tree node of the index maps
+  constexpr std::size_t map_node_bytes = 4 * sizeof(void*);
+
+  std::size_t bytes
+      = cache.solution_index.size()
+            * (sizeof(std::pair<Node*, std::size_t>) + map_node_bytes)
+        + cache.fixed_nodes.size() * sizeof(Node*)
+        + cache.source_currents.size() * sizeof(double);
+  if (cache.lu_solver != nullptr) {
+    bytes += (cache.lu_solver->nnzL() + cache.lu_solver->nnzU()) * entry_bytes;
+  }
+  if (cache.cg_solver != nullptr) {
+    bytes += cache.cg_matrix->nonZeros() * entry_bytes;
+    bytes += cache.cg_solver->preconditioner().matrixL().nonZeros()
+             * entry_bytes;
+  }
+  return bytes;
+}
+
+std::size_t IRSolver::getSolverCacheBytes() const
+{
+  std::size_t bytes = 0;
+  for (const auto& [corner, cache] : solver_cache_) {
+    bytes += cache.bytes;
+  }
+  return bytes;
+}
+
+std::size_t IRSolver::clearSolverCache(sta::Corner* corner)
+{
+  auto find_cache = solver_cache_.find(corner);
+  if (find_cache == solver_cache_.end()) {
+    return 0;
+  }
+  const std::size_t bytes = find_cache->second.bytes;
+  solver_cache_.erase(find_cache);
+  return bytes;
+}
+
+void IRSolver::factorizeLU(
+    const std::map<Node*, Connection::ConnectionSet>& node_connections,
+    const std::map<psm::Connection*, Connection::Conductance>& conductance,
+    const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+    Voltage src_voltage,
+    SolverCache& cache) const
+{
   Node::NodeSet all_nodes;
   for (const auto& [node, conns] : node_connections) {
     all_nodes.insert(node);
   }
 
-  buildNodeCurrentMap(corner, currents);
-
-  // Build source map
-  std::vector<std::unique_ptr<SourceNode>> src_nodes;
-  Voltage src_voltage
-      = generateSourceNodes(source_type, source_file, corner, src_nodes);
-
-  // Solve
   // create vector of nodes
   std::map<Node*, std::size_t> node_index = assignNodeIDs(all_nodes);
-  const std::map<Node*, std::size_t> real_node_index = node_index;
-  for (const auto& [node, id] : assignNodeIDs(src_nodes, node_index.size())) {
+  cache.solution_index = node_index;
+  for (const auto& [node, id] : assignNodeIDs(sources, node_index.size())) {
     node_index[node] = id;
   }
 
@@ -930,21 +1137,16 @@ void IRSolver::solve(sta::Corner* corner,
   Eigen::SparseMatrix<Connection::Conductance> G(num_nodes, num_nodes);
   Eigen::VectorXd J(num_nodes);
 
-  // Build G and J
-  buildCondMatrixAndVoltages(src_voltage == 0.0,
-                             node_connections,
-                             currents,
-                             conductance,
-                             node_index,
-                             G,
-                             J);
-  addSourcesToMatrixAndVoltages(src_voltage, src_nodes, node_index, G, J);
+  // Build G and the source part of J
+  buildCondMatrixAndVoltages(
+      src_voltage == 0.0, node_connections, {}, conductance, node_index, G, J);
+  addSourcesToMatrixAndVoltages(src_voltage, sources, node_index, G, J);
 
-  Eigen::SparseLU<Eigen::SparseMatrix<Connection::Conductance>> eigen_solver;
+  cache.lu_solver = std::make_unique<LUSolver>();
 
   debugPrint(logger_, utl::PSM, "solve", 1, "Factorizing the G matrix");
-  eigen_solver.compute(G);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
+  cache.lu_solver->compute(G);
+  if (cache.lu_solver->info() != Eigen::ComputationInfo::Success) {
     // decomposition failed
     if (logger_->debugCheck(utl::PSM, "dump", 1)) {
       network_->dumpNodes(node_index);
@@ -954,36 +1156,83 @@ void IRSolver::solve(sta::Corner* corner,
         utl::PSM,
         10,
         "LU factorization of the G Matrix failed. SparseLU solver message: {}.",
-        eigen_solver.lastErrorMessage());
+        cache.lu_solver->lastErrorMessage());
   }
 
-  debugPrint(logger_, utl::PSM, "solve", 1, "Solving system of equations GV=J");
-  const Eigen::VectorXd V = eigen_solver.solve(J);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
-    // solving failed
-    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
-      network_->dumpNodes(node_index);
-      dumpMatrix(G, "G");
-      dumpVector(J, "J");
+  if (logger_->debugCheck(utl::PSM, "dump", 2)) {
+    dumpMatrix(G, "G");
+  }
+
+  cache.source_currents = std::move(J);
+}
+
+void IRSolver::factorizeCG(
+    const std::map<Node*, Connection::ConnectionSet>& node_connections,
+    const std::map<psm::Connection*, Connection::Conductance>& conductance,
+    const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+    Voltage src_voltage,
+    SolverCache& cache) const
+{
+  // Nodes attached to a source are held at the source voltage and moved to
+  // the right hand side, which leaves G symmetric positive definite.
+  std::set<const Node*> fixed_nodes;
+  for (const auto& src_node : sources) {
+    fixed_nodes.insert(src_node->getSource());
+  }
+
+  std::map<Node*, std::size_t> node_index;
+  for (const auto& [node, conns] : node_connections) {
+    if (fixed_nodes.find(node) == fixed_nodes.end()) {
+      node_index.emplace(node, node_index.size());
+    } else {
+      cache.fixed_nodes.push_back(node);
     }
-    logger_->error(utl::PSM, 12, "Solving V = inv(G)*J failed.");
   }
-  debugPrint(logger_,
-             utl::PSM,
-             "solve",
-             1,
-             "Solving system of equations GV=J complete");
+  const std::size_t num_nodes = node_index.size();
+  debugPrint(logger_, utl::PSM, "stats", 1, "Nodes in matrix: {}", num_nodes);
 
-  if (logger_->debugCheck(utl::PSM, "dump", 2)) {
-    network_->dumpNodes(node_index);
-    dumpMatrix(G, "G");
-    dumpVector(J, "J");
-    dumpVector(V, "V");
+  cache.cg_matrix = std::make_unique<CGMatrix>(num_nodes, num_nodes);
+  Eigen::VectorXd J = Eigen::VectorXd::Zero(num_nodes);
+  {
+    const utl::DebugScopedTimer timer(
+        logger_, utl::PSM, "timer", 1, "Build G and J: {}");
+
+    std::vector<Eigen::Triplet<Connection::Conductance>> cond_values;
+    for (const auto& [node, node_idx] : node_index) {
+      Connection::Conductance node_cond = 0.0;
+      for (auto* conn : node_connections.at(node)) {
+        Node* other = conn->getOtherNode(node);
+        const Connection::Conductance cond = conductance.at(conn);
+        node_cond += cond;
+
+        auto find_other = node_index.find(other);
+        if (find_other == node_index.end()) {
+          J[node_idx] += cond * src_voltage;
+        } else {
+          cond_values.emplace_back(node_idx, find_other->second, -cond);
+        }
+      }
+      cond_values.emplace_back(node_idx, node_idx, node_cond);
+    }
+    cache.cg_matrix->setFromTriplets(cond_values.begin(), cond_values.end());
   }
-  for (const auto& [node, node_idx] : real_node_index) {
-    voltages[node] = V[node_idx];
+
+  cache.cg_solver = std::make_unique<CGSolver>();
+  cache.cg_solver->setTolerance(cg_tolerance_);
+
+  debugPrint(logger_, utl::PSM, "solve", 1, "Preconditioning the G matrix");
+  cache.cg_solver->compute(*cache.cg_matrix);
+  if (cache.cg_solver->info() != Eigen::ComputationInfo::Success) {
+    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
+      network_->dumpNodes(node_index);
+    }
+    logger_->error(utl::PSM,
+                   93,
+                   "Incomplete Cholesky factorization of the G Matrix failed.");
   }
-  solution_voltages_[corner] = src_voltage;
+
+  cache.solution_index = std::move(node_index);
+  cache.source_currents = std::move(J);
 }
 
 std::map<odb::dbInst*, IRSolver::Power> IRSolver::getInstancePower(
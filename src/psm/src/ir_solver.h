@@ -32,7 +32,9 @@
 
 #pragma once
 
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/Sparse>
+#include <Eigen/SparseLU>
 #include <boost/geometry.hpp>
 #include <boost/polygon/polygon.hpp>
 #include <map>
@@ -102,7 +104,9 @@ class IRSolver
 
   void solve(sta::Corner* corner,
              GeneratedSourceType source_type,
-             const std::string& source_file);
+             const std::string& source_file,
+             SolverType solver_type,
+             int threads);
 
   void report(sta::Corner* corner) const;
   void reportEM(sta::Corner* corner) const;
@@ -145,10 +149,50 @@ class IRSolver
 
   IRNetwork* getNetwork() const { return network_.get(); }
 
+  // Approximate memory held by the factorized G matrices of all corners
+  std::size_t getSolverCacheBytes() const;
+  // Drops the factorized G matrix of corner and returns the memory released
+  std::size_t clearSolverCache(sta::Corner* corner);
+
  private:
   template <typename T>
   using ValueNodeMap = std::map<const Node*, T>;
 
+  using LUSolver
+      = Eigen::SparseLU<Eigen::SparseMatrix<Connection::Conductance>>;
+  using CGMatrix
+      = Eigen::SparseMatrix<Connection::Conductance, Eigen::RowMajor>;
+  using CGSolver = Eigen::ConjugateGradient<
+      CGMatrix,
+      Eigen::Lower | Eigen::Upper,
+      Eigen::IncompleteCholesky<Connection::Conductance>>;
+
+  // Factorized G matrix of a corner. G only depends on the network, which
+  // lives as long as the solver, on the layer resistances and on the sources,
+  // so it is reused while those are unchanged and a new solve only rebuilds J.
+  struct SolverCache
+  {
+    SolverType solver_type = SolverType::LU;
+    Voltage src_voltage = 0.0;
+    Connection::ResistanceMap resistance;
+    std::vector<Node*> source_nodes;
+
+    // matrix index of the network nodes
+    std::map<Node*, std::size_t> solution_index;
+    // nodes held at the source voltage and left out of the matrix
+    std::vector<Node*> fixed_nodes;
+    // contribution of the sources to J
+    Eigen::VectorXd source_currents;
+
+    std::unique_ptr<LUSolver> lu_solver;
+    // the CG solver only references G, so it is kept with the preconditioner
+    std::unique_ptr<CGMatrix> cg_matrix;
+    std::unique_ptr<CGSolver> cg_solver;
+
+    // approximate memory held by the entry
+    std::size_t bytes = 0;
+  };
+
   odb::dbBlock* getBlock() const;
   odb::dbTech* getTech() const;
 
@@ -162,6 +206,8 @@ class IRSolver
 
   std::map<Connection*, Connection::Conductance> generateConductanceMap(
       sta::Corner* corner) const;
+  std::map<Connection*, Connection::Conductance> generateConductanceMap(
+      const Connection::ResistanceMap& resistance) const;
   Voltage generateSourceNodes(
       GeneratedSourceType source_type,
       const std::string& source_file,
@@ -211,6 +257,25 @@ class IRSolver
       const std::map<Node*, std::size_t>& node_index,
       Eigen::SparseMatrix<Connection::Conductance>& G,
       Eigen::VectorXd& J) const;
+  bool isSolverCacheValid(
+      const SolverCache& cache,
+      SolverType solver_type,
+      const Connection::ResistanceMap& resistance,
+      const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+      Voltage src_voltage) const;
+  std::size_t getSolverCacheBytes(const SolverCache& cache) const;
+  void factorizeLU(
+      const std::map<Node*, Connection::ConnectionSet>& node_connections,
+      const std::map<psm::Connection*, Connection::Conductance>& conductance,
+      const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+      Voltage src_voltage,
+      SolverCache& cache) const;
+  void factorizeCG(
+      const std::map<Node*, Connection::ConnectionSet>& node_connections,
+      const std::map<psm::Connection*, Connection::Conductance>& conductance,
+      const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+      Voltage src_voltage,
+      SolverCache& cache) const;
 
   std::string getMetricKey(const std::string& key, sta::Corner* corner) const;
 
@@ -233,6 +298,7 @@ class IRSolver
 
   const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>& user_voltages_;
   std::map<sta::Corner*, Voltage> solution_voltages_;
+  sta::Corner* last_solved_corner_ = nullptr;
 
   const PDNSim::GeneratedSourceSettings& generated_source_settings_;
 
@@ -242,8 +308,11 @@ class IRSolver
 
   std::map<sta::Corner*, ValueNodeMap<Voltage>> voltages_;
   std::map<sta::Corner*, ValueNodeMap<Current>> currents_;
+  std::map<sta::Corner*, SolverCache> solver_cache_;
 
   static constexpr Current spice_file_min_current_ = 1e-18;
+  // relative residual at which the conjugate gradient solver stops
+  static constexpr double cg_tolerance_ = 1e-10;
 };
 
 }  // namespace psm
@@ -97,14 +97,18 @@ void PDNSim::analyzePowerGrid(odb::dbNet* net,
                               bool enable_em,
                               const std::string& em_file,
                               const std::string& error_file,
-                              const std::string& voltage_source_file)
+                              const std::string& voltage_source_file,
+                              SolverType solver_type,
+                              int threads)
 {
   if (!checkConnectivity(net, false, error_file)) {
     return;
   }
 
   auto* solver = getIRSolver(net, false);
-  solver->solve(corner, source_type, voltage_source_file);
+  solver->solve(
+      corner, source_type, voltage_source_file, solver_type, threads);
+  trimSolverCaches(net, corner);
   solver->report(corner);
 
   heatmap_->setNet(net);
@@ -206,46 +210,90 @@ void PDNSim::setGeneratedSourceSettings(const GeneratedSourceSettings& settings)
 void PDNSim::clearSolvers()
 {
   solvers_.clear();
+  solver_caches_.clear();
 }
 
-void PDNSim::inDbPostMoveInst(odb::dbInst*)
+// Edits only invalidate the solver of the net they touch, the solvers of the
+// other nets keep their networks and factorized G matrices.
+void PDNSim::clearSolver(odb::dbNet* net)
 {
-  clearSolvers();
+  if (net == nullptr) {
+    return;
+  }
+  solvers_.erase(net);
+  solver_caches_.remove_if(
+      [net](const auto& net_corner) { return net_corner.first == net; });
+}
+
+// Drops the factorized G matrices of the least recently solved nets and
+// corners until they fit in max_solver_cache_bytes_. The matrix of the last
+// solve is always kept.
+void PDNSim::trimSolverCaches(odb::dbNet* net, sta::Corner* corner)
+{
+  solver_caches_.remove({net, corner});
+  solver_caches_.emplace_front(net, corner);
+
+  std::size_t bytes = 0;
+  for (const auto& [solver_net, solver] : solvers_) {
+    bytes += solver->getSolverCacheBytes();
+  }
+
+  while (bytes > max_solver_cache_bytes_ && solver_caches_.size() > 1) {
+    const auto [lru_net, lru_corner] = solver_caches_.back();
+    solver_caches_.pop_back();
+    auto find_solver = solvers_.find(lru_net);
+    if (find_solver != solvers_.end()) {
+      bytes -= find_solver->second->clearSolverCache(lru_corner);
+      debugPrint(logger_,
+                 utl::PSM,
+                 "cache",
+                 1,
+                 "Dropping the factorized G matrix of {}.",
+                 lru_net->getName());
+    }
+  }
+}
+
+void PDNSim::inDbPostMoveInst(odb::dbInst* inst)
+{
+  for (odb::dbITerm* iterm : inst->getITerms()) {
+    clearSolver(iterm->getNet());
+  }
 }
 
-void PDNSim::inDbNetDestroy(odb::dbNet*)
+void PDNSim::inDbNetDestroy(odb::dbNet* net)
 {
-  clearSolvers();
+  clearSolver(net);
 }
 
-void PDNSim::inDbBTermPostConnect(odb::dbBTerm*)
+void PDNSim::inDbBTermPostConnect(odb::dbBTerm* bterm)
 {
-  clearSolvers();
+  clearSolver(bterm->getNet());
 }
 
-void PDNSim::inDbBTermPostDisConnect(odb::dbBTerm*, odb::dbNet*)
+void PDNSim::inDbBTermPostDisConnect(odb::dbBTerm*, odb::dbNet* net)
 {
-  clearSolvers();
+  clearSolver(net);
 }
 
-void PDNSim::inDbBPinDestroy(odb::dbBPin*)
+void PDNSim::inDbBPinDestroy(odb::dbBPin* bpin)
 {
-  clearSolvers();
+  clearSolver(bpin->getBTerm()->getNet());
 }
 
-void PDNSim::inDbSWireAddSBox(odb::dbSBox*)
+void PDNSim::inDbSWireAddSBox(odb::dbSBox* sbox)
 {
-  clearSolvers();
+  clearSolver(sbox->getSWire()->getNet());
 }
 
-void PDNSim::inDbSWireRemoveSBox(odb::dbSBox*)
+void PDNSim::inDbSWireRemoveSBox(odb::dbSBox* sbox)
 {
-  clearSolvers();
+  clearSolver(sbox->getSWire()->getNet());
 }
 
-void PDNSim::inDbSWirePostDestroySBoxes(odb::dbSWire*)
+void PDNSim::inDbSWirePostDestroySBoxes(odb::dbSWire* swire)
 {
-  clearSolvers();
+  clearSolver(swire->getNet());
 }
 
 }  // namespace psm
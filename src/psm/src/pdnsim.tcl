@@ -66,12 +66,13 @@ sta::define_cmd_args "analyze_power_grid" {
   [-em_outfile em_file]
   [-vsrc voltage_source_file]
   [-source_type FULL|BUMPS|STRAPS]
+  [-solver LU|CG]
 }
 
 proc analyze_power_grid { args } {
   sta::parse_key_args "analyze_power_grid" args \
     keys {-net -corner -voltage_file -error_file -em_outfile -vsrc \
-      -source_type} \
+      -source_type -solver} \
     flags {-enable_em}
   if { ![info exists keys(-net)] } {
     utl::error PSM 58 "Argument -net not specified."
@@ -97,6 +98,14 @@ proc analyze_power_grid { args } {
     set source_type $keys(-source_type)
   }
 
+  set solver "LU"
+  if { [info exists keys(-solver)] } {
+    set solver $keys(-solver)
+    if { [lsearch -exact {LU CG} $solver] == -1 } {
+      utl::error PSM 63 "-solver must be LU or CG."
+    }
+  }
+
   set enable_em [info exists flags(-enable_em)]
   set em_file ""
   if { [info exists keys(-em_outfile)]} {
@@ -114,7 +123,8 @@ proc analyze_power_grid { args } {
     $enable_em \
     $em_file \
     $voltage_file \
-    $voltage_source_file
+    $voltage_source_file \
+    $solver
 }
 
 sta::define_cmd_args "write_pg_spice" {
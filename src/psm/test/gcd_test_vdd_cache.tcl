@@ -0,0 +1,18 @@
+# check that a second solve reuses the factorized G matrix
+source helpers.tcl
+
+read_lef Nangate45/Nangate45.lef
+read_def Nangate45_data/gcd.def
+read_liberty Nangate45/Nangate45_typ.lib
+read_sdc Nangate45_data/gcd.sdc
+
+set voltage_file1 [make_result_file gcd_test_vdd_cache-voltage1.rpt]
+set voltage_file2 [make_result_file gcd_test_vdd_cache-voltage2.rpt]
+
+set_debug_level PSM cache 1
+
+analyze_power_grid -vsrc Vsrc_gcd_vdd.loc -voltage_file $voltage_file1 -net VDD
+analyze_power_grid -vsrc Vsrc_gcd_vdd.loc -voltage_file $voltage_file2 -net VDD
+
+diff_files $voltage_file1 gcd_test_vdd-voltage.rptok
+diff_files $voltage_file2 gcd_test_vdd-voltage.rptok
@@ -0,0 +1,18 @@
+# compare the conjugate gradient solver to the direct solver
+source helpers.tcl
+
+read_lef Nangate45/Nangate45.lef
+read_def Nangate45_data/gcd.def
+read_liberty Nangate45/Nangate45_typ.lib
+read_sdc Nangate45_data/gcd.sdc
+
+set lu_voltage_file [make_result_file gcd_test_vdd_cg-lu-voltage.rpt]
+set cg_voltage_file [make_result_file gcd_test_vdd_cg-cg-voltage.rpt]
+
+analyze_power_grid -vsrc Vsrc_gcd_vdd.loc -voltage_file $lu_voltage_file \
+  -net VDD -solver LU
+analyze_power_grid -vsrc Vsrc_gcd_vdd.loc -voltage_file $cg_voltage_file \
+  -net VDD -solver CG
+
+diff_files $lu_voltage_file gcd_test_vdd-voltage.rptok
+diff_files $cg_voltage_file gcd_test_vdd-voltage.rptok
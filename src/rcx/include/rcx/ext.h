@@ -118,6 +118,7 @@ class Ext
     int context_depth = 5;
     int cc_model = 10;
     bool lef_res = false;
+    int thread_count = 1;
   };
 
   void extract(ExtractOptions options);
@@ -160,6 +161,7 @@ class Ext
     const bool no_backslash = false;
     const char* cap_units = "PF";
     const char* res_units = "OHM";
+    int thread_count = 1;
   };
   void write_spef(const SpefOptions& options);
 
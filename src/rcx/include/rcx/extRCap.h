@@ -33,6 +33,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include "ext2dBox.h"
 #include "extprocess.h"
@@ -2094,6 +2095,8 @@ class extMain
   bool _usingMetalPlanes = false;
 
   gs* _geomSeq = nullptr;
+  // shapes painted on each _geomSeq slice for the current window
+  std::vector<std::vector<odb::Rect>> _gsShapes;
 
   AthPool<SEQ>* _seqPool = nullptr;
 
@@ -2222,6 +2225,7 @@ class extMain
 
  public:
   bool _lef_res;
+  int _threads = 1;
   std::string _tmpLenStats;
   int _last_node_xy[2];
   bool _wireInfra;
@@ -32,7 +32,12 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "extRCap.h"
 #include "odb/array1.h"
@@ -40,6 +45,7 @@
 #include "odb/dbShape.h"
 #include "odb/odb.h"
 #include "odb/parse.h"
+#include "spdlog/fmt/fmt.h"
 
 namespace utl {
 class Logger;
@@ -52,6 +58,7 @@ using odb::uint;
 using utl::Logger;
 
 class NameTable;
+class SpefFileWriter;
 
 class extSpef
 {
@@ -173,6 +180,27 @@ class extSpef
   void writePort(uint node);
   void writeDnet(uint netId, const double* totCap);
   void writeKeyword(const char* keyword);
+
+  // Formats into the output buffer, handing it off to the writer thread
+  // once it holds a full chunk.
+  template <typename... Args>
+  void writeOut(fmt::format_string<Args...> format, Args&&... args)
+  {
+    fmt::format_to(
+        std::back_inserter(_outBuf), format, std::forward<Args>(args)...);
+    if (_outBuf.size() >= _outChunkSize) {
+      flushOut();
+    }
+  }
+  void flushOut();
+  // Writes the *D_NET sections of the nets, formatting them on the threads
+  // of extMain::_threads.
+  void writeNets(const std::vector<odb::dbNet*>& nets);
+  // Copies the settings used by writeNetRC so this extSpef can format nets
+  // for spef.
+  void initNetWriter(const extSpef& spef);
+  odb::dbNet* getCornerNet(odb::dbNet* net);
+  void writeNetRC(odb::dbNet* net, uint capNodeCnt, uint minNode);
   uint writePorts();
   uint writeITerms();
   uint getInstMapId(uint id);
@@ -342,6 +370,9 @@ class extSpef
 
   char _outFile[1024];
   FILE* _outFP = nullptr;
+  static constexpr size_t _outChunkSize = 1 << 20;
+  std::string _outBuf;
+  std::unique_ptr<SpefFileWriter> _outWriter;
 
   Ath__parser* _parser = nullptr;
 
@@ -60,6 +60,11 @@ class gs
 
   // render a rectangle
   int box(int x0, int y0, int x1, int y1, int slice);
+  // render a rectangle without updating the shared slice state, so
+  // different slices can be rendered concurrently
+  int boxSlice(int x0, int y0, int x1, int y1, int slice) const;
+  // true if box() would render the rectangle on the slice
+  bool overlapsSlice(int x0, int y0, int x1, int y1, int slice) const;
 
   // set the number of slices
   int set_slices(int nslices);
@@ -241,6 +241,7 @@ void Ext::extract(ExtractOptions options)
 
   _ext->set_debug_nets(options.debug_net);
   _ext->_lef_res = options.lef_res;
+  _ext->_threads = options.thread_count;
 
   _ext->makeBlockRCsegs(options.net,
                         options.cc_up,
@@ -291,6 +292,7 @@ void Ext::write_spef(const SpefOptions& options)
   if (!options.init) {
     logger_->info(RCX, 16, "Writing SPEF ...");
   }
+  _ext->_threads = options.thread_count;
   _ext->writeSPEF((char*) options.file,
                   (char*) options.nets,
                   options.no_name_map,
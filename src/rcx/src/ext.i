@@ -84,6 +84,7 @@ extract(const char* ext_model_file,
   opts.lef_res = lef_res;
   opts.debug_net = debug_net_id;
   opts.no_merge_via_res = no_merge_via_res;
+  opts.thread_count = ord::OpenRoad::openRoad()->getThreadCount();
   
   ext->extract(opts);
 }
@@ -102,6 +103,7 @@ write_spef(const char* file,
   if (write_coordinates) {
     opts.N = "Y";
   }
+  opts.thread_count = ord::OpenRoad::openRoad()->getThreadCount();
   
   ext->write_spef(opts);
 }
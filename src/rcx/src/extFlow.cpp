@@ -947,20 +947,21 @@ uint extMain::addShapeOnGS(dbNet* net,
   }
 
   uint level = layer->getRoutingLevel();
-  int n = 0;
-  if (!gsRotated) {
-    n = _geomSeq->box(r.xMin(), r.yMin(), r.xMax(), r.yMax(), level);
-  } else {
-    if (!swap_coords) {  // horizontal
-      n = _geomSeq->box(r.xMin(), r.yMin(), r.xMax(), r.yMax(), level);
-    } else {
-      n = _geomSeq->box(r.yMin(), r.xMin(), r.yMax(), r.xMax(), level);
-    }
+  Rect box = r;
+  if (gsRotated && swap_coords) {
+    box.init(r.yMin(), r.xMin(), r.yMax(), r.xMax());
   }
-  if (n == 0) {
-    return 1;
+  if (!_geomSeq->overlapsSlice(
+          box.xMin(), box.yMin(), box.xMax(), box.yMax(), level)) {
+    return 0;
   }
-  return 0;
+  // the shape is painted later by fill_gs4, together with the rest of its
+  // slice
+  if (level >= _gsShapes.size()) {
+    _gsShapes.resize(level + 1);
+  }
+  _gsShapes[level].push_back(box);
+  return 1;
 }
 
 uint extMain::addNetShapesGs(dbNet* net,
@@ -1128,6 +1129,10 @@ uint extMain::fill_gs4(int dir,
 
   initPlanes(dir, lo_gs, hi_gs, layerCnt, pitchTable, widthTable, dirTable, ll);
 
+  for (std::vector<Rect>& shapes : _gsShapes) {
+    shapes.clear();
+  }
+
   const int gs_dir = dir;
 
   uint pcnt = 0;
@@ -1156,6 +1161,16 @@ uint extMain::fill_gs4(int dir,
     scnt += addNetShapesGs(net, rotatedGs, !dir, gs_dir);
   }
 
+  // Each slice is painted by a single thread. Painting only sets pixels, so
+  // the planes do not depend on the order of the shapes.
+  const int sliceCnt = _gsShapes.size();
+#pragma omp parallel for num_threads(_threads) schedule(dynamic)
+  for (int level = 0; level < sliceCnt; level++) {
+    for (const Rect& r : _gsShapes[level]) {
+      _geomSeq->boxSlice(r.xMin(), r.yMin(), r.xMax(), r.yMax(), level);
+    }
+  }
+
   return pcnt + scnt;
 }
 
@@ -1365,6 +1380,7 @@ uint extMain::couplingFlow(Rect& extRect,
 
   delete _geomSeq;
   _geomSeq = nullptr;
+  _gsShapes.clear();
 
   for (uint jj = 0; jj < layerCnt; jj++) {
     delete[] limitArray[jj];
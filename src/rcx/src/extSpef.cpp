@@ -32,13 +32,21 @@
 
 #include "rcx/extSpef.h"
 
+#include <omp.h>
+
 #include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "name.h"
 #include "odb/dbExtControl.h"
 #include "odb/parse.h"
 #include "rcx/extRCap.h"
+#include "spefWriter.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace rcx {
 
@@ -89,6 +97,10 @@ extSpef::extSpef(odb::dbTech* tech,
 
 extSpef::~extSpef()
 {
+  if (_outWriter != nullptr) {
+    flushOut();
+    _outWriter->finish();
+  }
   delete _idMapTable;
   delete _nodeParser;
   delete _parser;
@@ -290,7 +302,7 @@ void extSpef::writeNameNode(odb::dbCapNode* node)
     sprintf(_msgBuf1, "%s ", p->getValue().c_str());
     strcat(_bufString, _msgBuf1);
   } else {
-    fprintf(_outFP, "%s ", p->getValue().c_str());
+    writeOut("{} ", p->getValue().c_str());
   }
 }
 
@@ -320,17 +332,15 @@ void extSpef::writeITermNode(const uint node)
     strcat(_bufString, _msgBuf1);
   } else {
     if (_writeNameMap) {
-      fprintf(_outFP,
-              "*%d%s%s ",
-              getInstMapId(inst->getId()),
-              _delimiter,
-              addEscChar(iterm->getMTerm()->getName(inst, &ttname[0]), false));
+      writeOut("*{}{}{} ",
+               getInstMapId(inst->getId()),
+               _delimiter,
+               addEscChar(iterm->getMTerm()->getName(inst, &ttname[0]), false));
     } else {
-      fprintf(_outFP,
-              "%s%s%s ",
-              addEscChar(tinkerSpefName((char*) inst->getConstName()), true),
-              _delimiter,
-              addEscChar(iterm->getMTerm()->getName(inst, &ttname[0]), false));
+      writeOut("{}{}{} ",
+               addEscChar(tinkerSpefName((char*) inst->getConstName()), true),
+               _delimiter,
+               addEscChar(iterm->getMTerm()->getName(inst, &ttname[0]), false));
     }
   }
 }
@@ -342,11 +352,11 @@ void extSpef::writeITerm(const uint node)
     return;
   }
 
-  fprintf(_outFP, "*I ");
+  writeOut("*I ");
   writeITermNode(node);
 
   const char io = iterm->getIoType().getString()[0];
-  fprintf(_outFP, "%c ", io);
+  writeOut("{} ", io);
   const int dbunit = _block->getDbUnitsPerMicron();
   const double db2nm = 1.0 / dbunit;
   if (_writingNodeCoords == C_ON) {
@@ -364,11 +374,11 @@ void extSpef::writeITerm(const uint node)
       iterm->getAvgXY(&x1, &y1);
       pt = {x1, y1};
     }
-    fprintf(_outFP, "*C %f %f ", db2nm * pt.x(), db2nm * pt.y());
+    writeOut("*C {:f} {:f} ", db2nm * pt.x(), db2nm * pt.y());
   }
-  fprintf(_outFP,
-          "*D %s\n",
-          addEscChar(iterm->getMTerm()->getMaster()->getName().c_str(), false));
+  writeOut(
+      "*D {}\n",
+      addEscChar(iterm->getMTerm()->getMaster()->getName().c_str(), false));
 }
 
 void extSpef::writeBTerm(const uint node)
@@ -378,7 +388,7 @@ void extSpef::writeBTerm(const uint node)
     sprintf(_msgBuf1, "%s ", addEscChar(bterm->getName().c_str(), false));
     strcat(_bufString, _msgBuf1);
   } else {
-    fprintf(_outFP, "%s ", addEscChar(bterm->getName().c_str(), false));
+    writeOut("{} ", addEscChar(bterm->getName().c_str(), false));
   }
 }
 
@@ -398,13 +408,12 @@ void extSpef::writeNode(const uint netId, const uint node)
     strcat(_bufString, _msgBuf1);
   } else {
     if (_writeNameMap) {
-      fprintf(_outFP, "*%d%s%d ", netId, _delimiter, node);
+      writeOut("*{}{}{} ", netId, _delimiter, node);
     } else {
-      fprintf(_outFP,
-              "%s%s%d ",
-              addEscChar(tinkerSpefName((char*) tnet->getConstName()), false),
-              _delimiter,
-              node);
+      writeOut("{}{}{} ",
+               addEscChar(tinkerSpefName((char*) tnet->getConstName()), false),
+               _delimiter,
+               node);
     }
   }
 }
@@ -449,7 +458,7 @@ void extSpef::writeCapITerm(const uint node, const uint capIndex)
   writeITermNode(node);
   writeRCvalue(_nodeCapTable->geti(capIndex), _cap_unit);
 
-  fprintf(_outFP, "\n");
+  writeOut("\n");
 }
 
 void extSpef::writeCapName(odb::dbCapNode* capNode, const uint capIndex)
@@ -459,7 +468,7 @@ void extSpef::writeCapName(odb::dbCapNode* capNode, const uint capIndex)
   writeNameNode(capNode);
   writeRCvalue(_nodeCapTable->geti(capIndex), _cap_unit);
 
-  fprintf(_outFP, "\n");
+  writeOut("\n");
 }
 
 void extSpef::writeCapPort(const uint node, const uint capIndex)
@@ -469,18 +478,17 @@ void extSpef::writeCapPort(const uint node, const uint capIndex)
   writeBTerm(node);
 
   writeRCvalue(_nodeCapTable->geti(capIndex), _cap_unit);
-  fprintf(_outFP, "\n");
+  writeOut("\n");
 }
 
 void extSpef::writePort(const uint node)
 {
   odb::dbBTerm* bterm = odb::dbBTerm::getBTerm(_block, node);
-  fprintf(_outFP,
-          "*P %s %c",
-          addEscChar(bterm->getName().c_str(), false),
-          bterm->getIoType().getString()[0]);
+  writeOut("*P {} {}",
+           addEscChar(bterm->getName().c_str(), false),
+           bterm->getIoType().getString()[0]);
   if (_writingNodeCoords != C_ON) {
-    fprintf(_outFP, "\n");
+    writeOut("\n");
     return;
   }
   const int dbunit = _block->getDbUnitsPerMicron();
@@ -499,24 +507,23 @@ void extSpef::writePort(const uint node)
     bterm->getFirstPinLocation(x1, y1);
     pt = {x1, y1};
   }
-  fprintf(_outFP, " *C %f %f\n", db2nm * pt.x(), db2nm * pt.y());
+  writeOut(" *C {:f} {:f}\n", db2nm * pt.x(), db2nm * pt.y());
 }
 
 void extSpef::writeSingleRC(const double val, const bool delimeter)
 {
   if (delimeter) {
-    fprintf(_outFP, "%s%g", _delimiter, val * _cap_unit);
+    writeOut("{}{:g}", _delimiter, val * _cap_unit);
   } else {
-    fprintf(_outFP, "%g", val * _cap_unit);
+    writeOut("{:g}", val * _cap_unit);
   }
 }
 
 void extSpef::writeRCvalue(const double* totCap, const double units)
 {
-  fprintf(_outFP, "%g", totCap[_active_corner_number[0]] * units);
+  writeOut("{:g}", totCap[_active_corner_number[0]] * units);
   for (int ii = 1; ii < _active_corner_cnt; ii++) {
-    fprintf(
-        _outFP, "%s%g", _delimiter, totCap[_active_corner_number[ii]] * units);
+    writeOut("{}{:g}", _delimiter, totCap[_active_corner_number[ii]] * units);
   }
 }
 
@@ -525,19 +532,18 @@ void extSpef::writeDnet(uint netId, const double* totCap)
   netId = getNetMapId(netId);
 
   if (_writeNameMap) {
-    fprintf(_outFP, "\n*D_NET *%d ", netId);
+    writeOut("\n*D_NET *{} ", netId);
   } else {
-    fprintf(_outFP,
-            "\n*D_NET %s ",
-            addEscChar(tinkerSpefName((char*) _d_net->getConstName()), false));
+    writeOut("\n*D_NET {} ",
+             addEscChar(tinkerSpefName((char*) _d_net->getConstName()), false));
   }
   writeRCvalue(totCap, _cap_unit);
-  fprintf(_outFP, "\n");
+  writeOut("\n");
 }
 
 void extSpef::writeKeyword(const char* keyword)
 {
-  fprintf(_outFP, "%s\n", keyword);
+  writeOut("{}\n", keyword);
 }
 
 void extSpef::addCap(const double* cap, double* totCap, const uint n)
@@ -709,7 +715,7 @@ void extSpef::writeCNodeNumber()
   if (_noCnum) {
     return;
   }
-  fprintf(_outFP, "%d ", _cCnt++);
+  writeOut("{} ", _cCnt++);
 }
 
 void extSpef::writeNodeCap(const uint netId, const uint capIndex, const uint ii)
@@ -717,7 +723,7 @@ void extSpef::writeNodeCap(const uint netId, const uint capIndex, const uint ii)
   writeCNodeNumber();
   writeNode(netId, ii);
   writeRCvalue(_nodeCapTable->geti(capIndex), _cap_unit);
-  fprintf(_outFP, "\n");
+  writeOut("\n");
 }
 
 void extSpef::writePorts(odb::dbNet* net)
@@ -747,7 +753,7 @@ void extSpef::writeInternalCaps(odb::dbNet* net,
       writeSingleRC(capNode->getCapacitance(_active_corner_number[ii]), true);
     }
 
-    fprintf(_outFP, "\n");
+    writeOut("\n");
   }
 }
 
@@ -783,7 +789,7 @@ void extSpef::writeCapPortsAndIterms(odb::dbSet<odb::dbCapNode>& capSet,
       writeSingleRC(capNode->getCapacitance(_active_corner_number[ii]), true);
     }
 
-    fprintf(_outFP, "\n");
+    writeOut("\n");
   }
 }
 
@@ -804,9 +810,9 @@ void extSpef::writeITerms(odb::dbNet* net)
     if (capNode->isITerm()) {
       writeITerm(capNode->getNode());
     } else if (capNode->isName()) {
-      fprintf(_outFP, "*I ");
+      writeOut("*I ");
       writeNameNode(capNode);
-      fprintf(_outFP, "\n");
+      writeOut("\n");
     }
   }
 }
@@ -933,15 +939,13 @@ void extSpef::writeCouplingCapsNoSort(odb::dbSet<odb::dbCCSeg>& capSet,
     writeCapNode(cc->getSourceCapNode()->getId(), netId);
     writeCapNode(cc->getTargetCapNode()->getId(), netId);
 
-    fprintf(
-        _outFP, "%g", cc->getCapacitance(_active_corner_number[0]) * _cap_unit);
+    writeOut("{:g}", cc->getCapacitance(_active_corner_number[0]) * _cap_unit);
     for (int ii = 1; ii < _active_corner_cnt; ii++) {
-      fprintf(_outFP,
-              "%s%g",
-              _delimiter,
-              cc->getCapacitance(_active_corner_number[ii]) * _cap_unit);
+      writeOut("{}{:g}",
+               _delimiter,
+               cc->getCapacitance(_active_corner_number[ii]) * _cap_unit);
     }
-    fprintf(_outFP, "\n");
+    writeOut("\n");
   }
 }
 
@@ -960,15 +964,13 @@ void extSpef::writeCouplingCaps(odb::dbSet<odb::dbCCSeg>& capSet,
     writeCapNode(cc->getSourceCapNode()->getId(), netId);
     writeCapNode(cc->getTargetCapNode()->getId(), netId);
 
-    fprintf(
-        _outFP, "%g", cc->getCapacitance(_active_corner_number[0]) * _cap_unit);
+    writeOut("{:g}", cc->getCapacitance(_active_corner_number[0]) * _cap_unit);
     for (int ii = 1; ii < _active_corner_cnt; ii++) {
-      fprintf(_outFP,
-              "%s%g",
-              _delimiter,
-              cc->getCapacitance(_active_corner_number[ii]) * _cap_unit);
+      writeOut("{}{:g}",
+               _delimiter,
+               cc->getCapacitance(_active_corner_number[ii]) * _cap_unit);
     }
-    fprintf(_outFP, "\n");
+    writeOut("\n");
   }
 }
 
@@ -1029,16 +1031,14 @@ void extSpef::writeCouplingCaps(const std::vector<odb::dbCCSeg*>& vec_cc,
     writeCapNode(cc->getSourceCapNode(), netId);
     writeCapNode(cc->getTargetCapNode(), netId);
 
-    fprintf(
-        _outFP, "%g", cc->getCapacitance(_active_corner_number[0]) * _cap_unit);
+    writeOut("{:g}", cc->getCapacitance(_active_corner_number[0]) * _cap_unit);
     for (int ii = 1; ii < _active_corner_cnt; ii++) {
-      fprintf(_outFP,
-              "%s%g",
-              _delimiter,
-              cc->getCapacitance(_active_corner_number[ii]) * _cap_unit);
+      writeOut("{}{:g}",
+               _delimiter,
+               cc->getCapacitance(_active_corner_number[ii]) * _cap_unit);
     }
 
-    fprintf(_outFP, "\n");
+    writeOut("\n");
   }
 }
 
@@ -1065,13 +1065,13 @@ void extSpef::writeNodeCoords(const uint netId, odb::dbSet<odb::dbRSeg>& rSet)
       continue;
     }
 
-    fprintf(_outFP, "*N ");
+    writeOut("*N ");
     writeCapNode(rc->getTargetNode(), netId);
 
     int x1, y1;
     rc->getCoords(x1, y1);
 
-    fprintf(_outFP, "*C %f %f\n", db2nm * x1, db2nm * y1);
+    writeOut("*C {:f} {:f}\n", db2nm * x1, db2nm * y1);
   }
 }
 
@@ -1102,33 +1102,51 @@ void extSpef::writeRes(const uint netId, odb::dbSet<odb::dbRSeg>& rSet)
       continue;
     }
 
-    fprintf(_outFP, "%d ", cnt++);
+    writeOut("{} ", cnt++);
     writeCapNode(rc->getSourceNode(), netId);
     writeCapNode(rc->getTargetNode(), netId);
 
-    fprintf(
-        _outFP, "%g", rc->getResistance(_active_corner_number[0]) * _res_unit);
+    writeOut("{:g}", rc->getResistance(_active_corner_number[0]) * _res_unit);
     for (int ii = 1; ii < _active_corner_cnt; ii++) {
-      fprintf(_outFP,
-              "%s%g",
-              _delimiter,
-              rc->getResistance(_active_corner_number[ii]) * _res_unit);
+      writeOut("{}{:g}",
+               _delimiter,
+               rc->getResistance(_active_corner_number[ii]) * _res_unit);
     }
-    fprintf(_outFP, " \n");
+    writeOut(" \n");
+  }
+}
+
+odb::dbNet* extSpef::getCornerNet(odb::dbNet* net)
+{
+  if (_cornerBlock && _cornerBlock != _block) {
+    return odb::dbNet::getNet(_cornerBlock, net->getId());
   }
+  return net;
 }
 
 void extSpef::writeNet(odb::dbNet* net, const double resBound, const uint debug)
+{
+  odb::dbNet* cornerNet = getCornerNet(net);
+
+  uint minNode;
+  const uint capNodeCnt = getMinCapNode(cornerNet, &minNode);
+  writeNetRC(net, capNodeCnt, minNode);
+
+  for (odb::dbCapNode* node : cornerNet->getCapNodes()) {
+    node->setSortIndex(0);
+  }
+}
+
+// The cap node sort indices of the net must be set by getMinCapNode.
+void extSpef::writeNetRC(odb::dbNet* net,
+                         const uint capNodeCnt,
+                         const uint minNode)
 {
   _d_net = net;
   const uint netId = net->getId();
 
-  if (_cornerBlock && _cornerBlock != _block) {
-    net = odb::dbNet::getNet(_cornerBlock, netId);
-  }
+  net = getCornerNet(net);
 
-  uint minNode;
-  const uint capNodeCnt = getMinCapNode(net, &minNode);
   if (capNodeCnt) {
     odb::dbSet<odb::dbRSeg> rcSet = net->getRSegs();
     _cCnt = 1;
@@ -1208,8 +1226,110 @@ void extSpef::writeNet(odb::dbNet* net, const double resBound, const uint debug)
     }
     writeKeyword("*END");
   }
-  for (odb::dbCapNode* node : net->getCapNodes()) {
-    node->setSortIndex(0);
+}
+
+void extSpef::initNetWriter(const extSpef& spef)
+{
+  _cornerBlock = spef._cornerBlock;
+  _cornerCnt = spef._cornerCnt;
+  _cornersPerBlock = spef._cornersPerBlock;
+  _db_ext_corner = spef._db_ext_corner;
+  _active_corner_cnt = spef._active_corner_cnt;
+  std::copy(std::begin(spef._active_corner_number),
+            std::end(spef._active_corner_number),
+            std::begin(_active_corner_number));
+  _cap_unit = spef._cap_unit;
+  _res_unit = spef._res_unit;
+  strcpy(_delimiter, spef._delimiter);
+
+  _writeNameMap = spef._writeNameMap;
+  _baseNameMap = spef._baseNameMap;
+  _childBlockNetBaseMap = spef._childBlockNetBaseMap;
+  _childBlockInstBaseMap = spef._childBlockInstBaseMap;
+  _wConn = spef._wConn;
+  _wCap = spef._wCap;
+  _wOnlyCCcap = spef._wOnlyCCcap;
+  _wRes = spef._wRes;
+  _noCnum = spef._noCnum;
+  _noBackSlash = spef._noBackSlash;
+  _foreign = spef._foreign;
+  _writingNodeCoords = spef._writingNodeCoords;
+  _termJxy = spef._termJxy;
+  _symmetricCCcaps = spef._symmetricCCcaps;
+  _preserveCapValues = spef._preserveCapValues;
+  _singleP = spef._singleP;
+
+  if (!_preserveCapValues) {
+    setupMappingForWrite();
+  }
+}
+
+// The nets are written in batches. Each thread formats whole nets with its
+// own extSpef into a per-net buffer and the buffers are appended in net
+// order, so the output does not depend on the thread count.
+void extSpef::writeNets(const std::vector<odb::dbNet*>& nets)
+{
+  constexpr uint repChunk = 100000;
+  constexpr uint batchSize = 5000;  // divides repChunk
+
+  const int threads = std::max(_ext->_threads, 1);
+  std::vector<std::unique_ptr<extSpef>> writers;
+  if (threads > 1) {
+    for (int ii = 0; ii < threads; ii++) {
+      writers.push_back(
+          std::make_unique<extSpef>(_tech, _block, logger_, _version, _ext));
+      writers.back()->initNetWriter(*this);
+    }
+  }
+
+  std::vector<uint> capNodeCnts(batchSize);
+  std::vector<uint> minNodes(batchSize);
+  std::vector<std::string> netText(batchSize);
+
+  for (uint start = 0; start < nets.size(); start += batchSize) {
+    const uint end = std::min<uint>(start + batchSize, nets.size());
+
+    if (writers.empty()) {
+      for (uint ii = start; ii < end; ii++) {
+        writeNet(nets[ii], 0.0, 0);
+      }
+    } else {
+      // The sort indices share a word with the cap node flags read while
+      // writing coupled nets, so they are only set and cleared here.
+      for (uint ii = start; ii < end; ii++) {
+        capNodeCnts[ii - start]
+            = getMinCapNode(getCornerNet(nets[ii]), &minNodes[ii - start]);
+      }
+
+      utl::ThreadException exception;
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+      for (int ii = start; ii < (int) end; ii++) {
+        try {
+          extSpef* writer = writers[omp_get_thread_num()].get();
+          writer->writeNetRC(
+              nets[ii], capNodeCnts[ii - start], minNodes[ii - start]);
+          netText[ii - start].swap(writer->_outBuf);
+          writer->_outBuf.clear();
+        } catch (...) {
+          exception.capture();
+        }
+      }
+      exception.rethrow();
+
+      for (uint ii = start; ii < end; ii++) {
+        for (odb::dbCapNode* node : getCornerNet(nets[ii])->getCapNodes()) {
+          node->setSortIndex(0);
+        }
+        _outBuf += netText[ii - start];
+        if (_outBuf.size() >= _outChunkSize) {
+          flushOut();
+        }
+      }
+    }
+
+    if (end % repChunk == 0) {
+      logger_->info(RCX, 42, "{} nets finished", end);
+    }
   }
 }
 
@@ -1251,15 +1371,32 @@ bool extSpef::setOutSpef(const char* filename)
     fprintf(stderr, "Cannot open file %s with permissions \"w\"", filename);
     return false;
   }
+  _outBuf.clear();
+  _outBuf.reserve(_outChunkSize + 4096);
+  _outWriter = std::make_unique<SpefFileWriter>(_outFP, _outFile, logger_);
   return true;
 }
 
+void extSpef::flushOut()
+{
+  if (_outWriter == nullptr) {
+    return;
+  }
+  std::string chunk;
+  chunk.reserve(_outChunkSize + 4096);
+  chunk.swap(_outBuf);
+  _outWriter->write(std::move(chunk));
+}
+
 bool extSpef::closeOutFile()
 {
   if (_outFP == nullptr) {
     return false;
   }
 
+  flushOut();
+  _outWriter.reset();
+
   if (_gzipFlag) {
     pclose(_outFP);
   } else {
@@ -1288,10 +1425,9 @@ void extSpef::writeBlockPorts()
     }
     bterm->setMark(0);
 
-    fprintf(_outFP,
-            "%s %c\n",
-            addEscChar(bterm->getName().c_str(), false),
-            bterm->getIoType().getString()[0]);
+    writeOut("{} {}\n",
+             addEscChar(bterm->getName().c_str(), false),
+             bterm->getIoType().getString()[0]);
   }
 }
 
@@ -1401,7 +1537,7 @@ void extSpef::writeNetMap(odb::dbSet<odb::dbNet>& nets)
     const char* nname = net->getConstName();
     const char* nname1 = tinkerSpefName(nname);
     nname1 = addEscChar(nname1, false);
-    fprintf(_outFP, "*%d %s\n", netMapId, nname1);
+    writeOut("*{} {}\n", netMapId, nname1);
   }
 }
 
@@ -1434,7 +1570,7 @@ void extSpef::writeInstMap()
     const char* nname = inst->getConstName();
     const char* nname1 = tinkerSpefName(nname);
     nname1 = addEscChar(nname1, true);
-    fprintf(_outFP, "*%d %s\n", instMapId, nname1);
+    writeOut("*{} {}\n", instMapId, nname1);
   }
 }
 
@@ -1561,7 +1697,7 @@ void extSpef::writeBlock(const char* nodeCoord,
   _cornersPerBlock = _cornerCnt;
   _cornerBlock = _block;
 
-  uint cnt = 0;
+  std::vector<odb::dbNet*> nets;
 
   for (odb::dbNet* net : _block->getNets()) {
     if (!tnets.empty() && !net->isMarked()) {
@@ -1577,18 +1713,14 @@ void extSpef::writeBlock(const char* nodeCoord,
       continue;
     }
 
-    writeNet(net, 0.0, 0);
-    ++cnt;
-
-    constexpr uint repChunk = 100000;
-    if (cnt % repChunk == 0) {
-      logger_->info(RCX, 42, "{} nets finished", cnt);
-    }
+    nets.push_back(net);
   }
+  writeNets(nets);
+
   for (odb::dbNet* net : tnets) {
     net->setMark(false);
   }
-  logger_->info(RCX, 443, "{} nets finished", cnt);
+  logger_->info(RCX, 443, "{} nets finished", nets.size());
 
   closeOutFile();
 }
@@ -1636,8 +1768,8 @@ uint extSpef::getMappedBTermId(const uint spefId)
 
 void extSpef::writeHeaderInfo()
 {
-  fprintf(_outFP, "*SPEF \"ieee 1481-1999\"\n");
-  fprintf(_outFP, "*DESIGN \"%s\"\n", _design);
+  writeOut("*SPEF \"ieee 1481-1999\"\n");
+  writeOut("*DESIGN \"{}\"\n", _design);
 
   std::time_t currentTime = std::time(nullptr);
 
@@ -1648,19 +1780,19 @@ void extSpef::writeHeaderInfo()
                 "%H:%M:%S %A %B %d, %Y",
                 std::localtime(&currentTime));
 
-  fprintf(_outFP, "*DATE \"%s\"\n", buffer);
-
-  fprintf(_outFP, "*VENDOR \"The OpenROAD Project\"\n");
-  fprintf(_outFP, "*PROGRAM \"OpenROAD\"\n");
-  fprintf(_outFP, "*VERSION \"%s\"\n", _version);
-  fprintf(_outFP, "*DESIGN_FLOW \"NAME_SCOPE LOCAL\" \"PIN_CAP NONE\"\n");
-  fprintf(_outFP, "*DIVIDER %s\n", _divider);
-  fprintf(_outFP, "*DELIMITER %s\n", _delimiter);
-  fprintf(_outFP, "*BUS_DELIMITER %s\n", _bus_delimiter);
-  fprintf(_outFP, "*T_UNIT %d %s\n", _time_unit, _time_unit_word);
-  fprintf(_outFP, "*C_UNIT %d %s\n", 1, _cap_unit_word);
-  fprintf(_outFP, "*R_UNIT %d %s\n", 1, _res_unit_word);
-  fprintf(_outFP, "*L_UNIT %d %s\n", _ind_unit, _ind_unit_word);
+  writeOut("*DATE \"{}\"\n", buffer);
+
+  writeOut("*VENDOR \"The OpenROAD Project\"\n");
+  writeOut("*PROGRAM \"OpenROAD\"\n");
+  writeOut("*VERSION \"{}\"\n", _version);
+  writeOut("*DESIGN_FLOW \"NAME_SCOPE LOCAL\" \"PIN_CAP NONE\"\n");
+  writeOut("*DIVIDER {}\n", _divider);
+  writeOut("*DELIMITER {}\n", _delimiter);
+  writeOut("*BUS_DELIMITER {}\n", _bus_delimiter);
+  writeOut("*T_UNIT {} {}\n", _time_unit, _time_unit_word);
+  writeOut("*C_UNIT {} {}\n", 1, _cap_unit_word);
+  writeOut("*R_UNIT {} {}\n", 1, _res_unit_word);
+  writeOut("*L_UNIT {} {}\n", _ind_unit, _ind_unit_word);
 }
 
 }  // namespace rcx
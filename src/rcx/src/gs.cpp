@@ -30,6 +30,7 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -212,6 +213,30 @@ static int clip(const int p, const int min, const int max)
 }
 
 int gs::box(int px0, int py0, int px1, int py1, int sl)
+{
+  if (check_slice(sl) == 0 && (init_ & GS_ALL)) {
+    if (sl > maxslice_) {
+      maxslice_ = sl;
+    }
+    plc_ = pldata_[sl];
+  }
+
+  return boxSlice(px0, py0, px1, py1, sl);
+}
+
+bool gs::overlapsSlice(int px0, int py0, int px1, int py1, int sl) const
+{
+  if ((sl < 0) || (sl > nslices_) || !(init_ & GS_ALL)) {
+    return false;
+  }
+
+  const plconfig* plc = pldata_[sl];
+
+  return std::max(px0, px1) >= plc->x0 && std::min(px0, px1) <= plc->x1
+         && std::max(py0, py1) >= plc->y0 && std::min(py0, py1) <= plc->y1;
+}
+
+int gs::boxSlice(int px0, int py0, int px1, int py1, int sl) const
 {
   if ((sl < 0) || (sl > nslices_)) {
     fprintf(stderr,
@@ -226,11 +251,7 @@ int gs::box(int px0, int py0, int px1, int py1, int sl)
     return -1;
   }
 
-  if (sl > maxslice_) {
-    maxslice_ = sl;
-  }
-
-  plc_ = pldata_[sl];
+  const plconfig* plc = pldata_[sl];
 
   // normalize bbox
   if (px0 > px1) {
@@ -240,30 +261,30 @@ int gs::box(int px0, int py0, int px1, int py1, int sl)
     std::swap(py0, py1);
   }
 
-  if (px1 < plc_->x0) {
+  if (px1 < plc->x0) {
     return -1;
   }
-  if (px0 > plc_->x1) {
+  if (px0 > plc->x1) {
     return -1;
   }
-  if (py1 < plc_->y0) {
+  if (py1 < plc->y0) {
     return -1;
   }
-  if (py0 > plc_->y1) {
+  if (py0 > plc->y1) {
     return -1;
   }
 
   // convert to pixel space
-  int cx0 = int((px0 - plc_->x0) / plc_->xres);
-  int cx1 = int((px1 - plc_->x0) / plc_->xres);
-  int cy0 = int((py0 - plc_->y0) / plc_->yres);
-  int cy1 = int((py1 - plc_->y0) / plc_->yres);
+  int cx0 = int((px0 - plc->x0) / plc->xres);
+  int cx1 = int((px1 - plc->x0) / plc->xres);
+  int cy0 = int((py0 - plc->y0) / plc->yres);
+  int cy1 = int((py1 - plc->y0) / plc->yres);
 
   // render a rectangle on the selected slice. Paint all pixels
-  cx0 = clip(cx0, 0, plc_->width);
-  cx1 = clip(cx1, 0, plc_->width);
-  cy0 = clip(cy0, 0, plc_->height);
-  cy1 = clip(cy1, 0, plc_->height);
+  cx0 = clip(cx0, 0, plc->width);
+  cx1 = clip(cx1, 0, plc->width);
+  cy0 = clip(cy0, 0, plc->height);
+  cy1 = clip(cy1, 0, plc->height);
   // now fill in planes object
 
   // xbs = x block start - block the box starts in
@@ -278,14 +299,14 @@ int gs::box(int px0, int py0, int px1, int py1, int sl)
     smask &= emask;
   }
 
-  pixmap* pm = plc_->plane + plc_->pixstride * cy0 + xbs;
+  pixmap* pm = plc->plane + plc->pixstride * cy0 + xbs;
 
   for (int yb = cy0; yb <= cy1; yb++) {
     // start block
     pixmap* pcb = pm;
 
     // for next time through loop - allow compiler time for out-of-order
-    pm += plc_->pixstride;
+    pm += plc->pixstride;
 
     // do "start" block
     pcb->lword = pcb->lword | smask;
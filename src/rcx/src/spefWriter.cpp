@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "spefWriter.h"
+
+#include "utl/Logger.h"
+
+namespace rcx {
+
+SpefFileWriter::SpefFileWriter(FILE* file,
+                               const std::string& filename,
+                               utl::Logger* logger)
+    : file_(file), filename_(filename), logger_(logger)
+{
+  thread_ = std::thread(&SpefFileWriter::run, this);
+}
+
+SpefFileWriter::~SpefFileWriter()
+{
+  finish();
+}
+
+void SpefFileWriter::write(std::string&& chunk)
+{
+  if (chunk.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  has_space_.wait(lock, [this] { return pending_.size() < max_pending_; });
+  pending_.push_back(std::move(chunk));
+  has_chunk_.notify_one();
+}
+
+void SpefFileWriter::finish()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+  }
+  has_chunk_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (failed_) {
+    failed_ = false;
+    logger_->warn(utl::RCX, 492, "Failed to write SPEF file {}.", filename_);
+  }
+}
+
+void SpefFileWriter::run()
+{
+  while (true) {
+    std::string chunk;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      has_chunk_.wait(lock, [this] { return finished_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      chunk = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    has_space_.notify_one();
+    if (failed_) {
+      continue;
+    }
+    if (fwrite(chunk.data(), 1, chunk.size(), file_) != chunk.size()) {
+      failed_ = true;
+    }
+  }
+}
+
+}  // namespace rcx
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace utl {
+class Logger;
+}
+
+namespace rcx {
+
+// Writes chunks of formatted SPEF text to a file from a dedicated thread so
+// the caller can keep formatting while the previous chunk is written (and
+// compressed when the file is a gzip pipe).  Chunks are written in the order
+// they were queued, so the output is identical to writing them directly.
+// A failed write stops the output and is reported by finish().
+class SpefFileWriter
+{
+ public:
+  SpefFileWriter(FILE* file, const std::string& filename, utl::Logger* logger);
+  ~SpefFileWriter();
+
+  // Queues a chunk; blocks while too many chunks are pending.
+  void write(std::string&& chunk);
+  // Waits until every queued chunk has been written and stops the thread.
+  void finish();
+
+ private:
+  void run();
+
+  static constexpr size_t max_pending_ = 4;
+
+  FILE* file_;
+  std::string filename_;
+  utl::Logger* logger_;
+  std::deque<std::string> pending_;
+  std::mutex mutex_;
+  std::condition_variable has_chunk_;
+  std::condition_variable has_space_;
+  bool finished_ = false;
+  // Only accessed by the writer thread until it is joined.
+  bool failed_ = false;
+  std::thread thread_;
+};
+
+}  // namespace rcx
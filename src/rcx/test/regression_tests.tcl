@@ -5,6 +5,7 @@ record_tests {
   gcd 
   45_gcd
   names
+  spef_threads
   #rcx_man_tcl_check
   #rcx_readme_msgs_check
 }
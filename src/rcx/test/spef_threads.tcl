@@ -0,0 +1,25 @@
+# write_spef with several threads matches the serial output
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file ext_pattern.rules \
+      -max_res 0 -coupling_threshold 0.1
+
+set spef_file1 [make_result_file spef_threads1.spef]
+write_spef $spef_file1
+
+set_thread_count 4
+set spef_file4 [make_result_file spef_threads4.spef]
+write_spef $spef_file4
+
+diff_files gcd.spefok $spef_file1 "^\\*(DATE|VERSION)"
+diff_files $spef_file1 $spef_file4 "^\\*(DATE|VERSION)"
@@ -38,6 +38,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 #include "db_sta/dbSta.hh"
 #include "dpl/Opendp.h"
@@ -221,13 +222,17 @@ class Resizer : public StaState
   double wireClkHCapacitance(const Corner* corner) const;
   double wireClkVCapacitance(const Corner* corner) const;
   void estimateParasitics(ParasiticsSrc src);
-  void estimateWireParasitics();
+  // Placement parasitics for every net.  Steiner trees are built on
+  // setNumThreads threads.  When incremental is true only nets whose pin
+  // locations changed since the previous placement estimate are re-estimated.
+  void estimateWireParasitics(bool incremental = false);
   void estimateWireParasitic(const Net* net);
   void estimateWireParasitic(const Pin* drvr_pin, const Net* net);
   bool haveEstimatedParasitics() const;
   void parasiticsInvalid(const Net* net);
   void parasiticsInvalid(const dbNet* net);
   bool parasiticsValid() const;
+  void setNumThreads(int threads) { num_threads_ = threads; }
 
   // Core area (meters).
   double coreArea() const;
@@ -533,11 +538,14 @@ class Resizer : public StaState
   void ensureWireParasitic(const Pin* drvr_pin);
   void ensureWireParasitic(const Pin* drvr_pin, const Net* net);
   void estimateWireParasiticSteiner(const Pin* drvr_pin, const Net* net);
+  void makeWireParasitic(const Net* net, SteinerTree* tree);
+  size_t pinLocationHash(const Net* net) const;
   float totalLoad(SteinerTree* tree) const;
   float subtreeLoad(SteinerTree* tree,
                     float cap_per_micron,
                     SteinerPt pt) const;
   void makePadParasitic(const Net* net);
+  bool needsWireParasitic(const Pin* drvr_pin, const Net* net) const;
   bool isPadNet(const Net* net) const;
   bool isPadPin(const Pin* pin) const;
   bool isPad(const Instance* inst) const;
@@ -648,6 +656,9 @@ class Resizer : public StaState
 
   ParasiticsSrc parasitics_src_ = ParasiticsSrc::none;
   UnorderedSet<const Net*, NetHash> parasitics_invalid_;
+  // Pin location hash of each net at its last placement estimate.
+  std::unordered_map<const Net*, size_t> net_pin_loc_hash_;
+  int num_threads_ = 1;
 
   double design_area_ = 0.0;
   const MinMax* min_ = MinMax::min();
@@ -33,6 +33,9 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <functional>
+
 #include "SteinerTree.hh"
 #include "db_sta/dbNetwork.hh"
 #include "grt/GlobalRouter.h"
@@ -57,6 +60,9 @@ using sta::PinSet;
 using odb::dbInst;
 using odb::dbMasterType;
 
+// Nets whose Steiner trees are built in parallel before they are annotated.
+static constexpr int estimate_batch_size = 10000;
+
 ////////////////////////////////////////////////////////////////
 
 void Resizer::setLayerRC(dbTechLayer* layer,
@@ -103,6 +109,7 @@ void Resizer::setHWireSignalRC(const Corner* corner, double res, double cap)
   wire_signal_cap_.resize(sta_->corners()->count());
   wire_signal_res_[corner->index()].h_res = res;
   wire_signal_cap_[corner->index()].h_cap = cap;
+  net_pin_loc_hash_.clear();
 }
 void Resizer::setVWireSignalRC(const Corner* corner, double res, double cap)
 {
@@ -110,6 +117,7 @@ void Resizer::setVWireSignalRC(const Corner* corner, double res, double cap)
   wire_signal_cap_.resize(sta_->corners()->count());
   wire_signal_res_[corner->index()].v_res = res;
   wire_signal_cap_[corner->index()].v_cap = cap;
+  net_pin_loc_hash_.clear();
 }
 
 double Resizer::wireSignalResistance(const Corner* corner) const
@@ -191,6 +199,7 @@ void Resizer::setHWireClkRC(const Corner* corner, double res, double cap)
   wire_clk_cap_.resize(sta_->corners()->count());
   wire_clk_res_[corner->index()].h_res = res;
   wire_clk_cap_[corner->index()].h_cap = cap;
+  net_pin_loc_hash_.clear();
 }
 
 void Resizer::setVWireClkRC(const Corner* corner, double res, double cap)
@@ -199,6 +208,7 @@ void Resizer::setVWireClkRC(const Corner* corner, double res, double cap)
   wire_clk_cap_.resize(sta_->corners()->count());
   wire_clk_res_[corner->index()].v_res = res;
   wire_clk_cap_[corner->index()].v_cap = cap;
+  net_pin_loc_hash_.clear();
 }
 
 double Resizer::wireClkResistance(const Corner* corner) const
@@ -386,7 +396,10 @@ void Resizer::ensureWireParasitic(const Pin* drvr_pin, const Net* net)
 
 ////////////////////////////////////////////////////////////////
 
-void Resizer::estimateWireParasitics()
+// Steiner trees only depend on the pin locations so they are built on
+// num_threads_ threads a batch of nets at a time.  The parasitics are then
+// made serially in net order because the STA parasitics are not thread safe.
+void Resizer::estimateWireParasitics(bool incremental)
 {
   initBlock();
   if (!wire_signal_cap_.empty()) {
@@ -394,18 +407,99 @@ void Resizer::estimateWireParasitics()
     // Make separate parasitics for each corner, same for min/max.
     sta_->setParasiticAnalysisPts(true);
 
+    incremental &= parasitics_src_ == ParasiticsSrc::placement;
+    if (!incremental) {
+      net_pin_loc_hash_.clear();
+    }
+    const Corner* corner = sta_->corners()->findCorner(0);
+    const ParasiticAnalysisPt* parasitic_ap
+        = corner->findParasiticAnalysisPt(max_);
+
+    vector<const Pin*> drvr_pins;
+    vector<const Net*> nets;
+    vector<SteinerTree*> trees;
+    vector<size_t> hashes;
+    int estimate_count = 0;
+    auto estimate_batch = [&]() {
+      const int net_count = nets.size();
+      trees.assign(net_count, nullptr);
+      hashes.resize(net_count);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 64)
+      for (int i = 0; i < net_count; i++) {
+        hashes[i] = pinLocationHash(nets[i]);
+        if (incremental && !parasitics_invalid_.hasKey(nets[i])) {
+          auto itr = net_pin_loc_hash_.find(nets[i]);
+          if (itr != net_pin_loc_hash_.end() && itr->second == hashes[i]
+              && parasitics_->findPiElmore(
+                  drvr_pins[i], RiseFall::rise(), parasitic_ap)) {
+            continue;
+          }
+        }
+        trees[i] = makeSteinerTree(drvr_pins[i]);
+      }
+      for (int i = 0; i < net_count; i++) {
+        if (trees[i]) {
+          makeWireParasitic(nets[i], trees[i]);
+          net_pin_loc_hash_[nets[i]] = hashes[i];
+          delete trees[i];
+          estimate_count++;
+        }
+      }
+      drvr_pins.clear();
+      nets.clear();
+    };
+
     NetIterator* net_iter = network_->netIterator(network_->topInstance());
     while (net_iter->hasNext()) {
       Net* net = net_iter->next();
-      estimateWireParasitic(net);
+      PinSet* drivers = network_->drivers(net);
+      if (drivers && !drivers->empty()) {
+        PinSet::Iterator drvr_iter(drivers);
+        const Pin* drvr_pin = drvr_iter.next();
+        if (needsWireParasitic(drvr_pin, net)) {
+          if (isPadNet(net)) {
+            makePadParasitic(net);
+          } else {
+            drvr_pins.push_back(drvr_pin);
+            nets.push_back(net);
+            if (nets.size() == estimate_batch_size) {
+              estimate_batch();
+            }
+          }
+        }
+      }
     }
     delete net_iter;
+    estimate_batch();
 
+    debugPrint(logger_,
+               RSZ,
+               "resizer_parasitics",
+               1,
+               "estimated {} nets",
+               estimate_count);
     parasitics_src_ = ParasiticsSrc::placement;
     parasitics_invalid_.clear();
   }
 }
 
+// Order independent hash of the net pins and their locations.
+size_t Resizer::pinLocationHash(const Net* net) const
+{
+  size_t hash = 0;
+  NetConnectedPinIterator* pin_iter = network_->connectedPinIterator(net);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    const Point loc = db_network_->location(pin);
+    size_t pin_hash = std::hash<const Pin*>()(pin);
+    pin_hash = pin_hash * 31 + std::hash<int>()(loc.x());
+    pin_hash = pin_hash * 31 + std::hash<int>()(loc.y());
+    hash += pin_hash * 0x9e3779b97f4a7c15ULL;
+  }
+  delete pin_iter;
+  return hash;
+}
+
 void Resizer::estimateWireParasitic(const Net* net)
 {
   PinSet* drivers = network_->drivers(net);
@@ -418,9 +512,7 @@ void Resizer::estimateWireParasitic(const Net* net)
 
 void Resizer::estimateWireParasitic(const Pin* drvr_pin, const Net* net)
 {
-  if (!network_->isPower(net) && !network_->isGround(net)
-      && !sta_->isIdealClock(drvr_pin)
-      && !db_network_->staToDb(net)->isSpecial()) {
+  if (needsWireParasitic(drvr_pin, net)) {
     if (isPadNet(net)) {
       // When an input port drives a pad instance with huge input
       // cap the elmore delay is gigantic. Annotate with zero
@@ -432,6 +524,14 @@ void Resizer::estimateWireParasitic(const Pin* drvr_pin, const Net* net)
   }
 }
 
+// Power, ground, special and ideal clock nets get no wire parasitics.
+bool Resizer::needsWireParasitic(const Pin* drvr_pin, const Net* net) const
+{
+  return !network_->isPower(net) && !network_->isGround(net)
+         && !sta_->isIdealClock(drvr_pin)
+         && !db_network_->staToDb(net)->isSpecial();
+}
+
 bool Resizer::isPadNet(const Net* net) const
 {
   const Pin *pin1, *pin2;
@@ -467,86 +567,91 @@ void Resizer::estimateWireParasiticSteiner(const Pin* drvr_pin, const Net* net)
 {
   SteinerTree* tree = makeSteinerTree(drvr_pin);
   if (tree) {
-    debugPrint(logger_,
-               RSZ,
-               "resizer_parasitics",
-               1,
-               "estimate wire {}",
-               sdc_network_->pathName(net));
-    for (Corner* corner : *sta_->corners()) {
-      const ParasiticAnalysisPt* parasitics_ap
-          = corner->findParasiticAnalysisPt(max_);
-      Parasitic* parasitic
-          = sta_->makeParasiticNetwork(net, false, parasitics_ap);
-      bool is_clk = global_router_->isNonLeafClock(db_network_->staToDb(net));
-      double wire_cap = 0.0;
-      double wire_res = 0.0;
-      int branch_count = tree->branchCount();
-      size_t resistor_id = 1;
-      for (int i = 0; i < branch_count; i++) {
-        Point pt1, pt2;
-        SteinerPt steiner_pt1, steiner_pt2;
-        int wire_length_dbu;
-        tree->branch(i, pt1, steiner_pt1, pt2, steiner_pt2, wire_length_dbu);
-        if (wire_length_dbu) {
-          double dx = dbuToMeters(abs(pt1.x() - pt2.x()))
-                      / dbuToMeters(wire_length_dbu);
-          double dy = dbuToMeters(abs(pt1.y() - pt2.y()))
-                      / dbuToMeters(wire_length_dbu);
-
-          if (is_clk) {
-            wire_cap = dx * wireClkHCapacitance(corner)
-                       + dy * wireClkVCapacitance(corner);
-            wire_res = dx * wireClkHResistance(corner)
-                       + dy * wireClkVResistance(corner);
-          } else {
-            wire_cap = dx * wireSignalHCapacitance(corner)
-                       + dy * wireSignalVCapacitance(corner);
-            wire_res = dx * wireSignalHResistance(corner)
-                       + dy * wireSignalVResistance(corner);
-          }
-        } else {
-          wire_cap = is_clk ? wireClkCapacitance(corner)
-                            : wireSignalCapacitance(corner);
-          wire_res = is_clk ? wireClkResistance(corner)
-                            : wireSignalResistance(corner);
-        }
-        ParasiticNode* n1 = parasitics_->ensureParasiticNode(
-            parasitic, net, steiner_pt1, network_);
-        ParasiticNode* n2 = parasitics_->ensureParasiticNode(
-            parasitic, net, steiner_pt2, network_);
-        if (wire_length_dbu == 0) {
-          // Use a small resistor to keep the connectivity intact.
-          parasitics_->makeResistor(parasitic, resistor_id++, 1.0e-3, n1, n2);
+    makeWireParasitic(net, tree);
+    delete tree;
+  }
+}
+
+void Resizer::makeWireParasitic(const Net* net, SteinerTree* tree)
+{
+  debugPrint(logger_,
+             RSZ,
+             "resizer_parasitics",
+             1,
+             "estimate wire {}",
+             sdc_network_->pathName(net));
+  for (Corner* corner : *sta_->corners()) {
+    const ParasiticAnalysisPt* parasitics_ap
+        = corner->findParasiticAnalysisPt(max_);
+    Parasitic* parasitic
+        = sta_->makeParasiticNetwork(net, false, parasitics_ap);
+    bool is_clk = global_router_->isNonLeafClock(db_network_->staToDb(net));
+    double wire_cap = 0.0;
+    double wire_res = 0.0;
+    int branch_count = tree->branchCount();
+    size_t resistor_id = 1;
+    for (int i = 0; i < branch_count; i++) {
+      Point pt1, pt2;
+      SteinerPt steiner_pt1, steiner_pt2;
+      int wire_length_dbu;
+      tree->branch(i, pt1, steiner_pt1, pt2, steiner_pt2, wire_length_dbu);
+      if (wire_length_dbu) {
+        double dx = dbuToMeters(abs(pt1.x() - pt2.x()))
+                    / dbuToMeters(wire_length_dbu);
+        double dy = dbuToMeters(abs(pt1.y() - pt2.y()))
+                    / dbuToMeters(wire_length_dbu);
+
+        if (is_clk) {
+          wire_cap = dx * wireClkHCapacitance(corner)
+                     + dy * wireClkVCapacitance(corner);
+          wire_res = dx * wireClkHResistance(corner)
+                     + dy * wireClkVResistance(corner);
         } else {
-          double length = dbuToMeters(wire_length_dbu);
-          double cap = length * wire_cap;
-          double res = length * wire_res;
-          // Make pi model for the wire.
-          debugPrint(logger_,
-                     RSZ,
-                     "resizer_parasitics",
-                     2,
-                     " pi {} l={} c2={} rpi={} c1={} {}",
-                     parasitics_->name(n1),
-                     units_->distanceUnit()->asString(length),
-                     units_->capacitanceUnit()->asString(cap / 2.0),
-                     units_->resistanceUnit()->asString(res),
-                     units_->capacitanceUnit()->asString(cap / 2.0),
-                     parasitics_->name(n2));
-          parasitics_->incrCap(n1, cap / 2.0);
-          parasitics_->makeResistor(parasitic, resistor_id++, res, n1, n2);
-          parasitics_->incrCap(n2, cap / 2.0);
+          wire_cap = dx * wireSignalHCapacitance(corner)
+                     + dy * wireSignalVCapacitance(corner);
+          wire_res = dx * wireSignalHResistance(corner)
+                     + dy * wireSignalVResistance(corner);
         }
-        parasiticNodeConnectPins(parasitic, n1, tree, steiner_pt1, resistor_id);
-        parasiticNodeConnectPins(parasitic, n2, tree, steiner_pt2, resistor_id);
+      } else {
+        wire_cap = is_clk ? wireClkCapacitance(corner)
+                          : wireSignalCapacitance(corner);
+        wire_res = is_clk ? wireClkResistance(corner)
+                          : wireSignalResistance(corner);
+      }
+      ParasiticNode* n1 = parasitics_->ensureParasiticNode(
+          parasitic, net, steiner_pt1, network_);
+      ParasiticNode* n2 = parasitics_->ensureParasiticNode(
+          parasitic, net, steiner_pt2, network_);
+      if (wire_length_dbu == 0) {
+        // Use a small resistor to keep the connectivity intact.
+        parasitics_->makeResistor(parasitic, resistor_id++, 1.0e-3, n1, n2);
+      } else {
+        double length = dbuToMeters(wire_length_dbu);
+        double cap = length * wire_cap;
+        double res = length * wire_res;
+        // Make pi model for the wire.
+        debugPrint(logger_,
+                   RSZ,
+                   "resizer_parasitics",
+                   2,
+                   " pi {} l={} c2={} rpi={} c1={} {}",
+                   parasitics_->name(n1),
+                   units_->distanceUnit()->asString(length),
+                   units_->capacitanceUnit()->asString(cap / 2.0),
+                   units_->resistanceUnit()->asString(res),
+                   units_->capacitanceUnit()->asString(cap / 2.0),
+                   parasitics_->name(n2));
+        parasitics_->incrCap(n1, cap / 2.0);
+        parasitics_->makeResistor(parasitic, resistor_id++, res, n1, n2);
+        parasitics_->incrCap(n2, cap / 2.0);
       }
-      arc_delay_calc_->reduceParasitic(
-          parasitic, net, corner, sta::MinMaxAll::all());
+      parasiticNodeConnectPins(parasitic, n1, tree, steiner_pt1, resistor_id);
+      parasiticNodeConnectPins(parasitic, n2, tree, steiner_pt2, resistor_id);
     }
-    parasitics_->deleteParasiticNetworks(net);
-    delete tree;
+    arc_delay_calc_->reduceParasitic(
+        parasitic, net, corner, sta::MinMaxAll::all());
   }
+  parasitics_->deleteParasiticNetworks(net);
 }
 
 float Resizer::pinCapacitance(const Pin* pin,
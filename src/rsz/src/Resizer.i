@@ -43,6 +43,7 @@
 #include "sta/Delay.hh"
 #include "sta/Liberty.hh"
 #include "db_sta/dbNetwork.hh"
+#include "ord/OpenRoad.hh"
 
 namespace ord {
 // Defined in OpenRoad.i
@@ -331,11 +332,17 @@ wire_clk_capacitance(const Corner *corner)
 }
 
 void
-estimate_parasitics_cmd(ParasiticsSrc src)
+estimate_parasitics_cmd(ParasiticsSrc src,
+                        bool incremental)
 {
   ensureLinked();
   Resizer *resizer = getResizer();
-  resizer->estimateParasitics(src);
+  resizer->setNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
+  if (src == ParasiticsSrc::placement && incremental) {
+    resizer->estimateWireParasitics(true);
+  } else {
+    resizer->estimateParasitics(src);
+  }
 }
 
 // For debugging. Does not protect against annotating power/gnd.
@@ -313,21 +313,26 @@ proc set_wire_rc { args } {
   }
 }
 
-sta::define_cmd_args "estimate_parasitics" { -placement|-global_routing }
+sta::define_cmd_args "estimate_parasitics" { -placement|-global_routing \
+                                                [-incremental] }
 
 proc estimate_parasitics { args } {
   sta::parse_key_args "estimate_parasitics" args \
-    keys {} flags {-placement -global_routing}
+    keys {} flags {-placement -global_routing -incremental}
 
   sta::check_argc_eq0 "estimate_parasitics" $args
+  set incremental [info exists flags(-incremental)]
   if { [info exists flags(-placement)] } {
     if { [rsz::check_corner_wire_cap] } {
-      rsz::estimate_parasitics_cmd "placement"
+      rsz::estimate_parasitics_cmd "placement" $incremental
     }
   } elseif { [info exists flags(-global_routing)] } {
+    if { $incremental } {
+      utl::error RSZ 97 "-incremental is only supported with -placement."
+    }
     if { [grt::have_routes] } {
       # should check for layer rc
-      rsz::estimate_parasitics_cmd "global_routing"
+      rsz::estimate_parasitics_cmd "global_routing" $incremental
     } else {
       utl::error RSZ 5 "Run global_route before estimating parasitics for global routing."
     }
@@ -0,0 +1,37 @@
+# estimate_parasitics -placement -incremental after moving an instance
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def gcd_nangate45_placed.def
+read_sdc gcd_nangate45.sdc
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+
+proc pin_timing {} {
+  set timing {}
+  foreach pin [get_pins */*] {
+    lappend timing [get_full_name $pin] \
+      [get_property $pin slew_max] [get_property $pin slack_max]
+  }
+  return $timing
+}
+
+estimate_parasitics -placement
+set placed [pin_timing]
+
+# Move _441_ across the die so the nets on its pins get longer.
+set inst [[ord::get_db_block] findInst _441_]
+$inst setLocation 10000 180000
+
+estimate_parasitics -placement -incremental
+set incremental [pin_timing]
+
+estimate_parasitics -placement
+set full [pin_timing]
+
+puts "moved nets re-estimated: [expr { $placed != $incremental }]"
+puts "incremental matches full: [expr { $incremental == $full }]"
+
+catch { estimate_parasitics -global_routing -incremental } error
+puts $error
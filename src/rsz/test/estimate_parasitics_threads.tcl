@@ -0,0 +1,32 @@
+# estimate_parasitics -placement with threads matches the serial estimate
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def gcd_nangate45_placed.def
+read_sdc gcd_nangate45.sdc
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+
+proc pin_timing {} {
+  set timing {}
+  foreach pin [get_pins */*] {
+    lappend timing [get_full_name $pin] \
+      [get_property $pin slew_max] [get_property $pin slack_max]
+  }
+  return $timing
+}
+
+set_thread_count 1
+estimate_parasitics -placement
+set serial [pin_timing]
+
+set_thread_count 4
+estimate_parasitics -placement
+set threads [pin_timing]
+
+if { $serial == $threads } {
+  puts "pass"
+} else {
+  puts "fail"
+}
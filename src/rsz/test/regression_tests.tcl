@@ -9,6 +9,8 @@ record_tests {
   buffer_varying_lengths
   eqy_repair_setup2
   eqy_repair_setup5
+  estimate_parasitics_incremental
+  estimate_parasitics_threads
   fanin_fanout1
   make_parasitics1
   make_parasitics2
@@ -35,8 +35,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -75,11 +79,13 @@ struct Tree
   int branchCount() const { return branch.size(); }
 };
 
+class TreeCacheCallBack;
+
 class SteinerTreeBuilder
 {
  public:
   SteinerTreeBuilder();
-  ~SteinerTreeBuilder() = default;
+  ~SteinerTreeBuilder();
 
   void init(odb::dbDatabase* db, Logger* logger);
 
@@ -90,6 +96,8 @@ class SteinerTreeBuilder
   Tree makeSteinerTree(const std::vector<int>& x,
                        const std::vector<int>& y,
                        int drvr_index);
+  // Trees of nets are cached and reused while the pin locations and alpha
+  // of the net stay the same.  Safe to call from multiple threads.
   Tree makeSteinerTree(odb::dbNet* net,
                        const std::vector<int>& x,
                        const std::vector<int>& y,
@@ -107,11 +115,26 @@ class SteinerTreeBuilder
   void setNetAlpha(const odb::dbNet* net, float alpha);
   void setMinFanoutAlpha(int min_fanout, float alpha);
   void setMinHPWLAlpha(int min_hpwl, float alpha);
+  void clearTreeCache();
+  void invalidateTree(const odb::dbNet* net);
+  void reportTreeCache() const;
 
  private:
+  // The tree of a net with the inputs it was built from.
+  struct CachedTree
+  {
+    std::vector<int> x;
+    std::vector<int> y;
+    int drvr_index;
+    float alpha;
+    Tree tree;
+  };
+
   int computeHPWL(odb::dbNet* net);
 
   const int flute_accuracy = 3;
+  // The tree cache is cleared when it reaches this many nets.
+  const size_t max_cached_trees = 200000;
   float alpha_;
   std::map<const odb::dbNet*, float> net_alpha_map_;
   std::pair<int, float> min_fanout_alpha_;
@@ -119,6 +142,12 @@ class SteinerTreeBuilder
 
   Logger* logger_;
   odb::dbDatabase* db_;
+
+  std::unordered_map<const odb::dbNet*, CachedTree> tree_cache_;
+  mutable std::mutex tree_cache_mutex_;
+  std::unique_ptr<TreeCacheCallBack> tree_cache_cbk_;
+  int64_t tree_cache_hits_;
+  int64_t tree_cache_misses_;
 };
 
 // Used by regressions.
@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 #include "stt/flute.h"
 #include "stt/pd.h"
 
@@ -46,15 +47,63 @@ namespace stt {
 
 static void reportSteinerBranches(const stt::Tree& tree, Logger* logger);
 
+// Drops the cached trees of nets whose pins move or change.
+class TreeCacheCallBack : public odb::dbBlockCallBackObj
+{
+ public:
+  TreeCacheCallBack(SteinerTreeBuilder* builder) : builder_(builder) {}
+
+  void inDbPostMoveInst(odb::dbInst* inst) override { invalidateInst(inst); }
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override
+  {
+    invalidateInst(inst);
+  }
+  void inDbNetDestroy(odb::dbNet* net) override
+  {
+    builder_->invalidateTree(net);
+  }
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override
+  {
+    builder_->invalidateTree(iterm->getNet());
+  }
+  void inDbITermPostConnect(odb::dbITerm* iterm) override
+  {
+    builder_->invalidateTree(iterm->getNet());
+  }
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override
+  {
+    builder_->invalidateTree(bterm->getNet());
+  }
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override
+  {
+    builder_->invalidateTree(bterm->getNet());
+  }
+
+ private:
+  void invalidateInst(odb::dbInst* inst)
+  {
+    for (odb::dbITerm* iterm : inst->getITerms()) {
+      builder_->invalidateTree(iterm->getNet());
+    }
+  }
+
+  SteinerTreeBuilder* builder_;
+};
+
 SteinerTreeBuilder::SteinerTreeBuilder()
     : alpha_(0.3),
       min_fanout_alpha_({0, -1}),
       min_hpwl_alpha_({0, -1}),
       logger_(nullptr),
-      db_(nullptr)
+      db_(nullptr),
+      tree_cache_cbk_(std::make_unique<TreeCacheCallBack>(this)),
+      tree_cache_hits_(0),
+      tree_cache_misses_(0)
 {
 }
 
+SteinerTreeBuilder::~SteinerTreeBuilder() = default;
+
 void SteinerTreeBuilder::init(odb::dbDatabase* db, Logger* logger)
 {
   db_ = db;
@@ -91,7 +140,62 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
     }
   }
 
-  return makeSteinerTree(x, y, drvr_index, net_alpha);
+  {
+    std::lock_guard<std::mutex> lock(tree_cache_mutex_);
+    if (tree_cache_cbk_->hasOwner()) {
+      auto itr = tree_cache_.find(net);
+      if (itr != tree_cache_.end()) {
+        const CachedTree& cached = itr->second;
+        if (cached.drvr_index == drvr_index && cached.alpha == net_alpha
+            && cached.x == x && cached.y == y) {
+          tree_cache_hits_++;
+          return cached.tree;
+        }
+      }
+    } else {
+      // Start monitoring the block before its trees are cached.
+      tree_cache_.clear();
+      tree_cache_cbk_->addOwner(net->getBlock());
+    }
+    tree_cache_misses_++;
+  }
+
+  Tree tree = makeSteinerTree(x, y, drvr_index, net_alpha);
+
+  std::lock_guard<std::mutex> lock(tree_cache_mutex_);
+  if (tree_cache_.size() >= max_cached_trees
+      && tree_cache_.find(net) == tree_cache_.end()) {
+    tree_cache_.clear();
+  }
+  tree_cache_[net] = {x, y, drvr_index, net_alpha, tree};
+  return tree;
+}
+
+void SteinerTreeBuilder::clearTreeCache()
+{
+  std::lock_guard<std::mutex> lock(tree_cache_mutex_);
+  tree_cache_.clear();
+  tree_cache_hits_ = 0;
+  tree_cache_misses_ = 0;
+}
+
+void SteinerTreeBuilder::invalidateTree(const odb::dbNet* net)
+{
+  if (net) {
+    std::lock_guard<std::mutex> lock(tree_cache_mutex_);
+    tree_cache_.erase(net);
+  }
+}
+
+void SteinerTreeBuilder::reportTreeCache() const
+{
+  std::lock_guard<std::mutex> lock(tree_cache_mutex_);
+  const int64_t lookups = tree_cache_hits_ + tree_cache_misses_;
+  logger_->report("Steiner tree cache: {} trees, {} hits, {} misses ({:.1f}%)",
+                  tree_cache_.size(),
+                  tree_cache_hits_,
+                  tree_cache_misses_,
+                  lookups > 0 ? 100.0 * tree_cache_hits_ / lookups : 0.0);
 }
 
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
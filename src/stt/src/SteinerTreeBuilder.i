@@ -89,6 +89,28 @@ set_min_hpwl_alpha(int hpwl, float alpha)
   getSteinerTreeBuilder()->setMinHPWLAlpha(hpwl, alpha);
 }
 
+void
+report_tree_cache()
+{
+  getSteinerTreeBuilder()->reportTreeCache();
+}
+
+void
+clear_tree_cache()
+{
+  getSteinerTreeBuilder()->clearTreeCache();
+}
+
+// Wire length of the (cached) tree of net.  Used by regressions.
+int
+net_tree_length(odb::dbNet* net,
+                std::vector<int> x,
+                std::vector<int> y,
+                int drvr_index)
+{
+  return getSteinerTreeBuilder()->makeSteinerTree(net, x, y, drvr_index).length;
+}
+
 void report_flute_tree(std::vector<int> x,
                        std::vector<int> y,
                        int drvr_index)
@@ -33,12 +33,14 @@
 #include "stt/flute.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
 
 // Use flute LUT file reader.
@@ -203,7 +205,10 @@ static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 static void readLUT();
 static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
 static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln);
+static void initLUT(int from_d,
+                    int to_d,
+                    LUT_TYPE LUT,
+                    NUMSOLN_TYPE numsoln);
 static void ensureLUT(int d);
 static std::string base64_decode(std::string const& encoded_string);
 #if LUT_SOURCE == LUT_VAR_CHECK
@@ -215,7 +220,9 @@ static void checkLUT(LUT_TYPE LUT1,
 
 // LUTs are initialized to this order at startup.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+static std::atomic<int> lut_valid_d = 0;
+// Serializes LUT initialization when flute is called from several threads.
+static std::mutex lut_mutex;
 
 extern std::string post9;
 extern std::string powv9;
@@ -230,7 +237,7 @@ static void readLUT()
 
 #elif LUT_SOURCE == LUT_VAR
   // Only init to d=8 on startup because d=9 is big and slow.
-  initLUT(lut_initial_d, LUT, numsoln);
+  initLUT(4, lut_initial_d, LUT, numsoln);
 
 #elif LUT_SOURCE == LUT_VAR_CHECK
   readLUTfiles(LUT, numsoln);
@@ -238,7 +245,7 @@ static void readLUT()
   LUT_TYPE LUT_;
   NUMSOLN_TYPE numsoln_;
   makeLUT(LUT_, numsoln_);
-  initLUT(FLUTE_D, LUT_, numsoln_);
+  initLUT(4, FLUTE_D, LUT_, numsoln_);
   checkLUT(LUT, numsoln, LUT_, numsoln_);
 #endif
 }
@@ -299,8 +306,13 @@ inline const char* readDecimalInt(const char* s, int& value)
   return s;
 }
 
-// Init LUTs from base64 encoded string variables.
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
+// Init LUTs from base64 encoded string variables.  The degrees below from_d
+// are decoded to reach the later ones but their entries are left untouched
+// so other threads can keep reading them while the table is extended.
+static void initLUT(int from_d,
+                    int to_d,
+                    LUT_TYPE LUT,
+                    NUMSOLN_TYPE numsoln)
 {
   std::string pwv_string = base64_decode(powv9);
   const char* pwv = pwv_string.c_str();
@@ -321,18 +333,20 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
     }
     ++prt;
 #endif
+    const bool init = d >= from_d;
     for (int k = 0; k < numgrp[d]; k++) {
       int ns = charNum(*pwv++);
       if (ns == 0) {  // same as some previous group
         int kk;
         pwv = readDecimalInt(pwv, kk) + 1;
-        numsoln[d][k] = numsoln[d][kk];
-        LUT[d][k] = LUT[d][kk];
+        if (init) {
+          numsoln[d][k] = numsoln[d][kk];
+          LUT[d][k] = LUT[d][kk];
+        }
       } else {
         pwv++;  // '\n'
-        numsoln[d][k] = ns;
-        struct csoln* p = new struct csoln[ns];
-        LUT[d][k] = p;
+        struct csoln* soln = new struct csoln[ns];
+        struct csoln* p = soln;
         for (int i = 1; i <= ns; i++) {
           p->parent = charNum(*pwv++);
 
@@ -370,6 +384,12 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 #endif
           p++;
         }
+        if (init) {
+          numsoln[d][k] = ns;
+          LUT[d][k] = soln;
+        } else {
+          delete[] soln;
+        }
       }
     }
   }
@@ -378,11 +398,18 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 
 static void ensureLUT(int d)
 {
+  const int valid_d = lut_valid_d;
+  if (valid_d > 0 && (d <= valid_d || d > FLUTE_D)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(lut_mutex);
   if (LUT == nullptr) {
     readLUT();
   }
   if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
+    // Threads on the lock free path above may be reading the degrees up to
+    // lut_valid_d so only the degrees above it are initialized.
+    initLUT(lut_valid_d + 1, FLUTE_D, LUT, numsoln);
   }
 }
 
@@ -3,6 +3,7 @@ record_tests {
   flute_gcd
   check
   parse_clocks
+  tree_cache
   pd1
   pd2
   pd_gcd
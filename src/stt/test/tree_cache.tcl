@@ -0,0 +1,29 @@
+# cached Steiner trees of nets
+source "helpers.tcl"
+read_lef "sky130hs/sky130hs.tlef"
+read_lef "sky130hs/sky130hs_std_cell.lef"
+read_def "parse_clocks.def"
+
+set block [ord::get_db_block]
+set net60 [$block findNet net60]
+set net61 [$block findNet net61]
+
+# miss, hit, miss on a different driver, miss on another net
+puts [stt::net_tree_length $net60 {0 1000} {0 2000} 0]
+puts [stt::net_tree_length $net60 {0 1000} {0 2000} 0]
+puts [stt::net_tree_length $net60 {0 1000} {0 2000} 1]
+puts [stt::net_tree_length $net61 {0 500} {0 500} 0]
+stt::report_tree_cache
+
+# the same net with other pin locations is a miss
+puts [stt::net_tree_length $net61 {0 500} {0 700} 0]
+stt::report_tree_cache
+
+# moving an instance of net60 drops its tree
+[$block findInst _472_] setOrigin 0 0
+stt::report_tree_cache
+puts [stt::net_tree_length $net60 {0 1000} {0 2000} 1]
+stt::report_tree_cache
+
+stt::clear_tree_cache
+stt::report_tree_cache
@@ -0,0 +1,95 @@
+#include "utl/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace utl {
+
+MappedFile::MappedFile(const char* filename, Logger* logger)
+{
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    std::string error = strerror(errno);
+    logger->error(UTL, 10, "could not open {}: {}", filename, error);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    std::string error = strerror(errno);
+    close(fd);
+    logger->error(UTL, 11, "could not stat {}: {}", filename, error);
+  }
+
+  size_ = st.st_size;
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      std::string error = strerror(errno);
+      close(fd);
+      logger->error(UTL, 12, "could not map {}: {}", filename, error);
+    }
+    data_ = static_cast<char*>(data);
+    madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+MappedFileStream::MappedFileStream(const MappedFile& file)
+    : std::istream(nullptr), buffer_(file.data(), file.size())
+{
+  rdbuf(&buffer_);
+}
+
+MappedFileStream::Buffer::Buffer(const char* data, size_t size)
+{
+  // The get area is never written through.
+  char* begin = const_cast<char*>(data);
+  setg(begin, begin, begin + size);
+}
+
+MappedFileStream::Buffer::pos_type MappedFileStream::Buffer::seekoff(
+    off_type off,
+    std::ios_base::seekdir dir,
+    std::ios_base::openmode which)
+{
+  if ((which & std::ios_base::in) == 0) {
+    return pos_type(off_type(-1));
+  }
+
+  off_type base = 0;
+  if (dir == std::ios_base::cur) {
+    base = gptr() - eback();
+  } else if (dir == std::ios_base::end) {
+    base = egptr() - eback();
+  }
+
+  const off_type pos = base + off;
+  if (pos < 0 || pos > egptr() - eback()) {
+    return pos_type(off_type(-1));
+  }
+  setg(eback(), eback() + pos, egptr());
+  return pos_type(pos);
+}
+
+MappedFileStream::Buffer::pos_type MappedFileStream::Buffer::seekpos(
+    pos_type pos,
+    std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+}  // namespace utl
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_MODULE MappedFileTest
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+// Shared library version
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#else
+// Header only version
+#include <boost/test/included/unit_test.hpp>
+#endif
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utl/CFileUtils.h"
+#include "utl/MappedFile.h"
+#include "utl/ScopedTemporaryFile.h"
+
+namespace utl {
+
+// Finds the path of the temporary file through its descriptor.
+static std::string pathOf(FILE* file)
+{
+  return "/proc/self/fd/" + std::to_string(fileno(file));
+}
+
+BOOST_AUTO_TEST_CASE(map_missing_file)
+{
+  Logger logger;
+  BOOST_CHECK_THROW(MappedFile("/nonexistent/file.odb", &logger),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(map_empty_file)
+{
+  Logger logger;
+  ScopedTemporaryFile stf(&logger);
+
+  MappedFile file(pathOf(stf.file()).c_str(), &logger);
+  BOOST_TEST(file.size() == 0);
+
+  MappedFileStream stream(file);
+  char c;
+  stream.read(&c, 1);
+  BOOST_TEST(stream.eof());
+}
+
+// Writes 4KB of data then reads it back through the mapping in uneven pieces.
+BOOST_AUTO_TEST_CASE(read_written_file)
+{
+  Logger logger;
+  ScopedTemporaryFile stf(&logger);
+
+  std::vector<uint8_t> test_data(4096);
+  std::iota(test_data.begin(), test_data.end(), 0);
+  WriteAll(stf.file(), test_data, &logger);
+  fflush(stf.file());
+
+  MappedFile file(pathOf(stf.file()).c_str(), &logger);
+  BOOST_TEST(file.size() == test_data.size());
+
+  MappedFileStream stream(file);
+  std::vector<char> contents(test_data.size());
+  size_t offset = 0;
+  for (size_t chunk = 1; offset < contents.size(); chunk += 7) {
+    chunk = std::min(chunk, contents.size() - offset);
+    stream.read(contents.data() + offset, chunk);
+    BOOST_TEST(stream.good());
+    offset += chunk;
+  }
+  for (size_t i = 0; i < contents.size(); ++i) {
+    BOOST_TEST(static_cast<uint8_t>(contents.at(i)) == test_data.at(i));
+  }
+
+  char c;
+  stream.read(&c, 1);
+  BOOST_TEST(stream.eof());
+}
+
+BOOST_AUTO_TEST_CASE(seek_within_file)
+{
+  Logger logger;
+  ScopedTemporaryFile stf(&logger);
+
+  const std::vector<uint8_t> kTestData = {0x01, 0x02, 0x03, 0x04};
+  WriteAll(stf.file(), kTestData, &logger);
+  fflush(stf.file());
+
+  MappedFile file(pathOf(stf.file()).c_str(), &logger);
+  MappedFileStream stream(file);
+
+  stream.seekg(2);
+  BOOST_TEST(stream.tellg() == 2);
+  BOOST_TEST(stream.get() == 0x03);
+
+  stream.seekg(-4, std::ios_base::end);
+  BOOST_TEST(stream.get() == 0x01);
+
+  stream.seekg(1, std::ios_base::cur);
+  BOOST_TEST(stream.get() == 0x03);
+}
+
+}  // namespace utl